@@ -0,0 +1,39 @@
+#version 330
+
+// Input
+layout(location = 0) in vec3 v_position;
+layout(location = 1) in vec3 v_normal;
+layout(location = 2) in vec2 v_texture_coord;
+layout(location = 3) in vec3 v_color;
+
+// Per-instance input, the 2D model matrix (columns) and a color multiplier
+layout(location = 4) in vec3 i_model_0;
+layout(location = 5) in vec3 i_model_1;
+layout(location = 6) in vec3 i_model_2;
+layout(location = 7) in vec3 i_tint;
+
+// Uniform properties
+// Camera of the frame, shared by the programs (CameraBuffer)
+layout(std140) uniform Camera
+{
+    mat4 View;
+    mat4 Projection;
+};
+
+// Output
+out vec3 frag_normal;
+out vec3 frag_color;
+out vec2 tex_coord;
+
+
+void main()
+{
+    // Same expansion of the 2D model matrix as SimpleScene::RenderMesh2D
+    mat3 model = mat3(i_model_0, i_model_1, i_model_2);
+    vec3 world = model * vec3(v_position.xy, 1.0);
+
+    frag_normal = v_normal;
+    frag_color = v_color * i_tint;
+    tex_coord = v_texture_coord;
+    gl_Position = Projection * View * vec4(world.xy, v_position.z * model[2][2], 1.0);
+}
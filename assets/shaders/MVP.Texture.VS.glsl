@@ -8,8 +8,13 @@ layout(location = 3) in vec3 v_color;
 
 // Uniform properties
 uniform mat4 Model;
-uniform mat4 View;
-uniform mat4 Projection;
+
+// Camera of the frame, shared by the programs (CameraBuffer)
+layout(std140) uniform Camera
+{
+    mat4 View;
+    mat4 Projection;
+};
 
 // Output
 out vec3 frag_normal;
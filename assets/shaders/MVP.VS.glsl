@@ -5,8 +5,13 @@ layout(location = 0) in vec3 v_position;
 
 // Uniform properties
 uniform mat4 Model;
-uniform mat4 View;
-uniform mat4 Projection;
+
+// Camera of the frame, shared by the programs (CameraBuffer)
+layout(std140) uniform Camera
+{
+    mat4 View;
+    mat4 Projection;
+};
 
 
 void main()
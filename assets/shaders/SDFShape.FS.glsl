@@ -0,0 +1,162 @@
+#version 330
+
+// Input
+in vec2 shape_coord;
+flat in vec3 shape_params;
+flat in vec3 frag_color;
+
+// Output
+layout(location = 0) out vec4 out_color;
+
+// Same values as ObjectsGame::Shape
+#define SHAPE_CIRCLE    0
+#define SHAPE_STAR      1
+#define SHAPE_SUN       2
+#define SHAPE_HEXAGON   3
+#define SHAPE_HEART     4
+#define SHAPE_RHOMBUS   5
+
+const float PI = 3.14159265;
+
+
+float Cross(vec2 a, vec2 b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+
+// Distance from p to the segment ab
+float Segment(vec2 p, vec2 a, vec2 b)
+{
+    vec2 pa = p - a;
+    vec2 ba = b - a;
+    float h = clamp(dot(pa, ba) / dot(ba, ba), 0.0, 1.0);
+    return length(pa - ba * h);
+}
+
+
+// Kites from the center to n tips at radius 1, the first one on the +x axis. Their side
+// vertices are at radius inner, at the given fraction of the half angle between two tips.
+// With fraction 1 the kites touch each other and make a star
+float SdKites(vec2 p, float n, float inner, float fraction)
+{
+    // Fold p into the upper half of the sector of the first tip
+    float sector = PI / n;
+    float angle = mod(atan(p.y, p.x) + sector, 2.0 * sector) - sector;
+    vec2 q = length(p) * vec2(cos(angle), abs(sin(angle)));
+
+    vec2 tip = vec2(1.0, 0.0);
+    vec2 side = inner * vec2(cos(fraction * sector), sin(fraction * sector));
+
+    float d = Segment(q, tip, side);
+    bool inside = Cross(side - tip, q - tip) > 0.0;
+    // Between two kites apart, the edge back to the center is part of the outline
+    if (fraction < 1.0)
+    {
+        d = min(d, Segment(q, side, vec2(0.0)));
+        inside = inside && Cross(-side, q - side) > 0.0;
+    }
+    return inside ? -d : d;
+}
+
+
+// Regular polygon of n sides, its vertices at radius 1 and the first one on the +x axis
+float SdPolygon(vec2 p, float n)
+{
+    // Fold p around the normal of the closest side
+    float sector = PI / n;
+    float angle = mod(atan(p.y, p.x), 2.0 * sector) - sector;
+    vec2 q = length(p) * vec2(cos(angle), abs(sin(angle)));
+
+    vec2 corner = vec2(cos(sector), sin(sector));
+    q -= vec2(corner.x, clamp(q.y, 0.0, corner.y));
+    return length(q) * sign(q.x);
+}
+
+
+// Heart with its tip at (0, -1), the proportions of the parametric curve of CreateHearth
+float SdHeart(vec2 p)
+{
+    // The curve is 32 wide and 29 tall for 17 below its center, the unit heart is 1.1 tall
+    const float scale = 1.53;
+    p = (p + vec2(0.0, 1.0)) / scale;
+    p.x = abs(p.x);
+
+    if (p.x + p.y > 1.0)
+        return (length(p - vec2(0.25, 0.75)) - sqrt(2.0) / 4.0) * scale;
+
+    vec2 top = p - vec2(0.0, 1.0);
+    vec2 diagonal = p - 0.5 * max(p.x + p.y, 0.0);
+    return sqrt(min(dot(top, top), dot(diagonal, diagonal))) * sign(p.x - p.y) * scale;
+}
+
+
+// Color at the tips of the plants and projectiles, white and black plants keep theirs
+vec3 TipColor(vec3 color)
+{
+    if (color == vec3(1.0) || color == vec3(0.0))
+        return color;
+    return vec3(1.0, 0.8, 0.8);
+}
+
+
+void main()
+{
+    vec2 p = shape_coord;
+    float radius = length(p);
+    int shape = int(shape_params.x + 0.5);
+
+    float d;
+    vec3 color = frag_color;
+    if (shape == SHAPE_STAR)
+    {
+        // Projectiles: tips and the radius of the vertices between them
+        d = SdKites(p, shape_params.y, shape_params.z, 1.0);
+        color = mix(frag_color, TipColor(frag_color), smoothstep(shape_params.z, 1.0, radius));
+    }
+    else if (shape == SHAPE_RHOMBUS)
+    {
+        // Plants: rhombuses around the center, their sides a third of the angle between two tips away
+        d = SdKites(p, shape_params.y, shape_params.z, 2.0 / 3.0);
+        color = mix(frag_color, TipColor(frag_color), smoothstep(shape_params.z, 1.0, radius));
+    }
+    else if (shape == SHAPE_SUN)
+    {
+        // Suns: the bigger rays, between them the tips of the smaller ones. The core is lighter
+        // at its edge, the smaller rays are half the length of the bigger ones
+        float inner = shape_params.z;
+        float core = 2.0 * inner - 1.0;
+        d = SdKites(p, shape_params.y, inner, 1.0);
+        vec3 light = mix(frag_color, vec3(1.0), 0.5);
+        color = (radius < core)
+            ? mix(frag_color, light, radius / core)
+            : mix(light, frag_color, (radius - core) / (1.0 - core));
+    }
+    else if (shape == SHAPE_HEXAGON)
+    {
+        // Zombies: a gray hexagon inside the outer one, at the radius of the first parameter
+        float inner = shape_params.y;
+        d = SdPolygon(p, 6.0);
+        float dInner = SdPolygon(p / inner, 6.0) * inner;
+        float w = fwidth(dInner);
+        color = mix(frag_color, vec3(0.5), 1.0 - smoothstep(-w, w, dInner));
+    }
+    else if (shape == SHAPE_HEART)
+    {
+        // Lives: darker at the center
+        d = SdHeart(p);
+        color = mix(frag_color - 0.5, frag_color, clamp(radius, 0.0, 1.0));
+    }
+    else
+    {
+        d = radius - 1.0;
+    }
+
+    // Anti-aliased edge over about one pixel, the quad outside of the shape leaves no depth
+    float w = fwidth(d);
+    float coverage = 1.0 - smoothstep(-w, w, d);
+    if (coverage <= 0.0)
+        discard;
+
+    out_color = vec4(color, coverage);
+}
@@ -0,0 +1,39 @@
+#version 330
+
+// Input, a quad of ObjectsGame::CreateShape
+layout(location = 0) in vec3 v_position;
+layout(location = 1) in vec3 v_normal;          // Shape and its two parameters
+layout(location = 2) in vec2 v_texture_coord;   // Coordinates in the shape, its radius is 1
+layout(location = 3) in vec3 v_color;
+
+// Per-instance input, the 2D model matrix (columns) and a color multiplier
+layout(location = 4) in vec3 i_model_0;
+layout(location = 5) in vec3 i_model_1;
+layout(location = 6) in vec3 i_model_2;
+layout(location = 7) in vec3 i_tint;
+
+// Uniform properties
+// Camera of the frame, shared by the programs (CameraBuffer)
+layout(std140) uniform Camera
+{
+    mat4 View;
+    mat4 Projection;
+};
+
+// Output
+out vec2 shape_coord;
+flat out vec3 shape_params;
+flat out vec3 frag_color;
+
+
+void main()
+{
+    // Same transform as Instanced2D, the quad is drawn like any other 2D mesh
+    mat3 model = mat3(i_model_0, i_model_1, i_model_2);
+    vec3 world = model * vec3(v_position.xy, 1.0);
+
+    shape_coord = v_texture_coord;
+    shape_params = v_normal;
+    frag_color = v_color * i_tint;
+    gl_Position = Projection * View * vec4(world.xy, v_position.z * model[2][2], 1.0);
+}
@@ -0,0 +1,209 @@
+// Cost of the batched entity kernels for each instruction set supported by the CPU,
+// reported per entity in the format of Google Benchmark. Before timing, the results
+// of every instruction set are compared with the scalar ones, bit for bit.
+
+#include "Plants_VS_Zombies/EntityKernels.h"
+#include "Plants_VS_Zombies/EntityStore.h"
+#include "Plants_VS_Zombies/GameConstants.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using EntityKernels::InstructionSet;
+
+
+namespace
+{
+    // Far from the edges, the moved entities stay active for all the iterations
+    const float kStartX = 1.0e7f;
+    const float kBoardEdge = 1.0e9f;
+    const float kDeltaTime = 1.0f / 60.0f;
+    const double kMinSeconds = 0.05;
+
+    // One entity out of sixteen is inactive, fading out
+    EntityStore Populate(int count, unsigned int seed)
+    {
+        std::mt19937 eng(seed);
+        std::uniform_real_distribution<float> randomOffset(-1000.0f, 1000.0f);
+        std::uniform_real_distribution<float> randomSpeed(GMINSPEED, GMAXSPEED);
+        std::uniform_real_distribution<float> randomAngle(0.0f, 360.0f);
+
+        EntityStore store(count);
+        for (int i = 0; i < count; ++i)
+        {
+            store.Create(kStartX + randomOffset(eng), randomOffset(eng), randomSpeed(eng), 0, 0, 1);
+            store.angle[i] = randomAngle(eng);
+            store.active[i] = (i % 16 != 15);
+        }
+        return store;
+    }
+
+    // Positions of the rectangle and of the pointer, chosen to hit some entities
+    const glm::vec2 kCorner(kStartX - 500.0f, -500.0f);
+    const glm::vec2 kPointer(kStartX, 0.0f);
+
+    // Run every kernel once, the outputs are compared between the instruction sets.
+    struct KernelOutputs
+    {
+        std::vector<float> x;
+        std::vector<float> angle;
+        std::vector<unsigned char> active;
+        std::vector<int> rectangleHits;
+        std::vector<int> mouseHits;
+        int overlap;
+    };
+
+    KernelOutputs RunOnce(int count)
+    {
+        EntityStore store = Populate(count, 42);
+        KernelOutputs outputs;
+        outputs.rectangleHits.resize(count);
+        outputs.mouseHits.resize(count);
+
+        EntityStore zombies = store;
+        EntityKernels::MoveLeft(zombies.x.data(), zombies.speed.data(), zombies.active.data(), count, kDeltaTime);
+        // Spin by more than a turn from time to time to exercise the wrap
+        EntityKernels::MoveRightAndSpin(store.x.data(), store.y.data(), store.speed.data(), store.angle.data(),
+            store.active.data(), count, kDeltaTime, 200.0f, kStartX, 0.0f);
+
+        outputs.x = zombies.x;
+        outputs.x.insert(outputs.x.end(), store.x.begin(), store.x.end());
+        outputs.angle = store.angle;
+        outputs.active = zombies.active;
+        outputs.active.insert(outputs.active.end(), store.active.begin(), store.active.end());
+
+        outputs.rectangleHits.resize(EntityKernels::IntersectRectangle(zombies.x.data(), zombies.y.data(),
+            zombies.active.data(), count, GoutterRadiusZ, kCorner, 100.0f, 100.0f, outputs.rectangleHits.data()));
+        outputs.mouseHits.resize(EntityKernels::MouseOver(zombies.x.data(), zombies.y.data(),
+            zombies.active.data(), count, 200.0f, kPointer.x, kPointer.y, outputs.mouseHits.data()));
+        outputs.overlap = EntityKernels::FindFirstOverlap(zombies.x.data(), zombies.y.data(),
+            zombies.active.data(), count, GoutterRadiusZ, kPointer, 5.0f);
+        return outputs;
+    }
+
+    template <typename T>
+    bool SameBits(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+    }
+
+    bool SameOutputs(const KernelOutputs& a, const KernelOutputs& b)
+    {
+        return SameBits(a.x, b.x) && SameBits(a.angle, b.angle) && SameBits(a.active, b.active) &&
+               SameBits(a.rectangleHits, b.rectangleHits) && SameBits(a.mouseHits, b.mouseHits) &&
+               a.overlap == b.overlap;
+    }
+
+    // Double the iterations until the run lasts kMinSeconds, as Google Benchmark does.
+    template <typename Function>
+    double MeasureNanoseconds(Function function, long long& iterations)
+    {
+        for (iterations = 1; ; iterations *= 2)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (long long i = 0; i < iterations; ++i)
+            {
+                function();
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            double seconds = std::chrono::duration<double>(end - start).count();
+            if (seconds >= kMinSeconds)
+            {
+                return seconds * 1.0e9 / iterations;
+            }
+        }
+    }
+
+    void Report(const std::string& name, int count, double nanoseconds, long long iterations)
+    {
+        std::printf("%-40s %12.0f ns %12lld %12.3f\n", name.c_str(), nanoseconds, iterations, nanoseconds / count);
+    }
+}
+
+
+int main()
+{
+    const int sizes[] = { 64, 1024, 16384, 262144 };
+    const InstructionSet instructionSets[] = { InstructionSet::SCALAR, InstructionSet::SSE2, InstructionSet::AVX2 };
+
+    InstructionSet supported = EntityKernels::GetSupportedInstructionSet();
+    std::printf("Supported instruction set: %s\n", EntityKernels::GetInstructionSetName(supported));
+
+    // Same results whatever the instruction set
+    for (int size : sizes)
+    {
+        EntityKernels::SetInstructionSet(InstructionSet::SCALAR);
+        KernelOutputs expected = RunOnce(size + 3);
+
+        for (InstructionSet instructionSet : instructionSets)
+        {
+            if (instructionSet > supported) continue;
+
+            EntityKernels::SetInstructionSet(instructionSet);
+            if (!SameOutputs(RunOnce(size + 3), expected))
+            {
+                std::fprintf(stderr, "%s results differ from scalar for %d entities\n",
+                    EntityKernels::GetInstructionSetName(instructionSet), size + 3);
+                return 1;
+            }
+        }
+    }
+
+    std::printf("%-40s %15s %12s %12s\n", "Benchmark", "Time", "Iterations", "ns/entity");
+    std::printf("%s\n", std::string(82, '-').c_str());
+
+    for (InstructionSet instructionSet : instructionSets)
+    {
+        if (instructionSet > supported) continue;
+
+        EntityKernels::SetInstructionSet(instructionSet);
+        std::string suffix = std::string("/") + EntityKernels::GetInstructionSetName(instructionSet) + "/";
+
+        for (int size : sizes)
+        {
+            EntityStore store = Populate(size, 42);
+            std::vector<int> hits(size);
+            long long iterations = 0;
+            double time = 0.0;
+            volatile int sink = 0;
+
+            time = MeasureNanoseconds([&]() {
+                EntityKernels::MoveLeft(store.x.data(), store.speed.data(), store.active.data(), size, kDeltaTime);
+            }, iterations);
+            Report("BM_MoveLeft" + suffix + std::to_string(size), size, time, iterations);
+
+            time = MeasureNanoseconds([&]() {
+                EntityKernels::MoveRightAndSpin(store.x.data(), store.y.data(), store.speed.data(), store.angle.data(),
+                    store.active.data(), size, kDeltaTime, 5 * kDeltaTime, kBoardEdge, kBoardEdge);
+            }, iterations);
+            Report("BM_MoveRightAndSpin" + suffix + std::to_string(size), size, time, iterations);
+
+            time = MeasureNanoseconds([&]() {
+                sink = EntityKernels::IntersectRectangle(store.x.data(), store.y.data(), store.active.data(), size,
+                    GoutterRadiusZ, kCorner, 100.0f, 100.0f, hits.data());
+            }, iterations);
+            Report("BM_IntersectRectangle" + suffix + std::to_string(size), size, time, iterations);
+
+            // No overlap, the whole batch is scanned
+            time = MeasureNanoseconds([&]() {
+                sink = EntityKernels::FindFirstOverlap(store.x.data(), store.y.data(), store.active.data(), size,
+                    GoutterRadiusZ, glm::vec2(0.0f), 5.0f);
+            }, iterations);
+            Report("BM_FindFirstOverlap" + suffix + std::to_string(size), size, time, iterations);
+
+            time = MeasureNanoseconds([&]() {
+                sink = EntityKernels::MouseOver(store.x.data(), store.y.data(), store.active.data(), size,
+                    GradiusPST, kPointer.x, kPointer.y, hits.data());
+            }, iterations);
+            Report("BM_MouseOver" + suffix + std::to_string(size), size, time, iterations);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+// Update cost of the zombies and projectiles stored as objects (AoS) against the
+// columns of an EntityStore (SoA): one movement pass over both kinds, and the
+// removal of one entity out of ten (erase/remove_if against swap and pop).
+
+#include "Plants_VS_Zombies/EntityStore.h"
+#include "Plants_VS_Zombies/GameConstants.h"
+#include "Plants_VS_Zombies/PrototypeMeshes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    // Wide enough for nothing to leave the board during the movement passes
+    const glm::ivec2 kBoard(1 << 20, 1 << 20);
+    const float kDeltaTime = 1.0f / 60.0f;
+    const int kIterations = 20;
+    const int kRemovedEvery = 10;
+
+    // The members of the Zombie and Projectile objects the game stored before its columns,
+    // in the same order: the movement pass loads each whole object
+    struct ZombieObject
+    {
+        std::string name;
+        PrototypeHandle prototype;
+        glm::vec2 position;
+        glm::vec3 color;
+        int row;
+        int hitCount;
+        float scale;
+        float speed;
+        bool isActive;
+        float innerRadius;
+        float outerRadius;
+    };
+
+    struct ProjectileObject
+    {
+        PrototypeHandle prototype;
+        std::string name;
+        glm::vec2 position;
+        glm::vec3 color;
+        float longerSideLength;
+        float shorterSideLength;
+        int numSegments;
+        float rotation;
+        bool isActive;
+        float speed;
+        int row;
+    };
+
+    void Populate(int count, std::mt19937& eng,
+                  std::vector<ZombieObject>& zombieObjects, std::vector<ProjectileObject>& projectileObjects,
+                  EntityStore& zombies, EntityStore& projectiles)
+    {
+        std::uniform_real_distribution<float> randomX(kBoard.x / 4.0f, kBoard.x / 2.0f);
+        std::uniform_real_distribution<float> randomSpeed(GMINSPEED, GMAXSPEED);
+        std::uniform_int_distribution<int> randomRow(0, GNUM_ROWS - 1);
+        std::uniform_int_distribution<int> randomColor(0, static_cast<int>(Gcolors.size()) - 1);
+
+        zombieObjects.clear();
+        projectileObjects.clear();
+        zombies.Clear();
+        projectiles.Clear();
+        for (int i = 0; i < count; ++i)
+        {
+            int row = randomRow(eng);
+            int color = randomColor(eng);
+            glm::vec2 position(randomX(eng), static_cast<float>(row));
+            float speed = randomSpeed(eng);
+
+            ZombieObject zombie = { "zombie" + std::to_string(i),
+                PrototypeMeshes::GetHandle(PrototypeKind::ZOMBIE, color),
+                position, Gcolors[color], row, 0, 1.0f, speed, true, GinnerRadiusZ, GoutterRadiusZ };
+            zombieObjects.push_back(zombie);
+            zombies.Create(position.x, position.y, speed, color, row, 3); // Three hits, as Zombie::IsDestroyed
+
+            ProjectileObject projectile = { PrototypeMeshes::GetHandle(PrototypeKind::PROJECTILE, color),
+                "projectile" + std::to_string(i), position, Gcolors[color],
+                GlengthLongerSidePJ / 5, GlengthShorterSidePJ / 5, GnumSegmentsPJ, 30.0f, true, speed, row };
+            projectileObjects.push_back(projectile);
+            EntityHandle handle = projectiles.Create(position.x, position.y, speed, color, row, 1);
+            projectiles.angle[projectiles.GetSlot(handle)] = 30.0f;
+        }
+    }
+
+    float MoveObjects(std::vector<ZombieObject>& zombies, std::vector<ProjectileObject>& projectiles)
+    {
+        float checksum = 0.0f;
+        for (auto& zombie : zombies)
+        {
+            zombie.position.x -= zombie.speed * kDeltaTime;
+            if (zombie.position.x < 0.0f)
+            {
+                zombie.isActive = false;
+            }
+            checksum += zombie.position.x;
+        }
+        for (auto& projectile : projectiles)
+        {
+            projectile.position.x += projectile.speed * kDeltaTime;
+            projectile.rotation += 5 * kDeltaTime;
+            if (projectile.rotation >= 360.0f)
+            {
+                projectile.rotation -= 360.0f;
+            }
+            if (projectile.position.x > kBoard.x)
+            {
+                projectile.isActive = false;
+            }
+            checksum += projectile.position.x;
+        }
+        return checksum;
+    }
+
+    // Same rules as GameSimulation::UpdateZombies and GameSimulation::UpdateProjectiles
+    float MoveColumns(EntityStore& zombies, EntityStore& projectiles)
+    {
+        float checksum = 0.0f;
+        for (int i = 0; i < zombies.GetSize(); ++i)
+        {
+            zombies.x[i] -= zombies.speed[i] * kDeltaTime;
+            if (zombies.x[i] < 0.0f)
+            {
+                zombies.active[i] = 0;
+            }
+            checksum += zombies.x[i];
+        }
+        for (int i = 0; i < projectiles.GetSize(); ++i)
+        {
+            projectiles.x[i] += projectiles.speed[i] * kDeltaTime;
+            projectiles.angle[i] += 5 * kDeltaTime;
+            if (projectiles.angle[i] >= 360.0f)
+            {
+                projectiles.angle[i] -= 360.0f;
+            }
+            if (projectiles.x[i] > kBoard.x)
+            {
+                projectiles.active[i] = 0;
+            }
+            checksum += projectiles.x[i];
+        }
+        return checksum;
+    }
+
+    int RemoveObjects(std::vector<ZombieObject>& zombies, std::vector<ProjectileObject>& projectiles)
+    {
+        for (size_t i = 0; i < zombies.size(); i += kRemovedEvery)
+        {
+            zombies[i].isActive = false;
+            projectiles[i].isActive = false;
+        }
+
+        zombies.erase(std::remove_if(zombies.begin(), zombies.end(),
+            [](const ZombieObject& zombie) { return !zombie.isActive; }),
+            zombies.end());
+        projectiles.erase(std::remove_if(projectiles.begin(), projectiles.end(),
+            [](const ProjectileObject& projectile) { return !projectile.isActive; }),
+            projectiles.end());
+        return static_cast<int>(zombies.size() + projectiles.size());
+    }
+
+    int RemoveColumns(EntityStore& zombies, EntityStore& projectiles)
+    {
+        for (int i = 0; i < zombies.GetSize(); i += kRemovedEvery)
+        {
+            zombies.active[i] = 0;
+            projectiles.active[i] = 0;
+        }
+
+        // Same backward loop as GameSimulation::RemoveFinishedEntities
+        for (int i = zombies.GetSize() - 1; i >= 0; --i)
+        {
+            if (!zombies.active[i])
+            {
+                zombies.DestroyAt(i);
+            }
+        }
+        for (int i = projectiles.GetSize() - 1; i >= 0; --i)
+        {
+            if (!projectiles.active[i])
+            {
+                projectiles.DestroyAt(i);
+            }
+        }
+        return zombies.GetSize() + projectiles.GetSize();
+    }
+
+    template <typename Function>
+    double MeasureMicroseconds(Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i)
+        {
+            function();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / kIterations;
+    }
+
+    // The removal changes its input, each iteration works on a fresh copy made outside the clock.
+    template <typename Zombies, typename Projectiles, typename Function>
+    double MeasureRemovalMicroseconds(const Zombies& zombies, const Projectiles& projectiles,
+                                      Function function, int& remaining)
+    {
+        double total = 0.0;
+        for (int i = 0; i < kIterations; ++i)
+        {
+            Zombies zombiesCopy = zombies;
+            Projectiles projectilesCopy = projectiles;
+
+            auto start = std::chrono::steady_clock::now();
+            remaining = function(zombiesCopy, projectilesCopy);
+            auto end = std::chrono::steady_clock::now();
+            total += std::chrono::duration<double, std::micro>(end - start).count();
+        }
+        return total / kIterations;
+    }
+}
+
+
+int main()
+{
+    const int sizes[] = { 10000, 100000 };
+
+    std::mt19937 eng(42);
+    std::vector<ZombieObject> zombieObjects;
+    std::vector<ProjectileObject> projectileObjects;
+    EntityStore zombies(sizes[1]);
+    EntityStore projectiles(sizes[1]);
+
+    // Bytes loaded per entity by the movement pass: whole objects against the columns it reads
+    std::printf("move bytes/entity: AoS zombie %zu, AoS projectile %zu, SoA zombie %zu, SoA projectile %zu\n",
+        sizeof(ZombieObject), sizeof(ProjectileObject),
+        2 * sizeof(float) + sizeof(unsigned char), 3 * sizeof(float) + sizeof(unsigned char));
+    std::printf("%9s %12s %12s %12s %12s %14s %14s\n",
+        "entities", "move AoS", "move SoA", "remove AoS", "remove SoA", "move ns/ent", "remove ns/ent");
+    std::printf("%9s %12s %12s %12s %12s %14s %14s\n",
+        "", "(us)", "(us)", "(us)", "(us)", "AoS / SoA", "AoS / SoA");
+
+    for (int size : sizes)
+    {
+        Populate(size, eng, zombieObjects, projectileObjects, zombies, projectiles);
+
+        float objectChecksum = 0.0f, columnChecksum = 0.0f;
+        double moveObjects = MeasureMicroseconds([&]() { objectChecksum = MoveObjects(zombieObjects, projectileObjects); });
+        double moveColumns = MeasureMicroseconds([&]() { columnChecksum = MoveColumns(zombies, projectiles); });
+
+        if (objectChecksum != columnChecksum)
+        {
+            std::fprintf(stderr, "position mismatch: %f objects, %f columns\n", objectChecksum, columnChecksum);
+            return 1;
+        }
+
+        int objectsLeft = 0, columnsLeft = 0;
+        double removeObjects = MeasureRemovalMicroseconds(zombieObjects, projectileObjects,
+            [](std::vector<ZombieObject>& z, std::vector<ProjectileObject>& p) { return RemoveObjects(z, p); }, objectsLeft);
+        double removeColumns = MeasureRemovalMicroseconds(zombies, projectiles,
+            [](EntityStore& z, EntityStore& p) { return RemoveColumns(z, p); }, columnsLeft);
+
+        if (objectsLeft != columnsLeft)
+        {
+            std::fprintf(stderr, "removal mismatch: %d objects, %d columns left\n", objectsLeft, columnsLeft);
+            return 1;
+        }
+
+        // Both kinds are moved and removed, so each pass touches 2 * size entities
+        double entities = 2.0 * size;
+        std::printf("%9d %12.1f %12.1f %12.1f %12.1f %6.2f / %5.2f %6.2f / %5.2f\n",
+            size, moveObjects, moveColumns, removeObjects, removeColumns,
+            moveObjects * 1000.0 / entities, moveColumns * 1000.0 / entities,
+            removeObjects * 1000.0 / entities, removeColumns * 1000.0 / entities);
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+// Collision cost of the projectile/zombie test, nested loops against the lane index.
+// Both variants count the same hits, the index one includes rebuilding the lanes.
+// The entities are the columns of an EntityStore, tested as GameSimulation does.
+
+#include "Plants_VS_Zombies/EntityStore.h"
+#include "Plants_VS_Zombies/GameConstants.h"
+#include "Plants_VS_Zombies/LaneIndex.h"
+#include "Plants_VS_Zombies/Zombies.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+
+namespace
+{
+    const float kBoardWidth = 1280.0f;
+    const int kIterations = 20;
+    // Size of the projectiles in the collision tests, as GameSimulation
+    const float kProjectileLength = GlengthLongerSidePJ / 5;
+
+    // Same vertical position as the zombies spawned by Zombie::SpawnZombieAtRow
+    float RowY(int row)
+    {
+        return Gcy + (GsideS * row) + (GspaceBetweenS * (row + 1)) + GsideS;
+    }
+
+    void Populate(int numZombies, int numProjectiles, std::mt19937& eng,
+                  EntityStore& zombies, EntityStore& projectiles)
+    {
+        std::uniform_real_distribution<float> randomX(0.0f, kBoardWidth);
+        std::uniform_int_distribution<int> randomRow(0, GNUM_ROWS - 1);
+        std::uniform_int_distribution<int> randomColor(0, static_cast<int>(Gcolors.size()) - 1);
+
+        zombies.Clear();
+        projectiles.Clear();
+        for (int i = 0; i < numZombies; ++i)
+        {
+            int row = randomRow(eng);
+            int color = randomColor(eng);
+            zombies.Create(randomX(eng), RowY(row), 50.0f, color, row, 3);
+        }
+        for (int i = 0; i < numProjectiles; ++i)
+        {
+            int row = randomRow(eng);
+            int color = randomColor(eng);
+            projectiles.Create(randomX(eng), RowY(row), 200.0f, color, row, 1);
+        }
+    }
+
+    // A projectile hits an active zombie of its color overlapping it
+    bool IsHit(const EntityStore& zombies, int zombie, const EntityStore& projectiles, int projectile)
+    {
+        return zombies.active[zombie] && zombies.colorId[zombie] == projectiles.colorId[projectile] &&
+            Zombie::IsOverlapping(glm::vec2(zombies.x[zombie], zombies.y[zombie]), GoutterRadiusZ,
+                                  glm::vec2(projectiles.x[projectile], projectiles.y[projectile]), kProjectileLength);
+    }
+
+    int NestedLoops(const EntityStore& zombies, const EntityStore& projectiles)
+    {
+        int hits = 0;
+        for (int p = 0; p < projectiles.GetSize(); ++p)
+        {
+            for (int z = 0; z < zombies.GetSize(); ++z)
+            {
+                if (IsHit(zombies, z, projectiles, p))
+                {
+                    hits++;
+                    break;
+                }
+            }
+        }
+        return hits;
+    }
+
+    int LaneQueries(const EntityStore& zombies, const EntityStore& projectiles, LaneIndex& lanes)
+    {
+        Zombie::BuildLaneIndex(zombies, lanes);
+
+        const float reach = GoutterRadiusZ + kProjectileLength;
+        int hits = 0;
+        for (int p = 0; p < projectiles.GetSize(); ++p)
+        {
+            float x = projectiles.x[p];
+            LaneIndex::Range nearby = lanes.Query(projectiles.row[p], projectiles.colorId[p], x - reach, x + reach);
+            for (const LaneIndex::Entry* entry = nearby.first; entry != nearby.last; ++entry)
+            {
+                if (IsHit(zombies, entry->index, projectiles, p))
+                {
+                    hits++;
+                    break;
+                }
+            }
+        }
+        return hits;
+    }
+
+    template <typename Function>
+    double MeasureMicroseconds(Function function, int& result)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i)
+        {
+            result = function();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / kIterations;
+    }
+}
+
+
+int main()
+{
+    const int sizes[][2] = { { 100, 500 }, { 250, 1250 }, { 500, 2500 }, { 1000, 5000 }, { 2000, 10000 } };
+
+    std::mt19937 eng(42);
+    // Sized for the last, largest, configuration
+    EntityStore zombies(sizes[4][0]);
+    EntityStore projectiles(sizes[4][1]);
+    LaneIndex lanes(GNUM_ROWS, static_cast<int>(Gcolors.size()));
+
+    std::printf("%8s %12s %14s %14s %16s %16s\n",
+        "zombies", "projectiles", "nested (us)", "lanes (us)", "nested ns/proj", "lanes ns/proj");
+
+    for (const auto& size : sizes)
+    {
+        Populate(size[0], size[1], eng, zombies, projectiles);
+
+        int nestedHits = 0, laneHits = 0;
+        double nested = MeasureMicroseconds([&]() { return NestedLoops(zombies, projectiles); }, nestedHits);
+        double lane = MeasureMicroseconds([&]() { return LaneQueries(zombies, projectiles, lanes); }, laneHits);
+
+        if (nestedHits != laneHits)
+        {
+            std::fprintf(stderr, "hit count mismatch: %d nested, %d lanes\n", nestedHits, laneHits);
+            return 1;
+        }
+
+        std::printf("%8d %12d %14.1f %14.1f %16.1f %16.1f\n", size[0], size[1], nested, lane,
+            nested * 1000.0 / size[1], lane * 1000.0 / size[1]);
+    }
+
+    return 0;
+}
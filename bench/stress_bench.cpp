@@ -0,0 +1,379 @@
+// Stress scenarios of the game rules: GameSimulation is stepped without a window or an
+// OpenGL context while a scenario keeps the board loaded far past a regular game, and
+// the results are printed as JSON for the build machines to compare.
+//
+//   StressBench [--scenario NAME] [--ticks N] [--seed S] [--zombies-per-row N]
+//               [--projectiles N] [--suns N] [--rows N] [--cols N] [--workers N] [--out FILE.json]
+//
+// Scenarios, all of them run when none is given:
+//   zombies      N zombies walking on every row, topped up each tick
+//   full_grid    a plant on every square, replanted as soon as one is lost
+//   projectiles  N projectiles flying across the board
+//   suns         N suns on the board
+//   all          every load above at once
+// Only the Step calls are timed: ticks/s, median and 99th percentile tick time, and the
+// heap allocations made by the steps. The peak RSS is the one of the process so far.
+// A scenario that loses every life restarts the game, the restarts are reported.
+// --rows and --cols grow the lawn to load more lanes, the entity pools grow with it. The
+// lanes are updated by --workers threads besides the main one, one per hardware thread by
+// default.
+
+#include "Plants_VS_Zombies/GameConstants.h"
+#include "Plants_VS_Zombies/GameSimulation.h"
+#include "core/jobs/job_system.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+
+namespace
+{
+    // Heap allocations of the process, counted by the operators below
+    std::atomic<unsigned long long> allocationCount(0);
+    std::atomic<unsigned long long> allocationBytes(0);
+}
+
+// Inlined into the callers, GCC pairs the malloc of operator new with the
+// delete expressions and warns about a mismatch that does not exist
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+
+BENCH_NOINLINE void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+BENCH_NOINLINE void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+
+namespace
+{
+    const float kDeltaTime = 1.0f / 60.0f;
+    const char* kScenarios[] = { "zombies", "full_grid", "projectiles", "suns", "all" };
+
+    struct Options
+    {
+        std::string scenario;       // Empty to run them all
+        unsigned long long ticks = 20000;
+        unsigned int seed = 42;
+        int zombiesPerRow = 40;
+        int projectiles = 2000;
+        int suns = 4000;
+        int rows = 0;               // 0 keeps the size of the game lawn
+        int cols = 0;
+        int workers = -1;           // -1 starts one per hardware thread
+        std::string outPath;        // Empty to print the JSON
+    };
+
+    // Load kept on the board by a scenario
+    struct Load
+    {
+        int zombiesPerRow;
+        bool fullGrid;
+        int projectiles;
+        int suns;
+    };
+
+    struct Result
+    {
+        std::string scenario;
+        unsigned long long ticks;
+        int games;
+        double stepSeconds;
+        double p50Us;
+        double p99Us;
+        double maxUs;
+        unsigned long long allocations;
+        unsigned long long allocatedBytes;
+        long peakRssKb;
+        int peakZombies;
+        int peakProjectiles;
+        int peakSuns;
+        int plants;
+        int refused;                // Spawns refused by the full pools, 0 unless they are too small
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--scenario") == 0 && hasValue)
+                options.scenario = argv[++i];
+            else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue)
+                options.ticks = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+                options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            else if (std::strcmp(argv[i], "--zombies-per-row") == 0 && hasValue)
+                options.zombiesPerRow = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--projectiles") == 0 && hasValue)
+                options.projectiles = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--suns") == 0 && hasValue)
+                options.suns = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--rows") == 0 && hasValue)
+                options.rows = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--cols") == 0 && hasValue)
+                options.cols = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--workers") == 0 && hasValue)
+                options.workers = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--out") == 0 && hasValue)
+                options.outPath = argv[++i];
+            else
+            {
+                std::fprintf(stderr,
+                    "usage: %s [--scenario zombies|full_grid|projectiles|suns|all] [--ticks N] [--seed S]\n"
+                    "          [--zombies-per-row N] [--projectiles N] [--suns N] [--rows N] [--cols N]\n"
+                    "          [--workers N] [--out FILE.json]\n",
+                    argv[0]);
+                return false;
+            }
+        }
+        return options.ticks > 0 && options.rows >= 0 && options.cols >= 0;
+    }
+
+    bool MakeLoad(const std::string& scenario, const Options& options, Load& load)
+    {
+        bool all = scenario == "all";
+        load.zombiesPerRow = all || scenario == "zombies" ? options.zombiesPerRow : 0;
+        load.fullGrid = all || scenario == "full_grid";
+        load.projectiles = all || scenario == "projectiles" ? options.projectiles : 0;
+        load.suns = all || scenario == "suns" ? options.suns : 0;
+        return std::find(std::begin(kScenarios), std::end(kScenarios), scenario) != std::end(kScenarios);
+    }
+
+    // Peak resident set of the process in KiB, -1 where it is not available
+    long GetPeakRssKb()
+    {
+#if defined(__APPLE__)
+        struct rusage usage;
+        return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<long>(usage.ru_maxrss / 1024) : -1;
+#elif defined(__unix__)
+        struct rusage usage;
+        return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<long>(usage.ru_maxrss) : -1;
+#else
+        return -1;
+#endif
+    }
+
+    // Top the board up to the load of the scenario, done outside the clock
+    void ApplyLoad(const Load& load, GameSimulation& simulation, std::vector<int>& zombiesPerRow)
+    {
+        if (load.zombiesPerRow > 0)
+        {
+            const EntityStore& zombies = simulation.GetZombies();
+            std::fill(zombiesPerRow.begin(), zombiesPerRow.end(), 0);
+            for (int i = 0; i < zombies.GetSize(); ++i)
+            {
+                if (zombies.active[i])
+                {
+                    zombiesPerRow[zombies.row[i]]++;
+                }
+            }
+            for (int row = 0; row < simulation.GetRows(); ++row)
+            {
+                simulation.SpawnZombies(row, load.zombiesPerRow - zombiesPerRow[row]);
+            }
+        }
+        if (load.fullGrid)
+        {
+            simulation.PlantFullGrid();
+        }
+        if (load.projectiles > 0)
+        {
+            simulation.SpawnProjectiles(load.projectiles - simulation.GetProjectiles().GetSize());
+        }
+        if (load.suns > 0)
+        {
+            simulation.SpawnPointScores(load.suns - simulation.GetPointScores().GetSize());
+        }
+    }
+
+    Result RunScenario(const std::string& scenario, const Load& load, const Options& options)
+    {
+        // The pools are sized for the load, the regular spawning keeps the headroom it has
+        // on a lawn of this size
+        int rows = options.rows > 0 ? options.rows : GNUM_ROWS;
+        int cols = options.cols > 0 ? options.cols : GNUM_COLS;
+        glm::ivec2 boardSize = glm::max(glm::ivec2(1280, 720), GameSimulation::GetMinimumBoardSize(rows, cols));
+        SimulationConfig config = { boardSize, options.seed,
+            GameSimulation::GetPoolCapacity(GMaxZombies, rows, cols) + load.zombiesPerRow * rows,
+            GameSimulation::GetPoolCapacity(GMaxProjectiles, rows, cols) + load.projectiles,
+            GameSimulation::GetPoolCapacity(GMaxPointScores, rows, cols) + load.suns,
+            rows, cols };
+        GameSimulation simulation(config);
+        simulation.PlantRandomGrid();
+
+        std::vector<int> zombiesPerRow(rows);
+        std::vector<double> tickUs;
+        tickUs.reserve(static_cast<size_t>(options.ticks));
+
+        Result result = Result();
+        result.scenario = scenario;
+        result.games = 1;
+
+        for (unsigned long long tick = 0; tick < options.ticks; ++tick)
+        {
+            if (!simulation.IsRunning())
+            {
+                simulation.Reset();
+                simulation.PlantRandomGrid();
+                result.games++;
+            }
+            ApplyLoad(load, simulation, zombiesPerRow);
+
+            unsigned long long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            unsigned long long bytesBefore = allocationBytes.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            simulation.Step(kDeltaTime);
+            auto end = std::chrono::steady_clock::now();
+            result.allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+            result.allocatedBytes += allocationBytes.load(std::memory_order_relaxed) - bytesBefore;
+
+            tickUs.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            result.plants = std::max(result.plants, static_cast<int>(simulation.GetPlants().size()));
+        }
+
+        result.ticks = options.ticks;
+        for (double us : tickUs)
+        {
+            result.stepSeconds += us / 1.0e6;
+        }
+
+        // Nearest rank percentiles
+        std::sort(tickUs.begin(), tickUs.end());
+        result.p50Us = tickUs[(tickUs.size() - 1) / 2];
+        result.p99Us = tickUs[(tickUs.size() - 1) * 99 / 100];
+        result.maxUs = tickUs.back();
+
+        result.peakRssKb = GetPeakRssKb();
+        result.peakZombies = simulation.GetZombies().GetPeakSize();
+        result.peakProjectiles = simulation.GetProjectiles().GetPeakSize();
+        result.peakSuns = simulation.GetPointScores().GetPeakSize();
+        result.refused = simulation.GetZombies().GetRejectedCount() + simulation.GetProjectiles().GetRejectedCount()
+            + simulation.GetPointScores().GetRejectedCount();
+        return result;
+    }
+
+    void WriteJson(FILE* file, const Options& options, const std::vector<Result>& results)
+    {
+        std::fprintf(file, "{\n");
+        std::fprintf(file, "  \"seed\": %u,\n", options.seed);
+        std::fprintf(file, "  \"dt\": %.6f,\n", kDeltaTime);
+        std::fprintf(file, "  \"workers\": %d,\n", JobSystem::GetWorkerCount());
+        std::fprintf(file, "  \"rows\": %d,\n", options.rows > 0 ? options.rows : GNUM_ROWS);
+        std::fprintf(file, "  \"cols\": %d,\n", options.cols > 0 ? options.cols : GNUM_COLS);
+        std::fprintf(file, "  \"peak_rss_kb\": %ld,\n", GetPeakRssKb());
+        std::fprintf(file, "  \"scenarios\": [");
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            std::fprintf(file, "%s\n    {\n", i ? "," : "");
+            std::fprintf(file, "      \"name\": \"%s\",\n", r.scenario.c_str());
+            std::fprintf(file, "      \"ticks\": %llu,\n", r.ticks);
+            std::fprintf(file, "      \"games\": %d,\n", r.games);
+            std::fprintf(file, "      \"ticks_per_s\": %.1f,\n", r.stepSeconds > 0.0 ? r.ticks / r.stepSeconds : 0.0);
+            std::fprintf(file, "      \"tick_p50_us\": %.3f,\n", r.p50Us);
+            std::fprintf(file, "      \"tick_p99_us\": %.3f,\n", r.p99Us);
+            std::fprintf(file, "      \"tick_max_us\": %.3f,\n", r.maxUs);
+            std::fprintf(file, "      \"allocations\": %llu,\n", r.allocations);
+            std::fprintf(file, "      \"allocated_bytes\": %llu,\n", r.allocatedBytes);
+            std::fprintf(file, "      \"peak_rss_kb\": %ld,\n", r.peakRssKb);
+            std::fprintf(file, "      \"peak_zombies\": %d,\n", r.peakZombies);
+            std::fprintf(file, "      \"peak_projectiles\": %d,\n", r.peakProjectiles);
+            std::fprintf(file, "      \"peak_suns\": %d,\n", r.peakSuns);
+            std::fprintf(file, "      \"peak_plants\": %d,\n", r.plants);
+            std::fprintf(file, "      \"refused_spawns\": %d\n", r.refused);
+            std::fprintf(file, "    }");
+        }
+        std::fprintf(file, "\n  ]\n}\n");
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    std::vector<std::string> scenarios;
+    if (options.scenario.empty())
+        scenarios.assign(std::begin(kScenarios), std::end(kScenarios));
+    else
+        scenarios.push_back(options.scenario);
+
+    // The game prints every life lost, silenced so it neither slows the steps down
+    // nor mixes with the JSON
+    std::streambuf* coutBuffer = std::cout.rdbuf(nullptr);
+    JobSystem::Init(options.workers);
+
+    std::vector<Result> results;
+    for (const auto& scenario : scenarios)
+    {
+        Load load;
+        if (!MakeLoad(scenario, options, load))
+        {
+            std::cout.rdbuf(coutBuffer);
+            std::fprintf(stderr, "unknown scenario: %s\n", scenario.c_str());
+            JobSystem::Shutdown();
+            return 1;
+        }
+        results.push_back(RunScenario(scenario, load, options));
+    }
+
+    std::cout.rdbuf(coutBuffer);
+    std::cout.clear();
+
+    FILE* file = options.outPath.empty() ? stdout : std::fopen(options.outPath.c_str(), "w");
+    if (!file)
+    {
+        std::fprintf(stderr, "cannot write %s\n", options.outPath.c_str());
+        JobSystem::Shutdown();
+        return 1;
+    }
+    WriteJson(file, options, results);
+    if (file != stdout)
+    {
+        std::fclose(file);
+    }
+
+    JobSystem::Shutdown();
+    return 0;
+}
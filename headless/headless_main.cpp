@@ -0,0 +1,210 @@
+// Headless driver of the game rules: steps GameSimulation with a fixed delta time,
+// without a window or an OpenGL context, and reports the simulated ticks per second.
+//
+//   PvZHeadless [--ticks N] [--dt SECONDS] [--seed S] [--autoplay] [--profile TRACE.json]
+//               [--rows N] [--cols N] [--workers N]
+//
+// With --autoplay a simple bot collects every sun and buys the cheapest plant
+// for a random free square, otherwise the lawn keeps the random starting plants.
+// When the game is over a new one starts, until the requested ticks are done.
+// With --profile each tick is a profiler frame: the average time of the simulation
+// zones is printed and the last frames are written as a Chrome trace.
+// --rows and --cols grow the lawn, the board and the entity pools are sized to fit it
+// (see GameSimulation::GetPoolCapacity). The lanes are updated by --workers threads
+// besides the main one, one per hardware thread by default; the results do not depend on it.
+
+#include "Plants_VS_Zombies/GameConstants.h"
+#include "Plants_VS_Zombies/GameSimulation.h"
+#include "core/jobs/job_system.h"
+#include "core/profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    struct Options
+    {
+        unsigned long long ticks = 1000000;
+        float deltaTime = 1.0f / 60.0f;
+        unsigned int seed = 42;
+        bool autoplay = false;
+        std::string tracePath;      // Empty when not profiling
+        int rows = 0;               // 0 keeps the size of the game lawn
+        int cols = 0;
+        int workers = -1;           // -1 starts one per hardware thread
+    };
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--ticks") == 0 && hasValue)
+                options.ticks = std::strtoull(argv[++i], nullptr, 10);
+            else if (std::strcmp(argv[i], "--dt") == 0 && hasValue)
+                options.deltaTime = static_cast<float>(std::atof(argv[++i]));
+            else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+                options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            else if (std::strcmp(argv[i], "--autoplay") == 0)
+                options.autoplay = true;
+            else if (std::strcmp(argv[i], "--profile") == 0 && hasValue)
+                options.tracePath = argv[++i];
+            else if (std::strcmp(argv[i], "--rows") == 0 && hasValue)
+                options.rows = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--cols") == 0 && hasValue)
+                options.cols = std::atoi(argv[++i]);
+            else if (std::strcmp(argv[i], "--workers") == 0 && hasValue)
+                options.workers = std::atoi(argv[++i]);
+            else
+            {
+                std::fprintf(stderr, "usage: %s [--ticks N] [--dt SECONDS] [--seed S] [--autoplay] [--profile TRACE.json]"
+                    " [--rows N] [--cols N] [--workers N]\n", argv[0]);
+                return false;
+            }
+        }
+        return options.deltaTime > 0.0f && options.rows >= 0 && options.cols >= 0;
+    }
+
+    void Accumulate(const SimulationStats& stats, SimulationStats& total)
+    {
+        total.ticks += stats.ticks;
+        total.zombiesSpawned += stats.zombiesSpawned;
+        total.zombiesKilled += stats.zombiesKilled;
+        total.projectilesFired += stats.projectilesFired;
+        total.plantsLost += stats.plantsLost;
+        total.pointScoresCollected += stats.pointScoresCollected;
+    }
+
+    // Collect the suns, then spend the points on the cheapest plant.
+    void Autoplay(GameSimulation& simulation, const std::vector<NameId>& plantNames, Random& random)
+    {
+        const EntityStore& pointScores = simulation.GetPointScores();
+        for (int i = 0; i < pointScores.GetSize(); ++i)
+        {
+            if (pointScores.active[i])
+            {
+                simulation.CollectPointScoresAt(glm::vec2(pointScores.x[i], pointScores.y[i]));
+            }
+        }
+
+        if (simulation.GetPointScoreCounter() < GcostPlantsINV[0])
+        {
+            return;
+        }
+
+        std::vector<glm::vec2> freeSquares;
+        for (const auto& square : simulation.GetSquares())
+        {
+            if (!square.IsOccupied())
+            {
+                freeSquares.push_back(square.GetCenterPosition());
+            }
+        }
+        if (freeSquares.empty())
+        {
+            return;
+        }
+
+        int colorIndex = random.NextInt(static_cast<int>(plantNames.size()));
+        Plant plant = GameSimulation::CreatePlant(colorIndex, plantNames[colorIndex], glm::vec2(0.0f));
+        simulation.PlacePlant(plant, freeSquares[random.NextInt(static_cast<int>(freeSquares.size()))]);
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    // The seed determines the whole run, the bot draws from its own stream
+    Random autoplayRandom(options.seed, RandomStream::AUTOPLAY);
+
+    JobSystem::Init(options.workers);
+
+    int rows = options.rows > 0 ? options.rows : GNUM_ROWS;
+    int cols = options.cols > 0 ? options.cols : GNUM_COLS;
+    glm::ivec2 boardSize = glm::max(glm::ivec2(1280, 720), GameSimulation::GetMinimumBoardSize(rows, cols));
+    SimulationConfig config = { boardSize, options.seed, 0, 0, 0, rows, cols };
+    GameSimulation simulation(config);
+    simulation.PlantRandomGrid();
+
+    // Names of the plants bought by the bot, interned once
+    std::vector<NameId> plantNames;
+    for (int colorIndex = 0; colorIndex < GplantSlots / 2; ++colorIndex)
+    {
+        plantNames.push_back(simulation.GetNames().Intern("autoplay" + std::to_string(colorIndex)));
+    }
+
+    SimulationStats total = SimulationStats();
+    int games = 1;
+    Profiler::SetEnabled(!options.tracePath.empty());
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long long tick = 0; tick < options.ticks; ++tick)
+    {
+        if (!simulation.IsRunning())
+        {
+            Accumulate(simulation.GetStats(), total);
+
+            simulation.Reset();
+            simulation.PlantRandomGrid();
+            games++;
+        }
+
+        Profiler::BeginFrame();
+        if (options.autoplay)
+        {
+            Autoplay(simulation, plantNames, autoplayRandom);
+        }
+        simulation.Step(options.deltaTime);
+        Profiler::EndFrame();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    Accumulate(simulation.GetStats(), total);
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("ticks           : %llu (%.1f s simulated)\n", total.ticks, total.ticks * options.deltaTime);
+    std::printf("wall time       : %.3f s\n", seconds);
+    std::printf("ticks/s         : %.0f\n", seconds > 0.0 ? total.ticks / seconds : 0.0);
+    std::printf("games           : %d\n", games);
+    std::printf("zombies spawned : %d\n", total.zombiesSpawned);
+    std::printf("zombies killed  : %d\n", total.zombiesKilled);
+    std::printf("projectiles     : %d\n", total.projectilesFired);
+    std::printf("plants lost     : %d\n", total.plantsLost);
+    std::printf("suns collected  : %d\n", total.pointScoresCollected);
+
+    // Occupancy of the entity pools, their memory never grows past the capacity
+    const EntityStore* pools[] = { &simulation.GetZombies(), &simulation.GetProjectiles(), &simulation.GetPointScores() };
+    const char* poolNames[] = { "zombie pool", "projectile pool", "sun pool" };
+    for (int i = 0; i < 3; ++i)
+    {
+        std::printf("%-15s : %d live, %d peak, %d capacity, %d refused\n", poolNames[i],
+            pools[i]->GetSize(), pools[i]->GetPeakSize(), pools[i]->GetCapacity(), pools[i]->GetRejectedCount());
+    }
+
+    if (Profiler::IsEnabled())
+    {
+        std::vector<Profiler::ZoneSummary> zones;
+        Profiler::Summarize(Profiler::MAX_FRAMES, zones);
+        for (const auto& zone : zones)
+        {
+            std::printf("%*s%-*s : %.3f us\n", 2 * zone.depth, "", 16 - 2 * zone.depth, zone.name, zone.cpuMs * 1000.0);
+        }
+        Profiler::WriteChromeTrace(options.tracePath);
+    }
+
+    JobSystem::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,806 @@
+#include "EntityKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#   define ENTITY_KERNELS_X86
+#   include <immintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       include <intrin.h>
+#       define ENTITY_KERNELS_TARGET_SSE2
+#       define ENTITY_KERNELS_TARGET_AVX2
+#   else
+        // Only these functions are compiled for the wider instruction sets,
+        // the rest of the game keeps the default flags of the compiler
+#       define ENTITY_KERNELS_TARGET_SSE2   __attribute__((target("sse2")))
+#       define ENTITY_KERNELS_TARGET_AVX2   __attribute__((target("avx2")))
+#   endif
+#endif
+
+
+using EntityKernels::InstructionSet;
+
+
+namespace
+{
+    InstructionSet DetectInstructionSet()
+    {
+#if defined(ENTITY_KERNELS_X86)
+#   if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        __cpuid(info, 1);
+        bool sse2 = (info[3] & (1 << 26)) != 0;
+        bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osSavesYmm)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#   else
+        __builtin_cpu_init();
+        bool sse2 = __builtin_cpu_supports("sse2") != 0;
+        bool avx2 = __builtin_cpu_supports("avx2") != 0;
+#   endif
+        if (avx2) return InstructionSet::AVX2;
+        if (sse2) return InstructionSet::SSE2;
+#endif
+        return InstructionSet::SCALAR;
+    }
+
+    InstructionSet& SelectedInstructionSet()
+    {
+        static InstructionSet selected = EntityKernels::GetSupportedInstructionSet();
+        return selected;
+    }
+
+
+    ///////////////////////////////////////// SCALAR /////////////////////////////////////////
+    // Same arithmetic as the entity methods, also used for the tails of the vector loops.
+
+    void MoveLeftScalar(float* x, const float* speed, unsigned char* active, int begin, int end, float deltaTime)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            if (!active[i]) continue;
+
+            x[i] -= speed[i] * deltaTime;
+            if (x[i] < 0.0f)
+            {
+                active[i] = 0;
+            }
+        }
+    }
+
+    void MoveRightAndSpinScalar(float* x, const float* y, const float* speed, float* angle, unsigned char* active,
+                                int begin, int end, float deltaTime, float spin, float maxX, float maxY)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            if (!active[i]) continue;
+
+            x[i] += speed[i] * deltaTime;
+            angle[i] += spin;
+            if (angle[i] >= 360.0f)
+            {
+                angle[i] -= 360.0f;
+            }
+            if (x[i] > maxX || y[i] > maxY)
+            {
+                active[i] = 0;
+            }
+        }
+    }
+
+    int IntersectRectangleScalar(const float* x, const float* y, const unsigned char* active, int begin, int end,
+                                 float radius, const glm::vec2& corner, float widthR, float heightR, int* hits, int numHits)
+    {
+        const float limit = radius / 2 * radius / 2;
+        const float right = corner.x + widthR;
+        const float top = corner.y + heightR;
+
+        for (int i = begin; i < end; ++i)
+        {
+            if (!active[i]) continue;
+
+            float deltaX = x[i] - std::max(corner.x, std::min(x[i], right));
+            float deltaY = y[i] - std::max(corner.y, std::min(y[i], top));
+            if ((deltaX * deltaX + deltaY * deltaY) < limit)
+            {
+                hits[numHits++] = i;
+            }
+        }
+        return numHits;
+    }
+
+    int FindFirstOverlapScalar(const float* x, const float* y, const unsigned char* active, int begin, int end,
+                               float radius, const glm::vec2& other, float otherSize)
+    {
+        const float reach = radius + otherSize;
+        for (int i = begin; i < end; ++i)
+        {
+            if (active[i] && std::fabs(x[i] - other.x) < reach && std::fabs(y[i] - other.y) < reach)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int MouseOverScalar(const float* x, const float* y, const unsigned char* active, int begin, int end,
+                        float radius, float mouseX, float mouseY, int* hits, int numHits)
+    {
+        const float limit = radius * radius;
+        for (int i = begin; i < end; ++i)
+        {
+            if (!active[i]) continue;
+
+            float dx = mouseX - x[i];
+            float dy = mouseY - y[i];
+            if (dx * dx + dy * dy <= limit)
+            {
+                hits[numHits++] = i;
+            }
+        }
+        return numHits;
+    }
+
+
+#if defined(ENTITY_KERNELS_X86)
+    // Clear the active flag of the lanes set in bits.
+    inline void Deactivate(unsigned char* active, int bits)
+    {
+        for (int lane = 0; bits != 0; ++lane, bits >>= 1)
+        {
+            if (bits & 1) active[lane] = 0;
+        }
+    }
+
+    // Append the slots of the lanes set in bits, returns the new number of hits.
+    inline int AppendHits(int* hits, int numHits, int firstSlot, int bits)
+    {
+        for (int lane = 0; bits != 0; ++lane, bits >>= 1)
+        {
+            if (bits & 1) hits[numHits++] = firstSlot + lane;
+        }
+        return numHits;
+    }
+
+    // Index of the lowest lane set in bits, bits must not be 0.
+    inline int FirstLane(int bits)
+    {
+        int lane = 0;
+        while (!(bits & 1))
+        {
+            bits >>= 1;
+            ++lane;
+        }
+        return lane;
+    }
+
+
+    ////////////////////////////////////////// SSE2 //////////////////////////////////////////
+    // The loops handle two registers, 8 entities, per step: the two halves do not depend on
+    // each other, so their loads and arithmetic overlap. A last register of 4 entities is
+    // handled alone before the scalar tail. Each helper computes one register and returns
+    // the bits of its lanes, the bits of the second register are shifted by 4 to keep the
+    // slots in ascending order.
+
+    // All bits set in the lanes of the active entities.
+    ENTITY_KERNELS_TARGET_SSE2
+    inline __m128 ActiveMask4(const unsigned char* active)
+    {
+        int bytes;
+        std::memcpy(&bytes, active, sizeof(bytes));
+
+        const __m128i zero = _mm_setzero_si128();
+        __m128i lanes = _mm_cvtsi32_si128(bytes);
+        lanes = _mm_unpacklo_epi8(lanes, zero);
+        lanes = _mm_unpacklo_epi16(lanes, zero);
+        return _mm_castsi128_ps(_mm_xor_si128(_mm_cmpeq_epi32(lanes, zero), _mm_set1_epi32(-1)));
+    }
+
+    ENTITY_KERNELS_TARGET_SSE2
+    inline __m128 Select4(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // Move 4 entities, returns the lanes crossing x = 0.
+    ENTITY_KERNELS_TARGET_SSE2
+    inline int MoveLeft4(float* x, const float* speed, const unsigned char* active, __m128 step)
+    {
+        __m128 mask = ActiveMask4(active);
+        __m128 oldX = _mm_loadu_ps(x);
+        __m128 newX = _mm_sub_ps(oldX, _mm_mul_ps(_mm_loadu_ps(speed), step));
+
+        _mm_storeu_ps(x, Select4(mask, newX, oldX));
+        return _mm_movemask_ps(_mm_and_ps(mask, _mm_cmplt_ps(newX, _mm_setzero_ps())));
+    }
+
+    ENTITY_KERNELS_TARGET_SSE2
+    void MoveLeftSSE2(float* x, const float* speed, unsigned char* active, int count, float deltaTime)
+    {
+        const __m128 step = _mm_set1_ps(deltaTime);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            int leaving = MoveLeft4(x + i, speed + i, active + i, step);
+            leaving |= MoveLeft4(x + i + 4, speed + i + 4, active + i + 4, step) << 4;
+            Deactivate(active + i, leaving);
+        }
+        if (i + 4 <= count)
+        {
+            Deactivate(active + i, MoveLeft4(x + i, speed + i, active + i, step));
+            i += 4;
+        }
+        MoveLeftScalar(x, speed, active, i, count, deltaTime);
+    }
+
+    // Move and rotate 4 entities, returns the lanes leaving the board.
+    ENTITY_KERNELS_TARGET_SSE2
+    inline int MoveRightAndSpin4(float* x, const float* y, const float* speed, float* angle, const unsigned char* active,
+                                 __m128 step, __m128 turn, __m128 limitX, __m128 limitY)
+    {
+        const __m128 fullTurn = _mm_set1_ps(360.0f);
+
+        __m128 mask = ActiveMask4(active);
+        __m128 oldX = _mm_loadu_ps(x);
+        __m128 newX = _mm_add_ps(oldX, _mm_mul_ps(_mm_loadu_ps(speed), step));
+
+        __m128 oldAngle = _mm_loadu_ps(angle);
+        __m128 newAngle = _mm_add_ps(oldAngle, turn);
+        newAngle = _mm_sub_ps(newAngle, _mm_and_ps(_mm_cmpge_ps(newAngle, fullTurn), fullTurn));
+
+        _mm_storeu_ps(x, Select4(mask, newX, oldX));
+        _mm_storeu_ps(angle, Select4(mask, newAngle, oldAngle));
+
+        __m128 outside = _mm_or_ps(_mm_cmpgt_ps(newX, limitX), _mm_cmpgt_ps(_mm_loadu_ps(y), limitY));
+        return _mm_movemask_ps(_mm_and_ps(mask, outside));
+    }
+
+    ENTITY_KERNELS_TARGET_SSE2
+    void MoveRightAndSpinSSE2(float* x, const float* y, const float* speed, float* angle, unsigned char* active,
+                              int count, float deltaTime, float spin, float maxX, float maxY)
+    {
+        const __m128 step = _mm_set1_ps(deltaTime);
+        const __m128 turn = _mm_set1_ps(spin);
+        const __m128 limitX = _mm_set1_ps(maxX);
+        const __m128 limitY = _mm_set1_ps(maxY);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            int leaving = MoveRightAndSpin4(x + i, y + i, speed + i, angle + i, active + i, step, turn, limitX, limitY);
+            leaving |= MoveRightAndSpin4(x + i + 4, y + i + 4, speed + i + 4, angle + i + 4, active + i + 4,
+                                         step, turn, limitX, limitY) << 4;
+            Deactivate(active + i, leaving);
+        }
+        if (i + 4 <= count)
+        {
+            Deactivate(active + i, MoveRightAndSpin4(x + i, y + i, speed + i, angle + i, active + i,
+                                                     step, turn, limitX, limitY));
+            i += 4;
+        }
+        MoveRightAndSpinScalar(x, y, speed, angle, active, i, count, deltaTime, spin, maxX, maxY);
+    }
+
+    // Returns the lanes of the 4 entities whose circle intersects the rectangle.
+    ENTITY_KERNELS_TARGET_SSE2
+    inline int IntersectRectangle4(const float* x, const float* y, const unsigned char* active,
+                                   __m128 limit, __m128 left, __m128 bottom, __m128 right, __m128 top)
+    {
+        __m128 centerX = _mm_loadu_ps(x);
+        __m128 centerY = _mm_loadu_ps(y);
+        __m128 deltaX = _mm_sub_ps(centerX, _mm_max_ps(left, _mm_min_ps(centerX, right)));
+        __m128 deltaY = _mm_sub_ps(centerY, _mm_max_ps(bottom, _mm_min_ps(centerY, top)));
+        __m128 distance = _mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY));
+
+        return _mm_movemask_ps(_mm_and_ps(ActiveMask4(active), _mm_cmplt_ps(distance, limit)));
+    }
+
+    ENTITY_KERNELS_TARGET_SSE2
+    int IntersectRectangleSSE2(const float* x, const float* y, const unsigned char* active, int count,
+                               float radius, const glm::vec2& corner, float widthR, float heightR, int* hits)
+    {
+        const __m128 limit = _mm_set1_ps(radius / 2 * radius / 2);
+        const __m128 left = _mm_set1_ps(corner.x);
+        const __m128 bottom = _mm_set1_ps(corner.y);
+        const __m128 right = _mm_set1_ps(corner.x + widthR);
+        const __m128 top = _mm_set1_ps(corner.y + heightR);
+
+        int numHits = 0;
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            int hit = IntersectRectangle4(x + i, y + i, active + i, limit, left, bottom, right, top);
+            hit |= IntersectRectangle4(x + i + 4, y + i + 4, active + i + 4, limit, left, bottom, right, top) << 4;
+            numHits = AppendHits(hits, numHits, i, hit);
+        }
+        if (i + 4 <= count)
+        {
+            numHits = AppendHits(hits, numHits, i,
+                IntersectRectangle4(x + i, y + i, active + i, limit, left, bottom, right, top));
+            i += 4;
+        }
+        return IntersectRectangleScalar(x, y, active, i, count, radius, corner, widthR, heightR, hits, numHits);
+    }
+
+    // Returns the lanes of the 4 entities whose box overlaps the other box.
+    ENTITY_KERNELS_TARGET_SSE2
+    inline int Overlap4(const float* x, const float* y, const unsigned char* active,
+                        __m128 reach, __m128 otherX, __m128 otherY)
+    {
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+        __m128 distanceX = _mm_and_ps(absMask, _mm_sub_ps(_mm_loadu_ps(x), otherX));
+        __m128 distanceY = _mm_and_ps(absMask, _mm_sub_ps(_mm_loadu_ps(y), otherY));
+        __m128 overlap = _mm_and_ps(_mm_cmplt_ps(distanceX, reach), _mm_cmplt_ps(distanceY, reach));
+
+        return _mm_movemask_ps(_mm_and_ps(ActiveMask4(active), overlap));
+    }
+
+    ENTITY_KERNELS_TARGET_SSE2
+    int FindFirstOverlapSSE2(const float* x, const float* y, const unsigned char* active, int count,
+                             float radius, const glm::vec2& other, float otherSize)
+    {
+        const __m128 reach = _mm_set1_ps(radius + otherSize);
+        const __m128 otherX = _mm_set1_ps(other.x);
+        const __m128 otherY = _mm_set1_ps(other.y);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            int bits = Overlap4(x + i, y + i, active + i, reach, otherX, otherY);
+            bits |= Overlap4(x + i + 4, y + i + 4, active + i + 4, reach, otherX, otherY) << 4;
+            if (bits != 0)
+            {
+                return i + FirstLane(bits);
+            }
+        }
+        if (i + 4 <= count)
+        {
+            int bits = Overlap4(x + i, y + i, active + i, reach, otherX, otherY);
+            if (bits != 0)
+            {
+                return i + FirstLane(bits);
+            }
+            i += 4;
+        }
+        return FindFirstOverlapScalar(x, y, active, i, count, radius, other, otherSize);
+    }
+
+    // Returns the lanes of the 4 entities whose circle contains the mouse.
+    ENTITY_KERNELS_TARGET_SSE2
+    inline int MouseOver4(const float* x, const float* y, const unsigned char* active,
+                          __m128 limit, __m128 pointerX, __m128 pointerY)
+    {
+        __m128 dx = _mm_sub_ps(pointerX, _mm_loadu_ps(x));
+        __m128 dy = _mm_sub_ps(pointerY, _mm_loadu_ps(y));
+        __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+        return _mm_movemask_ps(_mm_and_ps(ActiveMask4(active), _mm_cmple_ps(distance, limit)));
+    }
+
+    ENTITY_KERNELS_TARGET_SSE2
+    int MouseOverSSE2(const float* x, const float* y, const unsigned char* active, int count,
+                      float radius, float mouseX, float mouseY, int* hits)
+    {
+        const __m128 limit = _mm_set1_ps(radius * radius);
+        const __m128 pointerX = _mm_set1_ps(mouseX);
+        const __m128 pointerY = _mm_set1_ps(mouseY);
+
+        int numHits = 0;
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            int hit = MouseOver4(x + i, y + i, active + i, limit, pointerX, pointerY);
+            hit |= MouseOver4(x + i + 4, y + i + 4, active + i + 4, limit, pointerX, pointerY) << 4;
+            numHits = AppendHits(hits, numHits, i, hit);
+        }
+        if (i + 4 <= count)
+        {
+            numHits = AppendHits(hits, numHits, i, MouseOver4(x + i, y + i, active + i, limit, pointerX, pointerY));
+            i += 4;
+        }
+        return MouseOverScalar(x, y, active, i, count, radius, mouseX, mouseY, hits, numHits);
+    }
+
+
+    ////////////////////////////////////////// AVX2 //////////////////////////////////////////
+    // Same structure as SSE2, with two registers of 8 lanes: 16 entities per step.
+    // The scalar tails are compiled without VEX encoding: the upper halves of the registers
+    // are cleared before calling them, or every SSE instruction pays the AVX transition.
+
+    // All bits set in the lanes of the active entities.
+    ENTITY_KERNELS_TARGET_AVX2
+    inline __m256 ActiveMask8(const unsigned char* active)
+    {
+        __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(active)));
+        return _mm256_castsi256_ps(_mm256_cmpgt_epi32(lanes, _mm256_setzero_si256()));
+    }
+
+    // Move 8 entities, returns the lanes crossing x = 0.
+    ENTITY_KERNELS_TARGET_AVX2
+    inline int MoveLeft8(float* x, const float* speed, const unsigned char* active, __m256 step)
+    {
+        __m256 mask = ActiveMask8(active);
+        __m256 oldX = _mm256_loadu_ps(x);
+        __m256 newX = _mm256_sub_ps(oldX, _mm256_mul_ps(_mm256_loadu_ps(speed), step));
+
+        _mm256_storeu_ps(x, _mm256_blendv_ps(oldX, newX, mask));
+        return _mm256_movemask_ps(_mm256_and_ps(mask, _mm256_cmp_ps(newX, _mm256_setzero_ps(), _CMP_LT_OQ)));
+    }
+
+    ENTITY_KERNELS_TARGET_AVX2
+    void MoveLeftAVX2(float* x, const float* speed, unsigned char* active, int count, float deltaTime)
+    {
+        const __m256 step = _mm256_set1_ps(deltaTime);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            int leaving = MoveLeft8(x + i, speed + i, active + i, step);
+            leaving |= MoveLeft8(x + i + 8, speed + i + 8, active + i + 8, step) << 8;
+            Deactivate(active + i, leaving);
+        }
+        if (i + 8 <= count)
+        {
+            Deactivate(active + i, MoveLeft8(x + i, speed + i, active + i, step));
+            i += 8;
+        }
+        _mm256_zeroupper();
+        MoveLeftScalar(x, speed, active, i, count, deltaTime);
+    }
+
+    // Move and rotate 8 entities, returns the lanes leaving the board.
+    ENTITY_KERNELS_TARGET_AVX2
+    inline int MoveRightAndSpin8(float* x, const float* y, const float* speed, float* angle, const unsigned char* active,
+                                 __m256 step, __m256 turn, __m256 limitX, __m256 limitY)
+    {
+        const __m256 fullTurn = _mm256_set1_ps(360.0f);
+
+        __m256 mask = ActiveMask8(active);
+        __m256 oldX = _mm256_loadu_ps(x);
+        __m256 newX = _mm256_add_ps(oldX, _mm256_mul_ps(_mm256_loadu_ps(speed), step));
+
+        __m256 oldAngle = _mm256_loadu_ps(angle);
+        __m256 newAngle = _mm256_add_ps(oldAngle, turn);
+        newAngle = _mm256_sub_ps(newAngle,
+            _mm256_and_ps(_mm256_cmp_ps(newAngle, fullTurn, _CMP_GE_OQ), fullTurn));
+
+        _mm256_storeu_ps(x, _mm256_blendv_ps(oldX, newX, mask));
+        _mm256_storeu_ps(angle, _mm256_blendv_ps(oldAngle, newAngle, mask));
+
+        __m256 outside = _mm256_or_ps(_mm256_cmp_ps(newX, limitX, _CMP_GT_OQ),
+                                      _mm256_cmp_ps(_mm256_loadu_ps(y), limitY, _CMP_GT_OQ));
+        return _mm256_movemask_ps(_mm256_and_ps(mask, outside));
+    }
+
+    ENTITY_KERNELS_TARGET_AVX2
+    void MoveRightAndSpinAVX2(float* x, const float* y, const float* speed, float* angle, unsigned char* active,
+                              int count, float deltaTime, float spin, float maxX, float maxY)
+    {
+        const __m256 step = _mm256_set1_ps(deltaTime);
+        const __m256 turn = _mm256_set1_ps(spin);
+        const __m256 limitX = _mm256_set1_ps(maxX);
+        const __m256 limitY = _mm256_set1_ps(maxY);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            int leaving = MoveRightAndSpin8(x + i, y + i, speed + i, angle + i, active + i, step, turn, limitX, limitY);
+            leaving |= MoveRightAndSpin8(x + i + 8, y + i + 8, speed + i + 8, angle + i + 8, active + i + 8,
+                                         step, turn, limitX, limitY) << 8;
+            Deactivate(active + i, leaving);
+        }
+        if (i + 8 <= count)
+        {
+            Deactivate(active + i, MoveRightAndSpin8(x + i, y + i, speed + i, angle + i, active + i,
+                                                     step, turn, limitX, limitY));
+            i += 8;
+        }
+        _mm256_zeroupper();
+        MoveRightAndSpinScalar(x, y, speed, angle, active, i, count, deltaTime, spin, maxX, maxY);
+    }
+
+    // Returns the lanes of the 8 entities whose circle intersects the rectangle.
+    ENTITY_KERNELS_TARGET_AVX2
+    inline int IntersectRectangle8(const float* x, const float* y, const unsigned char* active,
+                                   __m256 limit, __m256 left, __m256 bottom, __m256 right, __m256 top)
+    {
+        __m256 centerX = _mm256_loadu_ps(x);
+        __m256 centerY = _mm256_loadu_ps(y);
+        __m256 deltaX = _mm256_sub_ps(centerX, _mm256_max_ps(left, _mm256_min_ps(centerX, right)));
+        __m256 deltaY = _mm256_sub_ps(centerY, _mm256_max_ps(bottom, _mm256_min_ps(centerY, top)));
+        __m256 distance = _mm256_add_ps(_mm256_mul_ps(deltaX, deltaX), _mm256_mul_ps(deltaY, deltaY));
+
+        return _mm256_movemask_ps(_mm256_and_ps(ActiveMask8(active), _mm256_cmp_ps(distance, limit, _CMP_LT_OQ)));
+    }
+
+    ENTITY_KERNELS_TARGET_AVX2
+    int IntersectRectangleAVX2(const float* x, const float* y, const unsigned char* active, int count,
+                               float radius, const glm::vec2& corner, float widthR, float heightR, int* hits)
+    {
+        const __m256 limit = _mm256_set1_ps(radius / 2 * radius / 2);
+        const __m256 left = _mm256_set1_ps(corner.x);
+        const __m256 bottom = _mm256_set1_ps(corner.y);
+        const __m256 right = _mm256_set1_ps(corner.x + widthR);
+        const __m256 top = _mm256_set1_ps(corner.y + heightR);
+
+        int numHits = 0;
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            int hit = IntersectRectangle8(x + i, y + i, active + i, limit, left, bottom, right, top);
+            hit |= IntersectRectangle8(x + i + 8, y + i + 8, active + i + 8, limit, left, bottom, right, top) << 8;
+            numHits = AppendHits(hits, numHits, i, hit);
+        }
+        if (i + 8 <= count)
+        {
+            numHits = AppendHits(hits, numHits, i,
+                IntersectRectangle8(x + i, y + i, active + i, limit, left, bottom, right, top));
+            i += 8;
+        }
+        _mm256_zeroupper();
+        return IntersectRectangleScalar(x, y, active, i, count, radius, corner, widthR, heightR, hits, numHits);
+    }
+
+    // Returns the lanes of the 8 entities whose box overlaps the other box.
+    ENTITY_KERNELS_TARGET_AVX2
+    inline int Overlap8(const float* x, const float* y, const unsigned char* active,
+                        __m256 reach, __m256 otherX, __m256 otherY)
+    {
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+
+        __m256 distanceX = _mm256_and_ps(absMask, _mm256_sub_ps(_mm256_loadu_ps(x), otherX));
+        __m256 distanceY = _mm256_and_ps(absMask, _mm256_sub_ps(_mm256_loadu_ps(y), otherY));
+        __m256 overlap = _mm256_and_ps(_mm256_cmp_ps(distanceX, reach, _CMP_LT_OQ),
+                                       _mm256_cmp_ps(distanceY, reach, _CMP_LT_OQ));
+
+        return _mm256_movemask_ps(_mm256_and_ps(ActiveMask8(active), overlap));
+    }
+
+    ENTITY_KERNELS_TARGET_AVX2
+    int FindFirstOverlapAVX2(const float* x, const float* y, const unsigned char* active, int count,
+                             float radius, const glm::vec2& other, float otherSize)
+    {
+        const __m256 reach = _mm256_set1_ps(radius + otherSize);
+        const __m256 otherX = _mm256_set1_ps(other.x);
+        const __m256 otherY = _mm256_set1_ps(other.y);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            int bits = Overlap8(x + i, y + i, active + i, reach, otherX, otherY);
+            bits |= Overlap8(x + i + 8, y + i + 8, active + i + 8, reach, otherX, otherY) << 8;
+            if (bits != 0)
+            {
+                return i + FirstLane(bits);
+            }
+        }
+        if (i + 8 <= count)
+        {
+            int bits = Overlap8(x + i, y + i, active + i, reach, otherX, otherY);
+            if (bits != 0)
+            {
+                return i + FirstLane(bits);
+            }
+            i += 8;
+        }
+        _mm256_zeroupper();
+        return FindFirstOverlapScalar(x, y, active, i, count, radius, other, otherSize);
+    }
+
+    // Returns the lanes of the 8 entities whose circle contains the mouse.
+    ENTITY_KERNELS_TARGET_AVX2
+    inline int MouseOver8(const float* x, const float* y, const unsigned char* active,
+                          __m256 limit, __m256 pointerX, __m256 pointerY)
+    {
+        __m256 dx = _mm256_sub_ps(pointerX, _mm256_loadu_ps(x));
+        __m256 dy = _mm256_sub_ps(pointerY, _mm256_loadu_ps(y));
+        __m256 distance = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+        return _mm256_movemask_ps(_mm256_and_ps(ActiveMask8(active), _mm256_cmp_ps(distance, limit, _CMP_LE_OQ)));
+    }
+
+    ENTITY_KERNELS_TARGET_AVX2
+    int MouseOverAVX2(const float* x, const float* y, const unsigned char* active, int count,
+                      float radius, float mouseX, float mouseY, int* hits)
+    {
+        const __m256 limit = _mm256_set1_ps(radius * radius);
+        const __m256 pointerX = _mm256_set1_ps(mouseX);
+        const __m256 pointerY = _mm256_set1_ps(mouseY);
+
+        int numHits = 0;
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            int hit = MouseOver8(x + i, y + i, active + i, limit, pointerX, pointerY);
+            hit |= MouseOver8(x + i + 8, y + i + 8, active + i + 8, limit, pointerX, pointerY) << 8;
+            numHits = AppendHits(hits, numHits, i, hit);
+        }
+        if (i + 8 <= count)
+        {
+            numHits = AppendHits(hits, numHits, i, MouseOver8(x + i, y + i, active + i, limit, pointerX, pointerY));
+            i += 8;
+        }
+        _mm256_zeroupper();
+        return MouseOverScalar(x, y, active, i, count, radius, mouseX, mouseY, hits, numHits);
+    }
+#endif // ENTITY_KERNELS_X86
+}
+
+
+/// <summary>
+/// Detect the widest instruction set supported by the CPU and the operating system.
+/// </summary>
+/// <returns>AVX2, SSE2 or SCALAR on the CPUs without any of them.</returns>
+InstructionSet EntityKernels::GetSupportedInstructionSet()
+{
+    static const InstructionSet supported = DetectInstructionSet();
+    return supported;
+}
+
+
+// Getter for the instruction set used by the kernels.
+InstructionSet EntityKernels::GetInstructionSet()
+{
+    return SelectedInstructionSet();
+}
+
+
+/// <summary>
+/// Force the instruction set of the kernels, used by the benchmarks to compare them.
+/// </summary>
+/// <param name="instructionSet">The wanted instruction set.</param>
+/// <returns>The instruction set used, capped to the one supported by the CPU.</returns>
+InstructionSet EntityKernels::SetInstructionSet(InstructionSet instructionSet)
+{
+    InstructionSet supported = GetSupportedInstructionSet();
+    SelectedInstructionSet() = (instructionSet > supported) ? supported : instructionSet;
+    return SelectedInstructionSet();
+}
+
+
+// Getter for the printable name of an instruction set.
+const char* EntityKernels::GetInstructionSetName(InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case InstructionSet::AVX2:  return "avx2";
+    case InstructionSet::SSE2:  return "sse2";
+    default:                    return "scalar";
+    }
+}
+
+
+/// <summary>
+/// Move the active entities leftward, deactivate the ones leaving the screen.
+/// </summary>
+/// <param name="x">Horizontal positions, updated.</param>
+/// <param name="speed">Horizontal speeds, in units per second.</param>
+/// <param name="active">Active flags, cleared for the entities crossing x = 0.</param>
+/// <param name="count">Number of entities.</param>
+/// <param name="deltaTime">Time elapsed since the last update.</param>
+void EntityKernels::MoveLeft(float* x, const float* speed, unsigned char* active, int count, float deltaTime)
+{
+    switch (SelectedInstructionSet())
+    {
+#if defined(ENTITY_KERNELS_X86)
+    case InstructionSet::AVX2:  MoveLeftAVX2(x, speed, active, count, deltaTime); return;
+    case InstructionSet::SSE2:  MoveLeftSSE2(x, speed, active, count, deltaTime); return;
+#endif
+    default:                    MoveLeftScalar(x, speed, active, 0, count, deltaTime); return;
+    }
+}
+
+
+/// <summary>
+/// Move the active entities rightward and rotate them, deactivate the ones leaving the board.
+/// </summary>
+/// <param name="x">Horizontal positions, updated.</param>
+/// <param name="y">Vertical positions.</param>
+/// <param name="speed">Horizontal speeds, in units per second.</param>
+/// <param name="angle">Rotations in degrees, updated and kept under 360.</param>
+/// <param name="active">Active flags, cleared for the entities leaving the board.</param>
+/// <param name="count">Number of entities.</param>
+/// <param name="deltaTime">Time elapsed since the last update.</param>
+/// <param name="spin">Degrees added to the rotations.</param>
+/// <param name="maxX">Right edge of the board.</param>
+/// <param name="maxY">Top edge of the board.</param>
+void EntityKernels::MoveRightAndSpin(float* x, const float* y, const float* speed, float* angle, unsigned char* active,
+                                     int count, float deltaTime, float spin, float maxX, float maxY)
+{
+    switch (SelectedInstructionSet())
+    {
+#if defined(ENTITY_KERNELS_X86)
+    case InstructionSet::AVX2:  MoveRightAndSpinAVX2(x, y, speed, angle, active, count, deltaTime, spin, maxX, maxY); return;
+    case InstructionSet::SSE2:  MoveRightAndSpinSSE2(x, y, speed, angle, active, count, deltaTime, spin, maxX, maxY); return;
+#endif
+    default:                    MoveRightAndSpinScalar(x, y, speed, angle, active, 0, count, deltaTime, spin, maxX, maxY); return;
+    }
+}
+
+
+/// <summary>
+/// Find the active entities whose circle intersects a rectangle.
+/// </summary>
+/// <param name="x">Horizontal positions of the circle centers.</param>
+/// <param name="y">Vertical positions of the circle centers.</param>
+/// <param name="active">Active flags.</param>
+/// <param name="count">Number of entities.</param>
+/// <param name="radius">Radius of the circles, halved as in Zombie::IsCircleIntersectingRectangle.</param>
+/// <param name="corner">Bottom-left corner of the rectangle.</param>
+/// <param name="widthR">Width of the rectangle.</param>
+/// <param name="heightR">Height of the rectangle.</param>
+/// <param name="hits">Receives the slots of the intersecting entities.</param>
+/// <returns>The number of slots written to hits.</returns>
+int EntityKernels::IntersectRectangle(const float* x, const float* y, const unsigned char* active, int count,
+                                      float radius, const glm::vec2& corner, float widthR, float heightR, int* hits)
+{
+    switch (SelectedInstructionSet())
+    {
+#if defined(ENTITY_KERNELS_X86)
+    case InstructionSet::AVX2:  return IntersectRectangleAVX2(x, y, active, count, radius, corner, widthR, heightR, hits);
+    case InstructionSet::SSE2:  return IntersectRectangleSSE2(x, y, active, count, radius, corner, widthR, heightR, hits);
+#endif
+    default:                    return IntersectRectangleScalar(x, y, active, 0, count, radius, corner, widthR, heightR, hits, 0);
+    }
+}
+
+
+/// <summary>
+/// Find the first active entity whose box overlaps the box of another entity.
+/// </summary>
+/// <param name="x">Horizontal positions of the entities.</param>
+/// <param name="y">Vertical positions of the entities.</param>
+/// <param name="active">Active flags.</param>
+/// <param name="count">Number of entities.</param>
+/// <param name="radius">Radius of the entities.</param>
+/// <param name="other">Position of the other entity.</param>
+/// <param name="otherSize">Size of the other entity.</param>
+/// <returns>The slot of the first overlapping entity, -1 if none.</returns>
+int EntityKernels::FindFirstOverlap(const float* x, const float* y, const unsigned char* active, int count,
+                                    float radius, const glm::vec2& other, float otherSize)
+{
+    switch (SelectedInstructionSet())
+    {
+#if defined(ENTITY_KERNELS_X86)
+    case InstructionSet::AVX2:  return FindFirstOverlapAVX2(x, y, active, count, radius, other, otherSize);
+    case InstructionSet::SSE2:  return FindFirstOverlapSSE2(x, y, active, count, radius, other, otherSize);
+#endif
+    default:                    return FindFirstOverlapScalar(x, y, active, 0, count, radius, other, otherSize);
+    }
+}
+
+
+/// <summary>
+/// Find the active entities whose circle contains the mouse.
+/// </summary>
+/// <param name="x">Horizontal positions of the circle centers.</param>
+/// <param name="y">Vertical positions of the circle centers.</param>
+/// <param name="active">Active flags.</param>
+/// <param name="count">Number of entities.</param>
+/// <param name="radius">Radius of the circles.</param>
+/// <param name="mouseX">X coordinate of the mouse in the world space.</param>
+/// <param name="mouseY">Y coordinate of the mouse in the world space.</param>
+/// <param name="hits">Receives the slots of the entities under the mouse.</param>
+/// <returns>The number of slots written to hits.</returns>
+int EntityKernels::MouseOver(const float* x, const float* y, const unsigned char* active, int count,
+                             float radius, float mouseX, float mouseY, int* hits)
+{
+    switch (SelectedInstructionSet())
+    {
+#if defined(ENTITY_KERNELS_X86)
+    case InstructionSet::AVX2:  return MouseOverAVX2(x, y, active, count, radius, mouseX, mouseY, hits);
+    case InstructionSet::SSE2:  return MouseOverSSE2(x, y, active, count, radius, mouseX, mouseY, hits);
+#endif
+    default:                    return MouseOverScalar(x, y, active, 0, count, radius, mouseX, mouseY, hits, 0);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef ENTITY_KERNELS_H
+#define ENTITY_KERNELS_H
+
+#include <glm/glm.hpp>
+
+
+// Batched versions of the per-entity movement and collision tests, run over the
+// contiguous columns of an EntityStore. Each kernel has a scalar, an SSE2 (4 lanes,
+// 8 entities per step) and an AVX2 (8 lanes, 16 entities per step) version, the best
+// one supported by the CPU is selected at run time. All the versions give the same
+// results as the scalar entity methods, bit for bit, so the simulation stays
+// deterministic whatever the CPU.
+// Inactive entities are skipped: they are neither moved nor reported by the tests.
+namespace EntityKernels
+{
+    enum class InstructionSet
+    {
+        SCALAR = 0,
+        SSE2,
+        AVX2
+    };
+
+    // Best instruction set supported by the CPU, detected once.
+    InstructionSet GetSupportedInstructionSet();
+    // Instruction set used by the kernels, the supported one unless forced.
+    InstructionSet GetInstructionSet();
+    // Force the kernels to an instruction set, capped to the supported one, returns the one used.
+    InstructionSet SetInstructionSet(InstructionSet instructionSet);
+    const char* GetInstructionSetName(InstructionSet instructionSet);
+
+    // Zombies: x -= speed * deltaTime, the entities crossing x = 0 are deactivated.
+    void MoveLeft(float* x, const float* speed, unsigned char* active, int count, float deltaTime);
+
+    // Projectiles: x += speed * deltaTime, angle += spin wrapped to [0, 360),
+    // the entities leaving the board (x > maxX or y > maxY) are deactivated.
+    void MoveRightAndSpin(float* x, const float* y, const float* speed, float* angle, unsigned char* active,
+                          int count, float deltaTime, float spin, float maxX, float maxY);
+
+    // Zombie::IsCircleIntersectingRectangle over the entities, writes the slots hit in
+    // ascending order, returns their number. hits must have room for count slots.
+    int IntersectRectangle(const float* x, const float* y, const unsigned char* active, int count,
+                           float radius, const glm::vec2& corner, float widthR, float heightR, int* hits);
+
+    // Zombie::IsOverlapping over the entities, returns the first slot overlapping other, -1 if none.
+    int FindFirstOverlap(const float* x, const float* y, const unsigned char* active, int count,
+                         float radius, const glm::vec2& other, float otherSize);
+
+    // PointScore::IsMouseOver over the entities, writes the slots under the mouse in
+    // ascending order, returns their number. hits must have room for count slots.
+    int MouseOver(const float* x, const float* y, const unsigned char* active, int count,
+                  float radius, float mouseX, float mouseY, int* hits);
+}
+
+#endif // ENTITY_KERNELS_H
@@ -0,0 +1,219 @@
+#include "EntityStore.h"
+
+#include <algorithm>
+#include <iostream>
+
+
+namespace
+{
+    // Handle layout: up to a million indices, 4096 generations before an index wraps around
+    const unsigned int kIndexBits = 20;
+    const unsigned int kIndexMask = (1u << kIndexBits) - 1;
+    const unsigned int kGenerationMask = (1u << (32 - kIndexBits)) - 1;
+
+    EntityHandle MakeHandle(unsigned int index, unsigned int generation)
+    {
+        return (generation << kIndexBits) | index;
+    }
+
+    unsigned int GetIndex(EntityHandle handle)      { return handle & kIndexMask; }
+    unsigned int GetGeneration(EntityHandle handle) { return handle >> kIndexBits; }
+
+    // Move the last element of a column into a slot and drop the last element.
+    template <typename T>
+    void SwapAndPop(std::vector<T>& column, int slot)
+    {
+        column[slot] = column.back();
+        column.pop_back();
+    }
+}
+
+
+/// <summary>
+/// Create an empty pool, the columns and the free list are allocated once for all.
+/// </summary>
+/// <param name="capacity">Maximum number of entities alive at the same time.</param>
+EntityStore::EntityStore(int capacity) :
+    firstFree(-1),
+    capacity(std::max(0, std::min(capacity, static_cast<int>(kIndexMask)))), // The last index is kept for INVALID_ENTITY
+    peakSize(0), rejectedCount(0)
+{
+    x.reserve(this->capacity);
+    y.reserve(this->capacity);
+    prevX.reserve(this->capacity);
+    speed.reserve(this->capacity);
+    scale.reserve(this->capacity);
+    angle.reserve(this->capacity);
+    timer.reserve(this->capacity);
+    colorId.reserve(this->capacity);
+    row.reserve(this->capacity);
+    hp.reserve(this->capacity);
+    active.reserve(this->capacity);
+    handles.reserve(this->capacity);
+    slots.assign(this->capacity, -1);
+    generations.assign(this->capacity, 0);
+
+    // Every index is free, they are handed out in ascending order
+    nextFree.resize(this->capacity);
+    for (int index = 0; index < this->capacity; ++index)
+    {
+        nextFree[index] = index + 1 < this->capacity ? index + 1 : -1;
+    }
+    firstFree = this->capacity > 0 ? 0 : -1;
+}
+EntityStore::~EntityStore() {}
+
+
+/// <summary>
+/// Append an entity at the end of the columns.
+/// </summary>
+/// <param name="x">Horizontal position.</param>
+/// <param name="y">Vertical position.</param>
+/// <param name="speed">Horizontal speed, in units per second.</param>
+/// <param name="colorId">Index of the color inside Gcolors.</param>
+/// <param name="row">Row of the lawn, -1 outside of the grid.</param>
+/// <param name="hp">Hits left before the entity is destroyed.</param>
+/// <returns>The handle of the new entity, INVALID_ENTITY if the pool is full.</returns>
+EntityHandle EntityStore::Create(float x, float y, float speed, int colorId, int row, int hp)
+{
+    if (firstFree == -1)
+    {
+        // Reported once, a full pool refuses every spawn until an entity is destroyed
+        if (rejectedCount++ == 0)
+        {
+            std::cerr << "Error: EntityStore is full, " << capacity << " entities" << std::endl;
+        }
+        return INVALID_ENTITY;
+    }
+
+    unsigned int index = static_cast<unsigned int>(firstFree);
+    firstFree = nextFree[index];
+
+    EntityHandle handle = MakeHandle(index, generations[index]);
+    slots[index] = static_cast<int>(handles.size());
+    handles.push_back(handle);
+
+    this->x.push_back(x);
+    this->y.push_back(y);
+    this->prevX.push_back(x);
+    this->speed.push_back(speed);
+    this->scale.push_back(1.0f);
+    this->angle.push_back(0.0f);
+    this->timer.push_back(0.0f);
+    this->colorId.push_back(colorId);
+    this->row.push_back(row);
+    this->hp.push_back(hp);
+    this->active.push_back(1);
+
+    peakSize = std::max(peakSize, GetSize());
+    return handle;
+}
+
+
+/// <summary>
+/// Remove the entity of a handle, nothing happens for a stale handle.
+/// </summary>
+/// <param name="handle">The handle returned by Create.</param>
+void EntityStore::Destroy(EntityHandle handle)
+{
+    int slot = GetSlot(handle);
+    if (slot != -1)
+    {
+        DestroyAt(slot);
+    }
+}
+
+
+/// <summary>
+/// Remove the entity of a slot in O(1): the last entity is moved into the slot.
+/// Loops removing entities while iterating must revisit the slot.
+/// </summary>
+/// <param name="slot">Slot of the entity, in [0, GetSize()).</param>
+void EntityStore::DestroyAt(int slot)
+{
+    EntityHandle removed = handles[slot];
+    EntityHandle moved = handles.back();
+
+    SwapAndPop(x, slot);
+    SwapAndPop(y, slot);
+    SwapAndPop(prevX, slot);
+    SwapAndPop(speed, slot);
+    SwapAndPop(scale, slot);
+    SwapAndPop(angle, slot);
+    SwapAndPop(timer, slot);
+    SwapAndPop(colorId, slot);
+    SwapAndPop(row, slot);
+    SwapAndPop(hp, slot);
+    SwapAndPop(active, slot);
+    SwapAndPop(handles, slot);
+
+    slots[GetIndex(moved)] = slot;
+    Release(removed);
+}
+
+
+// Free the index of a handle, its next handle gets a new generation.
+void EntityStore::Release(EntityHandle handle)
+{
+    unsigned int index = GetIndex(handle);
+    slots[index] = -1;
+    generations[index] = (generations[index] + 1) & kGenerationMask;
+    nextFree[index] = firstFree;
+    firstFree = static_cast<int>(index);
+}
+
+
+/// <summary>
+/// Remove every entity, all the handles become stale.
+/// </summary>
+void EntityStore::Clear()
+{
+    for (EntityHandle handle : handles)
+    {
+        Release(handle);
+    }
+
+    x.clear();
+    y.clear();
+    prevX.clear();
+    speed.clear();
+    scale.clear();
+    angle.clear();
+    timer.clear();
+    colorId.clear();
+    row.clear();
+    hp.clear();
+    active.clear();
+    handles.clear();
+}
+
+
+// Check if the handle still refers to an entity.
+bool EntityStore::IsAlive(EntityHandle handle) const
+{
+    return GetSlot(handle) != -1;
+}
+
+
+// Getter for the slot of a handle, -1 for a stale or unknown handle.
+int EntityStore::GetSlot(EntityHandle handle) const
+{
+    unsigned int index = GetIndex(handle);
+    if (index >= slots.size() || generations[index] != GetGeneration(handle))
+    {
+        return -1;
+    }
+    return slots[index];
+}
+
+
+// Getter for the handle of the entity stored in a slot.
+EntityHandle    EntityStore::GetHandle(int slot) const  { return handles[slot]; }
+// Getter for the number of live entities.
+int             EntityStore::GetSize() const            { return static_cast<int>(handles.size()); }
+// Getter for the maximum number of live entities.
+int             EntityStore::GetCapacity() const        { return capacity; }
+// Getter for the highest number of live entities since construction.
+int             EntityStore::GetPeakSize() const        { return peakSize; }
+// Getter for the number of entities refused because the pool was full.
+int             EntityStore::GetRejectedCount() const   { return rejectedCount; }
@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include <vector>
+
+
+// Handle to an entity of a store: an index in the low bits, the generation of the index in
+// the high bits. Destroying an entity bumps the generation of its index, so a stale handle
+// never refers to the entity created next with the same index.
+using EntityHandle = unsigned int;
+constexpr EntityHandle INVALID_ENTITY = 0xFFFFFFFFu;
+
+
+// Structure of arrays storage for the entities spawned at run time (zombies, projectiles, suns).
+// Each field lives in its own contiguous column, so the movement and collision passes only
+// stream the fields they read. Live entities are packed in the slots [0, GetSize()),
+// destroying one moves the last entity into its slot (swap and pop), handles keep
+// pointing to the same entity whatever slot it ends up in.
+// The store is a fixed-capacity pool: every column and the free list of handle indices are
+// allocated once by the constructor, Create and Destroy are O(1) and never allocate.
+class EntityStore
+{
+public:
+    explicit EntityStore(int capacity);
+    ~EntityStore();
+
+    // Append an active entity with a unit scale, returns its handle (INVALID_ENTITY when full).
+    EntityHandle Create(float x, float y, float speed, int colorId, int row, int hp);
+    // Remove the entity of a handle, the handle becomes free.
+    void Destroy(EntityHandle handle);
+    // Remove the entity of a slot, the last entity takes its place.
+    void DestroyAt(int slot);
+    // Remove every entity, the columns keep their capacity and the old handles become stale.
+    void Clear();
+
+    bool IsAlive(EntityHandle handle) const;
+    // Slot of a live entity, -1 for a free handle.
+    int GetSlot(EntityHandle handle) const;
+    // Handle of the entity stored in a slot.
+    EntityHandle GetHandle(int slot) const;
+    int GetSize() const;
+    // Occupancy of the pool: maximum number of live entities, highest number reached
+    // since construction and number of Create calls refused because the pool was full.
+    int GetCapacity() const;
+    int GetPeakSize() const;
+    int GetRejectedCount() const;
+
+public:
+    // Columns, indexed by slot.
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> prevX;               // x at the start of the last tick, the renderer interpolates from it
+    std::vector<float> speed;
+    std::vector<float> scale;               // Drawing scale, shrinks while a destroyed entity fades out
+    std::vector<float> angle;               // Rotation in degrees
+    std::vector<float> timer;               // Time left before the entity expires
+    std::vector<int> colorId;               // Index of the color inside Gcolors
+    std::vector<int> row;                   // Row of the lawn, -1 outside of the grid
+    std::vector<int> hp;                    // Hits left before the entity is destroyed
+    std::vector<unsigned char> active;      // Entity still walking, flying or waiting to be collected
+
+private:
+    void Release(EntityHandle handle);
+
+private:
+    std::vector<int> slots;                 // Slot of each handle index, -1 for a free index
+    std::vector<unsigned int> generations;  // Current generation of each handle index
+    std::vector<EntityHandle> handles;      // Handle of each slot
+    std::vector<int> nextFree;              // Free list threaded through the handle indices, -1 ends it
+    int firstFree;                          // Handle index reused by the next Create, the last released
+    int capacity;
+    int peakSize;
+    int rejectedCount;
+};
+
+#endif // ENTITY_STORE_H
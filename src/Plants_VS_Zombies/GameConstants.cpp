@@ -42,6 +42,11 @@ const float GMAXSPEED = 60.f;
 // Drop tollerance distance mouse position and center green square.
 const float DROP_TOLL = 15.0f;
 
+// Simulation ticks per second, same rate as the headless driver default.
+const int GSimulationTickRate = 60;
+// Ticks run at most per frame, a longer stall slows the game down instead.
+const int GMaxCatchUpSteps = 5;
+
 // ----------------------
 // Zombie-related Constants
 // ----------------------
@@ -57,6 +62,7 @@ const float GminZombieSpeed = 25.0f;     // Minimum speed at which zombies move
 const float GmaxZombieSpeed = 50.0f;     // Maximum speed for zombies
 const float GspawnProbability = 0.1f;    // Probability of zombie spawning at each interval
 const float GspawnDelay = 8.0f;          // Delay in seconds between zombie spawn attempts
+const int GMaxZombies = 256;             // Capacity of the zombie pool, about 20 are alive at most
 
 // ---------------------
 // Plant-related Constants
@@ -82,6 +88,7 @@ const std::vector<int> GcostPlantsINV = { 1, 1, 1, 1, 2, 2, 3, 3 };
 const int GnumSegmentsPJ = 8;            // Number of segments to render each projectile
 const float GlengthLongerSidePJ = 25.f;  // Length of the longer side of a projectile
 const float GlengthShorterSidePJ = 15.f; // Length of the shorter side of a projectile
+const int GMaxProjectiles = 512;         // Capacity of the projectile pool, one shot every 5 seconds per plant
 
 // ----------------------------
 // PointScore-related Constants
@@ -93,6 +100,8 @@ const int GnumSegmentsPST = 30;          // Number of segments in each PointScor
 const int GraySegmentsPST = 75;          // Number of ray segments in PointScore
 const float GrayLengthBiggerPST = 20.f;  // Length of larger rays in PointScore
 const float GrayLengthSmallerPST = 10.f; // Length of smaller rays in PointScore
+const float GlifeSpanPST = 5.f;          // Seconds a PointScore stays on the screen
+const int GMaxPointScores = 64;          // Capacity of the PointScore pool, 6 suns every 5 seconds at most
 
 // --------------------
 // Hearth-related Constants
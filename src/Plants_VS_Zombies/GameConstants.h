@@ -1,6 +1,5 @@
 #pragma once
 
-#include "components/simple_scene.h"
 #include <glm/glm.hpp>
 
 #include "Plants.h"
@@ -53,6 +52,10 @@ extern const float GMAXSPEED;
 
 extern const float DROP_TOLL;
 
+// Fixed timestep of the simulation, independent of the refresh rate
+extern const int GSimulationTickRate;
+extern const int GMaxCatchUpSteps;
+
 // ----------------------
 // Zombie-related Constants
 // ----------------------
@@ -64,6 +67,7 @@ extern const float GminZombieSpeed;
 extern const float GmaxZombieSpeed;
 extern const float GspawnProbability;
 extern const float GspawnDelay;
+extern const int GMaxZombies;
 
 // Zombie size parameters
 extern const float GinnerRadiusZ;
@@ -99,6 +103,7 @@ extern const std::vector<int> GcostPlantsINV;
 extern const int GnumSegmentsPJ;
 extern const float GlengthLongerSidePJ;
 extern const float GlengthShorterSidePJ;
+extern const int GMaxProjectiles;
 
 // ----------------------------
 // PointScore-related Constants
@@ -110,6 +115,8 @@ extern const int GnumSegmentsPST;
 extern const int GraySegmentsPST;
 extern const float GrayLengthBiggerPST;
 extern const float GrayLengthSmallerPST;
+extern const float GlifeSpanPST;
+extern const int GMaxPointScores;
 
 // --------------------
 // Hearth-related Constants
@@ -3,8 +3,8 @@
 
 #include "Objects2D.h"
 #include "ObjectsGame.h"
+#include "GameSimulation.h"
 
-#include "GreenSquares.h"
 #include "Plants_VS_Zombies.h"
 
 #include <iostream>
@@ -64,9 +64,15 @@ void GameInit::InitializeInventorySlots()
 
 
 /// <summary>
-/// Initialize plant meshes and adds them to the inventory slots.
+/// Initialize plant meshes and the Plant objects placed in the inventory slots.
+/// The inventory is built only once, rendering it every frame reuses these objects.
+/// The mesh of a slot is shared by every plant of its color placed on the lawn.
 /// </summary>
-void GameInit::InitializePlantsForInventory()
+/// <param name="inventoryPlants">A vector to store the plants that can be dragged from the inventory.</param>
+/// <param name="prototypes">The registry that maps (kind, color) handles to meshes.</param>
+/// <param name="names">The table interning the debug names of the plants.</param>
+void GameInit::InitializePlantsForInventory(std::vector<Plant>& inventoryPlants, PrototypeMeshes& prototypes,
+    NameTable& names)
 {
     // Create the initial plants inventory slots
     for (int i = 0; i < GslotsINV - 1; ++i)
@@ -75,7 +81,8 @@ void GameInit::InitializePlantsForInventory()
         std::string plantSlotName = "plantSlot" + std::to_string(i);
 
         // Determine the color for the plant from the predefined colors
-        glm::vec3 color = Gcolors[i % Gcolors.size()];
+        int colorIndex = i % static_cast<int>(Gcolors.size());
+        glm::vec3 color = Gcolors[colorIndex];
 
         // Create the plant mesh using the predefined parameters and color
         Mesh* plantMesh = ObjectsGame::CreatePlant(
@@ -90,7 +97,19 @@ void GameInit::InitializePlantsForInventory()
         // Add the last slot mesh to the map and the list of meshes.
         meshMap[plantSlotName] = plantMesh;
         addMeshToList(plantMesh);
+        prototypes.Register(PrototypeKind::PLANT, colorIndex, plantMesh);
+
+        // Same plant as a single quad, drawn by the SDFShape shader in shape mode
+        std::string plantShapeName = plantSlotName + "Shape";
+        Mesh* plantShape = ObjectsGame::CreatePlantShape(plantShapeName,
+            GnumTrianglesPT, GtriangleInnerLenPT, GtriangleOuterLenPT, color);
+        meshMap[plantShapeName] = plantShape;
+        addMeshToList(plantShape);
+        prototypes.RegisterShape(PrototypeKind::PLANT, colorIndex, plantShape);
     }
+
+    // The Plant objects of the slots need no OpenGL, the simulation creates them
+    GameSimulation::CreateInventory(inventoryPlants, names);
 }
 
 
@@ -155,6 +174,25 @@ void GameInit::InitializeHeartsForInventory()
 }
 
 
+/// <summary>
+/// Initialize the quads of the SDFShape shader baked in the inventory in shape mode,
+/// every sun cost and every heart share the same quad.
+/// </summary>
+void GameInit::InitializeShapesForInventory()
+{
+    std::string sunShapeName = "sunShape";
+    Mesh* sunShape = ObjectsGame::CreatePointScoreShape(sunShapeName,
+        GradiusSUN, GnumSegmentsPST, GlenRayBiggerSUN, GlenRaySmallerSUN, GBACKGROUND);
+    meshMap[sunShapeName] = sunShape;
+    addMeshToList(sunShape);
+
+    std::string heartShapeName = "heartShape";
+    Mesh* heartShape = ObjectsGame::CreateHearthShape(heartShapeName, GscaleH, GRED);
+    meshMap[heartShapeName] = heartShape;
+    addMeshToList(heartShape);
+}
+
+
 /// <summary>
 /// Initialize the base RED rectangle object.
 /// </summary>
@@ -178,10 +216,79 @@ void GameInit::InitializeBaseRectangle()
 
 
 /// <summary>
-/// Initialize green squares for plants in a game grid.
+/// Initialize the meshes shared by every spawned entity, one per kind and color.
+/// Zombies, projectiles and suns only keep a handle to one of these meshes,
+/// spawning them at run time does not allocate any GPU buffer.
+/// Each mesh has an SDF quad drawn instead of it in shape mode.
 /// </summary>
-/// <param name="squares">A vector to store GreenSquare objects representing the grid cells.</param>
-void GameInit::InitializeGreenSquaresForPlants(std::vector<GreenSquare>& squares)
+/// <param name="prototypes">The registry that maps (kind, color) handles to meshes.</param>
+void GameInit::InitializePrototypeMeshes(PrototypeMeshes& prototypes)
+{
+    for (size_t i = 0; i < Gcolors.size(); ++i)
+    {
+        int colorIndex = static_cast<int>(i);
+
+        // Zombie of the i-th color, same geometry as the ones spawned in the lanes
+        std::string zombieName = "prototypeZombie" + std::to_string(i);
+        Mesh* zombieMesh = ObjectsGame::CreateZombie(zombieName, GinnerRadiusZ, GoutterRadiusZ, Gcolors[i]);
+        meshMap[zombieName] = zombieMesh;
+        addMeshToList(zombieMesh);
+        prototypes.Register(PrototypeKind::ZOMBIE, colorIndex, zombieMesh);
+
+        std::string zombieShapeName = zombieName + "Shape";
+        Mesh* zombieShape = ObjectsGame::CreateZombieShape(zombieShapeName,
+            GinnerRadiusZ, GoutterRadiusZ, Gcolors[i]);
+        meshMap[zombieShapeName] = zombieShape;
+        addMeshToList(zombieShape);
+        prototypes.RegisterShape(PrototypeKind::ZOMBIE, colorIndex, zombieShape);
+
+        // Projectile of the i-th color, shot by the plants of the same color
+        std::string projectileName = "prototypeProjectile" + std::to_string(i);
+        Mesh* projectileMesh = ObjectsGame::CreateProjectile(projectileName,
+            GnumSegmentsPJ,
+            GlengthLongerSidePJ / 5, GlengthShorterSidePJ / 5,
+            Gcolors[i]);
+        meshMap[projectileName] = projectileMesh;
+        addMeshToList(projectileMesh);
+        prototypes.Register(PrototypeKind::PROJECTILE, colorIndex, projectileMesh);
+
+        std::string projectileShapeName = projectileName + "Shape";
+        Mesh* projectileShape = ObjectsGame::CreateProjectileShape(projectileShapeName,
+            GnumSegmentsPJ,
+            GlengthLongerSidePJ / 5, GlengthShorterSidePJ / 5,
+            Gcolors[i]);
+        meshMap[projectileShapeName] = projectileShape;
+        addMeshToList(projectileShape);
+        prototypes.RegisterShape(PrototypeKind::PROJECTILE, colorIndex, projectileShape);
+    }
+
+    // Suns collected on the screen have a single color, stored at the first color slot
+    std::string pointScoreName = "prototypePointScore";
+    Mesh* pointScoreMesh = ObjectsGame::CreatePointScore(pointScoreName,
+        20.0f,                         // radius
+        30, 75,                        // segments, raySegments
+        20.0f, 10.0f,                  // rayBigger, raySmaller
+        GYELLOW);                      // color
+    meshMap[pointScoreName] = pointScoreMesh;
+    addMeshToList(pointScoreMesh);
+    prototypes.Register(PrototypeKind::POINT_SCORE, 0, pointScoreMesh);
+
+    std::string pointScoreShapeName = pointScoreName + "Shape";
+    Mesh* pointScoreShape = ObjectsGame::CreatePointScoreShape(pointScoreShapeName,
+        20.0f, 30,                     // radius, segments
+        20.0f, 10.0f,                  // rayBigger, raySmaller
+        GYELLOW);                      // color
+    meshMap[pointScoreShapeName] = pointScoreShape;
+    addMeshToList(pointScoreShape);
+    prototypes.RegisterShape(PrototypeKind::POINT_SCORE, 0, pointScoreShape);
+}
+
+
+/// <summary>
+/// Initialize the meshes of the green squares for plants in a game grid.
+/// The cells themselves (position, occupied) belong to the GameSimulation.
+/// </summary>
+void GameInit::InitializeGreenSquaresForPlants()
 {
     for (int col = 0; col < GNUM_COLS; ++col)
     {
@@ -197,88 +304,6 @@ void GameInit::InitializeGreenSquaresForPlants(std::vector<GreenSquare>& squares
             Mesh* square = Objects2D::CreateSquare(squareName, Gcorner, GsideS, GGREEN);
             meshMap[squareName] = square;
             addMeshToList(square);
-
-            // Calculate the position of the square in 2D space
-            glm::vec3 squarePosition = glm::vec3(
-                Gcx + GsideS * (col + 1) + col * GspaceBetweenS,
-                Gcy + GsideS * row + GspaceBetweenS * (row + 1),
-                0.0f
-            );
-
-            // Create a GreenSquare object with relevant data
-            GreenSquare greenSquare(squareName, square,
-                squarePosition + glm::vec3(GsideS / 2, GsideS / 2, 0.0f),
-                false, GsideS, row, col);
-
-            // Set the row and column data for the GreenSquare
-            greenSquare.SetRow(row);
-            greenSquare.SetCol(col);
-
-            // Add the GreenSquare object to the vector
-            squares.push_back(greenSquare);
-        }
-    }
-}
-
-
-
-/// <summary>
-/// Initialize a grid of plants randomly distributed across the defined rows and columns.
-/// Plants are placed based on a 50% chance in each grid square. Each plant's position,
-/// type, and other attributes are calculated and assigned BASED ON RANDOM.
-/// </summary>
-/// <param name="plants">A reference to a vector of Plant objects to which the initialized plants will be added.</param>
-/// <param name="cx">The x-coordinate of the starting point of the grid.</param>
-/// <param name="cy">The y-coordinate of the starting point of the grid.</param>
-/// <param name="sideS">The side length of each square in the grid.</param>
-/// <param name="spaceBetweenS">The space between each square in the grid.</param>
-void GameInit::InitializeRandomGridPlants(
-    std::vector<Plant>& plants,
-    float cx, float cy,
-    float sideS, float spaceBetweenS)
-{
-    for (int col = 0; col < GNUM_COLS; ++col)
-    {
-        for (int row = 0; row < GNUM_ROWS; ++row)
-        {
-            // Randomly decide whether to place a plant in this square - 50% chance.
-            if (rand() % 2 == 0)
-            {
-                // Calculate the position for each square
-                glm::vec3 squarePosition = glm::vec3(
-                    cx + sideS * (col + 1) + col * spaceBetweenS,
-                    cy + sideS * row + spaceBetweenS * (row + 1),
-                    0.0f
-                );
-
-                // Calculate the center position for the plant in this square.
-                glm::vec3 plantPosition = squarePosition + glm::vec3(sideS / 2, sideS / 2, 0.0f);
-                // Corresponding index color and cost plant from the inventory.
-                int colorIndex = rand() % 8;
-                int costIndex = colorIndex;
-
-                // Randomly select color and type for this plant.
-                std::string plantType = "plant" + std::to_string(colorIndex);
-
-                // Create and add each plant mesh.
-                std::string plantName = plantType + "_" + std::to_string(col * GNUM_ROWS + row);
-
-                // Create plant mesh and add it to the list of meshes
-                Mesh* plantMesh = ObjectsGame::CreatePlant(plantName, GradiusPT,
-                    GnumTrianglesPT, GtriangleInnerLenPT, GtriangleOuterLenPT,
-                    Gcolors[colorIndex]);
-
-                addMeshToList(plantMesh);
-
-                // Create plant object and add it to the plants vector
-                Plant newPlant(plantMesh, plantName, plantPosition, Gcolors[colorIndex], GradiusPT,
-                    GnumTrianglesPT, GtriangleInnerLenPT, GtriangleOuterLenPT,
-                    row, col, GcostPlantsINV[costIndex]);
-
-                newPlant.SetPlaced(true);
-                newPlant.SetActive(true);
-                plants.push_back(newPlant);
-            }
         }
     }
 }
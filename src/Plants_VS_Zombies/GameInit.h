@@ -6,7 +6,8 @@
 #include "components/simple_scene.h"
 
 #include "Plants.h"
-#include "GreenSquares.h"
+#include "PrototypeMeshes.h"
+#include "NameTable.h"
 
 #include <unordered_map>
 
@@ -19,14 +20,15 @@ public:
 
     // Initialize at Init phase different parts of the game scene.
     void InitializeInventorySlots();                                                        // Initialize the inventory slots where items will be placed.
-    void InitializePlantsForInventory();                                                    // Initialize the plant objects for the inventory.
+    void InitializePlantsForInventory(std::vector<Plant>& inventoryPlants,                  // Initialize the plant objects for the inventory.
+                                      PrototypeMeshes& prototypes, NameTable& names);
     void InitializeSunsForInventory();                                                      // Initialize the sun cost plant objects for inventory.
     void InitializeHeartsForInventory();                                                    // Initialize the health/heart objects for inventory.
+    void InitializeShapesForInventory();                                                    // Initialize the SDF quads of the inventory suns and hearts.
     void InitializeBaseRectangle();                                                         // Initialize the base playing field rectangle.
+    void InitializePrototypeMeshes(PrototypeMeshes& prototypes);                            // Initialize the meshes shared by spawned zombies, projectiles and suns.
     //////////////////////////////////////////////////////////////////////////////////////////
-    void InitializeRandomGridPlants(std::vector<Plant>& plants,                             // Initialize the green squares where plants will be placed.
-                                    float cx, float cy, float sideS, float spaceBetweenS);
-    void InitializeGreenSquaresForPlants(std::vector<GreenSquare>& squares);                // Initialize the green squares where plants will be placed.
+    void InitializeGreenSquaresForPlants();                                                 // Initialize the green squares where plants will be placed.
     //////////////////////////////////////////////////////////////////////////////////////////
 
     static void PrintMeshNames();
@@ -0,0 +1,843 @@
+#include "GameSimulation.h"
+
+#include "GameConstants.h"
+#include "EntityKernels.h"
+#include "PrototypeMeshes.h"
+
+#include "core/jobs/job_system.h"
+#include "core/profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+
+namespace
+{
+    // Geometry of the spawned entities, same sizes as their prototype meshes
+    const float kProjectileLength = GlengthLongerSidePJ / 5;
+    const float kProjectileRotation = 30.0f;
+
+    // Below this many entities the lanes run on the calling thread, a job costs more than their work
+    const int kMinParallelEntities = 2048;
+    // Entities moved per job, a multiple of the widest kernel so each entity takes the
+    // same code path as in a single call over the whole store
+    const int kMoveGrain = 4096;
+}
+
+
+/// <summary>
+/// Create the simulation of an empty lawn, nothing happens before the first Step.
+/// </summary>
+/// <param name="config">Board size and seed of the run.</param>
+GameSimulation::GameSimulation(const SimulationConfig& config) :
+    config(config), stats(),
+    rows(config.rows > 0 ? config.rows : GNUM_ROWS), cols(config.cols > 0 ? config.cols : GNUM_COLS),
+    zombieRandom(config.seed, RandomStream::ZOMBIES), pointScoreRandom(config.seed, RandomStream::POINT_SCORES),
+    projectileRandom(config.seed, RandomStream::PROJECTILES), plantRandom(config.seed, RandomStream::PLANTS),
+    isRunning(true), livesLeft(GNumLives), pointScoreCounter(0),
+    zombieSpawnTimer(0.0f), pointScoreSpawnTimer(0.0f),
+    // Same corner as the red base drawn by the scene, shifted by half a square
+    baseCorner(Gcx + GsideS / 2, Gcy + GsideS / 2 + 1.5f * GsideS), baseHeight(GsideS * (rows + 1)),
+    zombies(config.maxZombies > 0 ? config.maxZombies : GetPoolCapacity(GMaxZombies, rows, cols)), plants(),
+    projectiles(config.maxProjectiles > 0 ? config.maxProjectiles : GetPoolCapacity(GMaxProjectiles, rows, cols)),
+    pointScores(config.maxPointScores > 0 ? config.maxPointScores : GetPoolCapacity(GMaxPointScores, rows, cols)),
+    squares(),
+    zombieLanes(rows, static_cast<int>(Gcolors.size())), names(), hitSlots(),
+    plantLanes(), projectileLanes(), laneResults(rows), shooters()
+{
+    InitializeGreenSquares();
+}
+GameSimulation::~GameSimulation() {}
+
+
+/// <summary>
+/// Restart the game from an empty lawn, the random streams keep their state.
+/// </summary>
+void GameSimulation::Reset()
+{
+    stats = SimulationStats();
+    isRunning = true;
+    livesLeft = GNumLives;
+    pointScoreCounter = 0;
+    zombieSpawnTimer = 0.0f;
+    pointScoreSpawnTimer = 0.0f;
+
+    zombies.Clear();
+    plants.clear();
+    projectiles.Clear();
+    pointScores.Clear();
+    zombieLanes.Clear();
+    for (auto& square : squares)
+    {
+        square.SetOccupied(false);
+    }
+}
+
+
+/// <summary>
+/// Build the free cells of the lawn, only their position and grid location are used here.
+/// The meshes of the squares are created by GameInit and drawn by the scene.
+/// </summary>
+void GameSimulation::InitializeGreenSquares()
+{
+    squares.clear();
+    for (int col = 0; col < cols; ++col)
+    {
+        for (int row = 0; row < rows; ++row)
+        {
+            std::string squareName = "square" + std::to_string(col * rows + row + 1);
+
+            // Same layout as GameInit::InitializeGreenSquaresForPlants
+            glm::vec2 squarePosition = glm::vec2(
+                Gcx + GsideS * (col + 1) + col * GspaceBetweenS,
+                Gcy + GsideS * row + GspaceBetweenS * (row + 1)
+            );
+
+            squares.emplace_back(squareName, nullptr,
+                squarePosition + glm::vec2(GsideS / 2, GsideS / 2),
+                false, GsideS, row, col);
+        }
+    }
+}
+
+
+/// <summary>
+/// Size of the board fitting a lawn of rows x cols squares, laid out as InitializeGreenSquares does,
+/// with four squares of room on the right for the zombies to walk in.
+/// </summary>
+/// <param name="rows">Rows of the lawn.</param>
+/// <param name="cols">Columns of the lawn.</param>
+/// <returns>The smallest board size, in pixels.</returns>
+glm::ivec2 GameSimulation::GetMinimumBoardSize(int rows, int cols)
+{
+    float right = Gcx + GsideS * (cols + 1) + (cols - 1) * GspaceBetweenS + 4 * (GsideS + GspaceBetweenS);
+    float top = Gcy + GsideS * rows + GspaceBetweenS * (rows + 1) + GsideS;
+    return glm::ivec2(static_cast<int>(std::ceil(right)), static_cast<int>(std::ceil(top)));
+}
+
+
+/// <summary>
+/// Scale the capacity of a pool to the size of the lawn: the plants fire the projectiles,
+/// and more rows spawn more zombies and more suns. Never below the capacity of the game lawn.
+/// </summary>
+/// <param name="gameCapacity">Capacity on the GNUM_ROWS x GNUM_COLS lawn of the game.</param>
+/// <param name="rows">Rows of the lawn.</param>
+/// <param name="cols">Columns of the lawn.</param>
+/// <returns>The capacity, rounded up.</returns>
+int GameSimulation::GetPoolCapacity(int gameCapacity, int rows, int cols)
+{
+    const long long gameSquares = static_cast<long long>(GNUM_ROWS) * GNUM_COLS;
+    long long capacity = (static_cast<long long>(gameCapacity) * rows * cols + gameSquares - 1) / gameSquares;
+    return static_cast<int>(std::max<long long>(gameCapacity, capacity));
+}
+
+
+/// <summary>
+/// Create a plant with the geometry and cost of an inventory slot.
+/// </summary>
+/// <param name="colorIndex">Index of the color (and of the inventory slot) inside Gcolors.</param>
+/// <param name="name">Interned debug name of the plant.</param>
+/// <param name="position">Position of the plant.</param>
+/// <returns>An active plant, not placed on the lawn.</returns>
+Plant GameSimulation::CreatePlant(int colorIndex, NameId name, const glm::vec2& position)
+{
+    Plant plant(PrototypeMeshes::GetHandle(PrototypeKind::PLANT, colorIndex), name,
+        glm::vec3(position, 0.0f), Gcolors[colorIndex], GradiusPT,
+        GnumTrianglesPT, GtriangleInnerLenPT, GtriangleOuterLenPT,
+        -1, -1, GcostPlantsINV[colorIndex]);
+
+    plant.SetPlaced(false);
+    plant.SetActive(true);
+    return plant;
+}
+
+
+/// <summary>
+/// Create the plants of the inventory slots, called once at Init phase.
+/// Each slot holds the plant of its color, dragged from there into the grid.
+/// </summary>
+/// <param name="inventoryPlants">The vector receiving the plants of the slots.</param>
+/// <param name="names">The table interning the debug names of the plants.</param>
+void GameSimulation::CreateInventory(std::vector<Plant>& inventoryPlants, NameTable& names)
+{
+    for (int i = 0; i < GslotsINV - 1; ++i)
+    {
+        int colorIndex = i % static_cast<int>(Gcolors.size());
+
+        // Compute the position within the inventory slot
+        float plantPosX = GstartXINV + i * (GslotWidthINV + GpaddingINV) + GslotWidthINV - GspaceBetweenS / 3;
+        float plantPosY = GstartYINV + GslotHeightINV / 2 + GspaceBetweenS / 2;
+
+        NameId inventorySlotName = names.Intern("inventorySlot" + std::to_string(i));
+        Plant plant = CreatePlant(colorIndex, inventorySlotName, glm::vec2(plantPosX, plantPosY));
+        plant.SetCost(GcostPlantsINV[i]);
+        inventoryPlants.push_back(plant);
+    }
+}
+
+
+/// <summary>
+/// Initialize a grid of plants randomly distributed across the defined rows and columns.
+/// Plants are placed based on a 50% chance in each grid square, with a random color.
+/// </summary>
+void GameSimulation::PlantRandomGrid()
+{
+    for (int col = 0; col < cols; ++col)
+    {
+        for (int row = 0; row < rows; ++row)
+        {
+            // Randomly decide whether to place a plant in this square - 50% chance.
+            if (plantRandom.NextInt(2) == 0)
+            {
+                PlantAt(row, col, plantRandom.NextInt(static_cast<int>(Gcolors.size())));
+            }
+        }
+    }
+}
+
+
+/// <summary>
+/// Place a plant on a square of the grid and mark the square as occupied.
+/// </summary>
+/// <param name="row">Row of the square.</param>
+/// <param name="col">Column of the square.</param>
+/// <param name="colorIndex">Index of the plant color inside Gcolors.</param>
+void GameSimulation::PlantAt(int row, int col, int colorIndex)
+{
+    GreenSquare& square = GetSquare(row, col);
+    NameId plantName = names.Intern("plant" + std::to_string(colorIndex) + "_" +
+                                    std::to_string(col * rows + row));
+
+    Plant newPlant = CreatePlant(colorIndex, plantName, square.GetCenterPosition());
+    newPlant.SetRow(row);
+    newPlant.SetColumn(col);
+    newPlant.SetPlaced(true);
+    plants.push_back(newPlant);
+
+    square.SetOccupied(true);
+}
+
+
+/// <summary>
+/// Spawn zombies on the right edge of a row, as the regular spawning does.
+/// </summary>
+/// <param name="row">Row of the zombies.</param>
+/// <param name="count">Number of zombies to spawn.</param>
+/// <returns>The number of zombies spawned, fewer when the pool is full.</returns>
+int GameSimulation::SpawnZombies(int row, int count)
+{
+    int zombiesBefore = zombies.GetSize();
+    for (int i = 0; i < count && zombies.GetSize() < zombies.GetCapacity(); ++i)
+    {
+        Zombie::SpawnZombieAtRow(row, config.boardSize, zombies, zombieRandom);
+    }
+
+    int spawned = zombies.GetSize() - zombiesBefore;
+    stats.zombiesSpawned += spawned;
+    return spawned;
+}
+
+
+/// <summary>
+/// Place a plant of random color on every free square of the lawn.
+/// </summary>
+/// <returns>The number of plants placed.</returns>
+int GameSimulation::PlantFullGrid()
+{
+    int planted = 0;
+    for (int col = 0; col < cols; ++col)
+    {
+        for (int row = 0; row < rows; ++row)
+        {
+            if (!GetSquare(row, col).IsOccupied())
+            {
+                PlantAt(row, col, plantRandom.NextInt(static_cast<int>(Gcolors.size())));
+                planted++;
+            }
+        }
+    }
+    return planted;
+}
+
+
+/// <summary>
+/// Spawn projectiles anywhere on the lawn, on a random row and with a random color,
+/// as if the plants had fired them.
+/// </summary>
+/// <param name="count">Number of projectiles to spawn.</param>
+/// <returns>The number of projectiles spawned, fewer when the pool is full.</returns>
+int GameSimulation::SpawnProjectiles(int count)
+{
+    // Stop at the capacity, the pool would report every refused spawn
+    int spawned = 0;
+    for (int i = 0; i < count && projectiles.GetSize() < projectiles.GetCapacity(); ++i)
+    {
+        int row = projectileRandom.NextInt(rows);
+        int colorIndex = projectileRandom.NextInt(static_cast<int>(Gcolors.size()));
+        float x = projectileRandom.NextFloat() * config.boardSize.x;
+        // Same height as the plants of the row
+        float y = GetSquare(row, 0).GetCenterPosition().y;
+
+        EntityHandle projectile = projectiles.Create(x, y, projectileRandom.Range(GMINSPEED, GMAXSPEED), colorIndex, row, 1);
+        projectiles.angle[projectiles.GetSlot(projectile)] = kProjectileRotation;
+        spawned++;
+    }
+
+    stats.projectilesFired += spawned;
+    return spawned;
+}
+
+
+/// <summary>
+/// Spawn suns at random positions of the board, as the regular spawning does.
+/// </summary>
+/// <param name="count">Number of suns to spawn.</param>
+/// <returns>The number of suns spawned, fewer when the pool is full.</returns>
+int GameSimulation::SpawnPointScores(int count)
+{
+    int spawned = 0;
+    for (int i = 0; i < count && pointScores.GetSize() < pointScores.GetCapacity(); ++i)
+    {
+        float x = pointScoreRandom.NextFloat() * config.boardSize.x;
+        float y = pointScoreRandom.NextFloat() * config.boardSize.y;
+
+        EntityHandle pointScore = pointScores.Create(x, y, 0.0f, 0, -1, 1);
+        pointScores.timer[pointScores.GetSlot(pointScore)] = GlifeSpanPST;
+        spawned++;
+    }
+    return spawned;
+}
+
+
+/// <summary>
+/// Decrease the player's lives by one and stop the game if the player has 0 lives.
+/// </summary>
+void GameSimulation::LoseLife()
+{
+    if (livesLeft > 0)
+    {
+        livesLeft--;
+        std::cout << "\t================================" << std::endl;
+        std::cout <<  "\t LIFE LOST. LIVES REMAINING:  "  << livesLeft << std::endl;
+        std::cout << "\t================================" << std::endl;
+    }
+
+    if (livesLeft == 0)
+    {
+        std::cout << "\t==========" << std::endl;
+        std::cout << "\tGAME OVER!" << std::endl;
+        std::cout << "\t==========" << std::endl;
+        isRunning = false;
+    }
+}
+
+
+/// <summary>
+/// Advance the game by one tick. The order matches the one of the rendered game:
+/// zombies move first, then the suns, the collisions, the shots and the projectiles.
+/// </summary>
+/// <param name="deltaTime">Time simulated by this tick, in seconds.</param>
+void GameSimulation::Step(float deltaTime)
+{
+    if (!isRunning)
+    {
+        return;
+    }
+    stats.ticks++;
+    PROFILE_ZONE("Simulation");
+
+    /// POSITIONS BEFORE THE TICK, THE RENDERER INTERPOLATES FROM THEM
+    SavePreviousPositions();
+
+    /// RANDOMLY DECIDE WHEN A ZOMBIE SHOULD BE SPAWNED
+    {
+        PROFILE_ZONE("Zombies");
+        int zombiesBefore = zombies.GetSize();
+        Zombie::SpawnRandomZombies(zombieSpawnTimer, deltaTime, config.boardSize, rows, zombies, zombieRandom);
+        stats.zombiesSpawned += zombies.GetSize() - zombiesBefore;
+
+        /// ALL ACTIVE ZOMBIES MOVE THEM AND CHECK FOR THE BASE
+        UpdateZombies(deltaTime);
+        /// BUCKET THE ZOMBIES BY ROW, SORTED BY X, FOR THE COLLISION QUERIES
+        Zombie::BuildLaneIndex(zombies, zombieLanes);
+    }
+
+    /// SPAWN NEW POINTSCORES IF NEEDED, EXPIRE THE OLD ONES
+    {
+        PROFILE_ZONE("PointScores");
+        PointScore::SpawnPointScores(pointScoreSpawnTimer, deltaTime,
+            static_cast<float>(config.boardSize.x), static_cast<float>(config.boardSize.y), pointScores, pointScoreRandom);
+        UpdatePointScores(deltaTime);
+    }
+
+    /// EVERY LANE IN PARALLEL: PLANTS + ZOMBIES, PROJECTILES + ZOMBIES, PLANTS READY TO SHOOT
+    {
+        PROFILE_ZONE("Lanes");
+        UpdateLanes(deltaTime);
+    }
+
+    /// PLANTS SHOOT THE ZOMBIES OF THEIR COLOR, PROJECTILES FLY
+    {
+        PROFILE_ZONE("Projectiles");
+        FirePlantProjectiles();
+        UpdateProjectiles(deltaTime);
+    }
+
+    /// SHRINK THE DESTROYED ZOMBIES AND PLANTS, THEN FORGET THEM
+    {
+        PROFILE_ZONE("Disappearances");
+        AnimateDisappearances(deltaTime);
+        RemoveFinishedEntities();
+    }
+}
+
+
+/// <summary>
+/// Copy the positions of the moving entities before they move, the renderer draws them
+/// between their previous and current positions when the frame falls between two ticks.
+/// </summary>
+void GameSimulation::SavePreviousPositions()
+{
+    std::copy(zombies.x.begin(), zombies.x.end(), zombies.prevX.begin());
+    std::copy(projectiles.x.begin(), projectiles.x.end(), projectiles.prevX.begin());
+}
+
+
+/// <summary>
+/// Move the active zombies, the ones reaching the base take a life and are removed.
+/// The zombies leaving the screen on the left are deactivated and fade out.
+/// </summary>
+/// <param name="deltaTime">Time elapsed since the last tick.</param>
+void GameSimulation::UpdateZombies(float deltaTime)
+{
+    // Move the zombies leftward, deactivate the ones moving off-screen. Each zombie
+    // moves on its own, large stores are moved by chunks in parallel
+    JobSystem::ParallelFor(0, zombies.GetSize(), kMoveGrain, [this, deltaTime](int first, int last)
+    {
+        EntityKernels::MoveLeft(zombies.x.data() + first, zombies.speed.data() + first, zombies.active.data() + first,
+                                last - first, deltaTime);
+    });
+
+    hitSlots.resize(zombies.GetSize());
+    int numHits = EntityKernels::IntersectRectangle(zombies.x.data(), zombies.y.data(), zombies.active.data(),
+        zombies.GetSize(), GoutterRadiusZ, baseCorner, GwidthR, baseHeight, hitSlots.data());
+
+    // The slots are ascending, removing the last one first only moves zombies that were not hit
+    for (int i = numHits - 1; i >= 0; --i)
+    {
+        LoseLife();
+        zombies.DestroyAt(hitSlots[i]);
+    }
+}
+
+/// <summary>
+/// Consume the lifespan of the suns on the lawn, the expired ones are deactivated.
+/// </summary>
+/// <param name="deltaTime">Time elapsed since the last tick.</param>
+void GameSimulation::UpdatePointScores(float deltaTime)
+{
+    for (int i = 0; i < pointScores.GetSize(); ++i)
+    {
+        pointScores.timer[i] -= deltaTime;
+        if (pointScores.timer[i] <= 0.0f)
+        {
+            pointScores.active[i] = 0;
+        }
+    }
+}
+
+
+/// <summary>
+/// Run the collisions and find the plants ready to shoot, lane by lane. A lane only reads and
+/// writes the plants, zombies and projectiles of its row, so the lanes run in parallel; their
+/// counters are then merged in row order and the shots are fired by FirePlantProjectiles.
+/// Each lane visits its entities in the order of a single pass over the whole board,
+/// the result is the same whatever the number of threads.
+/// </summary>
+/// <param name="deltaTime">Time elapsed since the last tick.</param>
+void GameSimulation::UpdateLanes(float deltaTime)
+{
+    plantLanes.Build(static_cast<int>(plants.size()), rows,
+        [this](int i) { return plants[i].GetRow(); });
+    projectileLanes.Build(projectiles.GetSize(), rows,
+        [this](int i) { return projectiles.active[i] ? projectiles.row[i] : -1; });
+
+    int entities = static_cast<int>(plants.size()) + projectiles.GetSize() + zombies.GetSize();
+    int grain = entities < kMinParallelEntities ? rows : 1;
+    JobSystem::ParallelFor(0, rows, grain, [this, deltaTime](int first, int last)
+    {
+        for (int row = first; row < last; ++row)
+        {
+            LaneResult& lane = laneResults[row];
+            lane.plantsLost = 0;
+            lane.zombiesKilled = 0;
+            lane.shooters.clear();
+
+            HandlePlantZombieCollisions(row, lane);
+            HandleProjectileZombieCollisions(row, lane);
+            FindShooters(row, deltaTime, lane);
+        }
+    });
+
+    for (const auto& lane : laneResults)
+    {
+        stats.plantsLost += lane.plantsLost;
+        stats.zombiesKilled += lane.zombiesKilled;
+    }
+}
+
+
+/// <summary>
+/// An active plant touched by an active zombie of its row is destroyed.
+/// Only the zombies of the plant row close to it are tested, found with the lane index.
+/// </summary>
+/// <param name="row">Lane of the plants.</param>
+/// <param name="lane">Counters of the lane.</param>
+void GameSimulation::HandlePlantZombieCollisions(int row, LaneResult& lane)
+{
+    for (int p = plantLanes.starts[row]; p < plantLanes.starts[row + 1]; ++p)
+    {
+        Plant& plant = plants[plantLanes.items[p]];
+        if (!plant.IsActive())
+        {
+            continue;
+        }
+
+        // Widest horizontal distance at which a zombie can still touch the plant
+        float reach = GoutterRadiusZ + plant.GetLength();
+        float plantX = plant.GetPosition().x;
+
+        LaneIndex::Range nearby = zombieLanes.Query(row, plantX - reach, plantX + reach);
+        for (const LaneIndex::Entry* entry = nearby.first; entry != nearby.last; ++entry)
+        {
+            int zombie = entry->index;
+            glm::vec2 position(zombies.x[zombie], zombies.y[zombie]);
+            if (zombies.active[zombie] &&
+                Zombie::IsOverlapping(position, GoutterRadiusZ, plant.GetPosition(), plant.GetLength()))
+            {
+                plant.SetActive(false);
+                plant.SetPlaced(false);
+                lane.plantsLost++;
+                break;
+            }
+        }
+    }
+}
+
+
+/// <summary>
+/// A projectile hitting a zombie of its color is consumed, the zombie is destroyed after three hits.
+/// Only the zombies of the projectile color on its row are tested, found with the lane index.
+/// </summary>
+/// <param name="row">Lane of the projectiles.</param>
+/// <param name="lane">Counters of the lane.</param>
+void GameSimulation::HandleProjectileZombieCollisions(int row, LaneResult& lane)
+{
+    // Widest horizontal distance at which a projectile can still touch a zombie
+    const float reach = GoutterRadiusZ + kProjectileLength;
+
+    for (int p = projectileLanes.starts[row]; p < projectileLanes.starts[row + 1]; ++p)
+    {
+        int i = projectileLanes.items[p];
+        glm::vec2 projectile(projectiles.x[i], projectiles.y[i]);
+        LaneIndex::Range nearby = zombieLanes.Query(row, projectiles.colorId[i],
+                                                    projectile.x - reach, projectile.x + reach);
+        for (const LaneIndex::Entry* entry = nearby.first; entry != nearby.last; ++entry)
+        {
+            int zombie = entry->index;
+            glm::vec2 position(zombies.x[zombie], zombies.y[zombie]);
+            if (zombies.active[zombie] &&
+                Zombie::IsOverlapping(position, GoutterRadiusZ, projectile, kProjectileLength))
+            {
+                // Zombie hit, destroyed after three hits
+                projectiles.active[i] = 0;
+                if (--zombies.hp[zombie] <= 0)
+                {
+                    zombies.active[zombie] = 0;
+                    lane.zombiesKilled++;
+                }
+                break;
+            }
+        }
+    }
+}
+
+
+/// <summary>
+/// Placed plants are ready to shoot when their cooldown is over and an active zombie of their color
+/// walks on their row, in front of them. The shots are fired once the lanes are merged.
+/// </summary>
+/// <param name="row">Lane of the plants.</param>
+/// <param name="deltaTime">Time elapsed since the last tick.</param>
+/// <param name="lane">Plants ready to shoot of the lane.</param>
+void GameSimulation::FindShooters(int row, float deltaTime, LaneResult& lane)
+{
+    for (int p = plantLanes.starts[row]; p < plantLanes.starts[row + 1]; ++p)
+    {
+        int index = plantLanes.items[p];
+        Plant& plant = plants[index];
+        if (!plant.IsActive() || !plant.IsPlaced())
+        {
+            continue;
+        }
+
+        plant.UpdateShootTimer(deltaTime);
+        if (!plant.CanShoot())
+        {
+            continue;
+        }
+
+        // The lanes are built before the collisions, skip the zombies destroyed this tick
+        int colorIndex = PrototypeMeshes::GetColorIndex(plant.GetPrototype());
+        LaneIndex::Range ahead = zombieLanes.Query(row, colorIndex, plant.GetPosition().x,
+                                                   std::numeric_limits<float>::max());
+        const LaneIndex::Entry* entry = ahead.first;
+        while (entry != ahead.last && !zombies.active[entry->index])
+        {
+            ++entry;
+        }
+        if (entry == ahead.last)
+        {
+            continue;
+        }
+        lane.shooters.push_back(index);
+    }
+}
+
+
+/// <summary>
+/// Fire the shots of every lane in plant order, the projectile speeds are drawn
+/// from a single stream so the order does not depend on the threads.
+/// </summary>
+void GameSimulation::FirePlantProjectiles()
+{
+    shooters.clear();
+    for (const auto& lane : laneResults)
+    {
+        shooters.insert(shooters.end(), lane.shooters.begin(), lane.shooters.end());
+    }
+    std::sort(shooters.begin(), shooters.end());
+
+    for (int index : shooters)
+    {
+        Plant& plant = plants[index];
+        int colorIndex = PrototypeMeshes::GetColorIndex(plant.GetPrototype());
+
+        // Projectiles of the plant color share the mesh built at Init phase
+        EntityHandle projectile = projectiles.Create(plant.GetPosition().x, plant.GetPosition().y,
+                                                     projectileRandom.Range(GMINSPEED, GMAXSPEED), colorIndex, plant.GetRow(), 1);
+        if (projectile == INVALID_ENTITY)
+        {
+            continue;
+        }
+        projectiles.angle[projectiles.GetSlot(projectile)] = kProjectileRotation;
+        stats.projectilesFired++;
+
+        plant.ResetShootTimer();
+    }
+}
+
+
+/// <summary>
+/// Move the active projectiles, the ones leaving the board are deactivated.
+/// </summary>
+/// <param name="deltaTime">Time elapsed since the last tick.</param>
+void GameSimulation::UpdateProjectiles(float deltaTime)
+{
+    // Make the projectiles move on OX (velocity * time) and rotate, by chunks in parallel
+    JobSystem::ParallelFor(0, projectiles.GetSize(), kMoveGrain, [this, deltaTime](int first, int last)
+    {
+        EntityKernels::MoveRightAndSpin(projectiles.x.data() + first, projectiles.y.data() + first,
+            projectiles.speed.data() + first, projectiles.angle.data() + first, projectiles.active.data() + first,
+            last - first, deltaTime, 5 * deltaTime,
+            static_cast<float>(config.boardSize.x), static_cast<float>(config.boardSize.y));
+    });
+}
+
+/// <summary>
+/// Scale down the destroyed zombies and plants until they vanish.
+/// </summary>
+/// <param name="deltaTime">Time elapsed since the last tick.</param>
+void GameSimulation::AnimateDisappearances(float deltaTime)
+{
+    for (int i = 0; i < zombies.GetSize(); ++i)
+    {
+        if (!zombies.active[i] && zombies.scale[i] > 0.0f)
+        {
+            zombies.scale[i] = std::max(zombies.scale[i] - GfadeOutSpeedZ * deltaTime, 0.0f);
+        }
+    }
+
+    for (auto& plant : plants)
+    {
+        if (!plant.IsActive() && plant.GetScale() > 0.0f)
+        {
+            plant.SetScale(std::max(plant.GetScale() - GfadeOutSpeedP * deltaTime, 0.0f));
+        }
+    }
+}
+
+
+/// <summary>
+/// Erase the entities that will never be drawn again, the squares of the vanished plants are freed.
+/// </summary>
+void GameSimulation::RemoveFinishedEntities()
+{
+    // Swap and pop, walking backwards so the entity moved into a slot was already visited
+    for (int i = zombies.GetSize() - 1; i >= 0; --i)
+    {
+        if (!zombies.active[i] && zombies.scale[i] <= 0.0f)
+        {
+            zombies.DestroyAt(i);
+        }
+    }
+
+    for (const auto& plant : plants)
+    {
+        if (!plant.IsActive() && plant.GetScale() <= 0.0f)
+        {
+            GetSquare(plant.GetRow(), plant.GetColumn()).SetOccupied(false);
+        }
+    }
+    plants.erase(std::remove_if(plants.begin(), plants.end(),
+        [](const Plant& plant) { return !plant.IsActive() && plant.GetScale() <= 0.0f; }),
+        plants.end());
+
+    for (int i = projectiles.GetSize() - 1; i >= 0; --i)
+    {
+        if (!projectiles.active[i])
+        {
+            projectiles.DestroyAt(i);
+        }
+    }
+
+    for (int i = pointScores.GetSize() - 1; i >= 0; --i)
+    {
+        if (!pointScores.active[i])
+        {
+            pointScores.DestroyAt(i);
+        }
+    }
+}
+
+
+/// <summary>
+/// Collect the suns under the given position, each one adds a point.
+/// </summary>
+/// <param name="position">World position of the click.</param>
+/// <returns>The number of suns collected.</returns>
+int GameSimulation::CollectPointScoresAt(const glm::vec2& position)
+{
+    hitSlots.resize(pointScores.GetSize());
+    int collected = EntityKernels::MouseOver(pointScores.x.data(), pointScores.y.data(), pointScores.active.data(),
+        pointScores.GetSize(), GradiusPST, position.x, position.y, hitSlots.data());
+    for (int i = 0; i < collected; ++i)
+    {
+        pointScores.active[hitSlots[i]] = 0;
+    }
+
+    pointScoreCounter += collected;
+    stats.pointScoresCollected += collected;
+    return collected;
+}
+
+
+/// <summary>
+/// Place a copy of the plant on the free square whose center is close to the position,
+/// if the player has enough points to buy it.
+/// </summary>
+/// <param name="plant">The plant to place, usually dragged from the inventory.</param>
+/// <param name="position">World position where the plant is dropped.</param>
+/// <returns>True if the plant was placed and paid for.</returns>
+bool GameSimulation::PlacePlant(const Plant& plant, const glm::vec2& position)
+{
+    if (pointScoreCounter < plant.GetCost())
+    {
+        return false;
+    }
+
+    for (auto& square : squares)
+    {
+        float distance = glm::distance(position, square.GetCenterPosition());
+        if (!square.IsOccupied() && distance < DROP_TOLL)
+        {
+            Plant newPlant = plant;
+            newPlant.SetPosition(square.GetCenterPosition());
+            newPlant.SetRow(square.GetRow());
+            newPlant.SetColumn(square.GetCol());
+            newPlant.ResetShootTimer();
+            newPlant.SetActive(true);
+            newPlant.SetPlaced(true);
+            plants.push_back(newPlant);
+
+            square.SetOccupied(true);
+            pointScoreCounter -= plant.GetCost();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/// <summary>
+/// Remove the plants under the given position and free their squares.
+/// </summary>
+/// <param name="position">World position of the click.</param>
+/// <returns>True if at least a plant was removed.</returns>
+bool GameSimulation::RemovePlantAt(const glm::vec2& position)
+{
+    bool removed = false;
+    for (auto it = plants.begin(); it != plants.end();)
+    {
+        if (it->IsMouseOver(position.x, position.y))
+        {
+            std::cout << "PLANT CLICKED: " << names.GetName(it->GetName()) << std::endl;
+            GetSquare(it->GetRow(), it->GetColumn()).SetOccupied(false);
+            it = plants.erase(it);
+            removed = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+
+// Getter for the square at the grid location.
+GreenSquare& GameSimulation::GetSquare(int row, int col) { return squares[col * rows + row]; }
+
+
+// Getters & Setters for the simulation state.
+
+// Getter for the zombies, active or fading out.
+const EntityStore&              GameSimulation::GetZombies() const          { return zombies; }
+// Getter for the plants on the lawn, active or fading out.
+const std::vector<Plant>&       GameSimulation::GetPlants() const           { return plants; }
+// Getter for the projectiles in flight.
+const EntityStore&              GameSimulation::GetProjectiles() const      { return projectiles; }
+// Getter for the suns waiting to be collected.
+const EntityStore&              GameSimulation::GetPointScores() const      { return pointScores; }
+// Getter for the cells of the lawn.
+const std::vector<GreenSquare>& GameSimulation::GetSquares() const          { return squares; }
+// Getter for the counters of the run.
+const SimulationStats&          GameSimulation::GetStats() const            { return stats; }
+// Getter for the debug names of the plants.
+NameTable&                      GameSimulation::GetNames()                  { return names; }
+// Getter for the number of rows of the lawn.
+int                             GameSimulation::GetRows() const             { return rows; }
+// Getter for the number of columns of the lawn.
+int                             GameSimulation::GetCols() const             { return cols; }
+// Getter for the number of lives left.
+int                             GameSimulation::GetLivesLeft() const        { return livesLeft; }
+// Getter for the number of points the player can spend.
+int                             GameSimulation::GetPointScoreCounter() const { return pointScoreCounter; }
+// Check if the game is not over yet.
+bool                            GameSimulation::IsRunning() const           { return isRunning; }
+// Setter for the board size, follows the window resolution.
+void                            GameSimulation::SetBoardSize(const glm::ivec2& size) { config.boardSize = size; }
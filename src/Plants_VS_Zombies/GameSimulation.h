@@ -0,0 +1,204 @@
+#pragma once
+
+#ifndef GAME_SIMULATION_H
+#define GAME_SIMULATION_H
+
+#include <glm/glm.hpp>
+
+#include "Zombies.h"
+#include "Plants.h"
+#include "Projectiles.h"
+#include "PointScore.h"
+#include "GreenSquares.h"
+#include "LaneIndex.h"
+#include "EntityStore.h"
+#include "NameTable.h"
+#include "Random.h"
+
+#include <string>
+#include <vector>
+
+
+// Parameters of a simulation run.
+struct SimulationConfig
+{
+    glm::ivec2 boardSize;     // Zombies spawn on the right edge, projectiles leave on it
+    unsigned int seed;        // Seed of every random stream, with the same inputs it fully determines a run
+    int maxZombies;           // Capacity of the entity pools, 0 scales GMaxZombies, GMaxProjectiles and
+    int maxProjectiles;       // GMaxPointScores to the lawn, see GetPoolCapacity. Raised by the stress benchmark
+    int maxPointScores;
+    int rows;                 // Size of the lawn, 0 keeps GNUM_ROWS and GNUM_COLS. The board
+    int cols;                 // size must fit it, see GetMinimumBoardSize
+};
+
+// Counters accumulated since the last Reset.
+struct SimulationStats
+{
+    unsigned long long ticks;
+    int zombiesSpawned;
+    int zombiesKilled;
+    int projectilesFired;
+    int plantsLost;
+    int pointScoresCollected;
+};
+
+
+// Items of a tick grouped by row, stable: row r holds items[starts[r]] to items[starts[r + 1] - 1]
+// in the order they were given.
+struct RowBuckets
+{
+    std::vector<int> starts;
+    std::vector<int> items;
+
+    // Counting sort of the items [0, count), rowOf returns the row of an item, -1 to leave it out.
+    template <typename RowOf>
+    void Build(int count, int numRows, RowOf rowOf)
+    {
+        starts.assign(numRows + 2, 0);
+        for (int i = 0; i < count; ++i)
+        {
+            int row = rowOf(i);
+            if (row >= 0 && row < numRows) starts[row + 2]++;
+        }
+        for (int row = 0; row < numRows; ++row)
+        {
+            starts[row + 2] += starts[row + 1];
+        }
+
+        // starts[row + 1] is the next free place of the row while filling
+        items.resize(starts[numRows + 1]);
+        for (int i = 0; i < count; ++i)
+        {
+            int row = rowOf(i);
+            if (row >= 0 && row < numRows) items[starts[row + 1]++] = i;
+        }
+        starts.pop_back();
+    }
+};
+
+// Results of a lane during a tick, merged in row order once every lane is done.
+struct LaneResult
+{
+    int plantsLost;
+    int zombiesKilled;
+    std::vector<int> shooters;    // Plants ready to fire, in plant order
+};
+
+
+// Game rules of Plants VS Zombies without any OpenGL call: spawning, movement,
+// collisions, shooting and scoring. The scene renders its state after each Step,
+// the headless driver steps it as fast as the CPU allows.
+// Zombies, projectiles and suns are stored as columns (EntityStore), plants as objects.
+// The entities only meet the ones of their row: the collisions and the shots of each lane
+// run in parallel on the JobSystem workers, then the lanes are merged in row order, so the
+// run does not depend on the number of threads.
+class GameSimulation
+{
+public:
+    explicit GameSimulation(const SimulationConfig& config);
+    ~GameSimulation();
+
+    // Restart the game: empty lawn, full lives, no points.
+    void Reset();
+    // Place a plant of random color on about half of the squares.
+    void PlantRandomGrid();
+    // Advance the game by deltaTime seconds.
+    void Step(float deltaTime);
+
+    // Load of the stress scenarios, on top of the regular spawning. Each one returns the
+    // number of entities created, fewer when the pool is full.
+    // Zombies entering on the right edge of a row.
+    int SpawnZombies(int row, int count);
+    // Plant of random color on every free square.
+    int PlantFullGrid();
+    // Projectiles of random row and color anywhere on the board, flying right.
+    int SpawnProjectiles(int count);
+    // Suns at random positions, with their full lifespan.
+    int SpawnPointScores(int count);
+
+    // Player commands, the positions are in world coordinates.
+    int CollectPointScoresAt(const glm::vec2& position);
+    bool PlacePlant(const Plant& plant, const glm::vec2& position);
+    bool RemovePlantAt(const glm::vec2& position);
+
+    // Smallest board holding a lawn of rows x cols squares, with room for the zombies to walk.
+    static glm::ivec2 GetMinimumBoardSize(int rows, int cols);
+    // Capacity of a pool on a lawn of rows x cols squares, from its capacity on the game lawn.
+    static int GetPoolCapacity(int gameCapacity, int rows, int cols);
+
+    // Plant of the inventory slot colorIndex, not placed on the lawn yet.
+    static Plant CreatePlant(int colorIndex, NameId name, const glm::vec2& position);
+    // Plants of the inventory slots, created once: the scene only draws them, the player drags copies.
+    static void CreateInventory(std::vector<Plant>& inventoryPlants, NameTable& names);
+    // Debug names of the plants, interned once and copied as ids.
+    NameTable& GetNames();
+
+    // Getters read by the renderer.
+    const EntityStore& GetZombies() const;
+    const std::vector<Plant>& GetPlants() const;
+    const EntityStore& GetProjectiles() const;
+    const EntityStore& GetPointScores() const;
+    const std::vector<GreenSquare>& GetSquares() const;
+    const SimulationStats& GetStats() const;
+
+    int GetRows() const;
+    int GetCols() const;
+    int GetLivesLeft() const;
+    int GetPointScoreCounter() const;
+    bool IsRunning() const;
+
+    void SetBoardSize(const glm::ivec2& newBoardSize);
+
+private:
+    void InitializeGreenSquares();
+    GreenSquare& GetSquare(int row, int col);
+    void PlantAt(int row, int col, int colorIndex);
+
+    void SavePreviousPositions();
+    void LoseLife();
+    void UpdateZombies(float deltaTime);
+    void UpdatePointScores(float deltaTime);
+    void UpdateLanes(float deltaTime);
+    void HandlePlantZombieCollisions(int row, LaneResult& lane);
+    void HandleProjectileZombieCollisions(int row, LaneResult& lane);
+    void FindShooters(int row, float deltaTime, LaneResult& lane);
+    void FirePlantProjectiles();
+    void UpdateProjectiles(float deltaTime);
+    void AnimateDisappearances(float deltaTime);
+    void RemoveFinishedEntities();
+
+private:
+    SimulationConfig config;
+    SimulationStats stats;
+    int rows;
+    int cols;
+
+    Random zombieRandom;                            // Spawned zombies
+    Random pointScoreRandom;                        // Spawned suns
+    Random projectileRandom;                        // Projectile speeds
+    Random plantRandom;                             // Starting lawn
+
+    bool isRunning;
+    int livesLeft;
+    int pointScoreCounter;
+
+    float zombieSpawnTimer;
+    float pointScoreSpawnTimer;
+    glm::vec2 baseCorner;                           // Bottom-left corner of the red base
+    float baseHeight;                               // The base covers every row
+
+    EntityStore zombies;                            // hp: hits left, scale: fade out
+    std::vector<Plant> plants;
+    EntityStore projectiles;                        // angle: spin of the star
+    EntityStore pointScores;                        // timer: lifespan left
+    std::vector<GreenSquare> squares;               // Indexed by col * GNUM_ROWS + row
+    LaneIndex zombieLanes;                          // Active zombies by row and color, rebuilt after they move
+    NameTable names;                                // Debug names of the plants
+    std::vector<int> hitSlots;                      // Slots found by the batched tests of EntityKernels
+    RowBuckets plantLanes;                          // Plants by row, rebuilt each tick
+    RowBuckets projectileLanes;                     // Active projectiles by row, rebuilt each tick
+    std::vector<LaneResult> laneResults;            // One per row
+    std::vector<int> shooters;                      // Plants firing this tick, all lanes merged
+};
+
+#endif // GAME_SIMULATION_H
@@ -0,0 +1,142 @@
+#include "LaneIndex.h"
+
+#include <algorithm>
+
+
+namespace
+{
+    // Order the entries of a lane from left to right.
+    bool CompareEntryX(const LaneIndex::Entry& a, const LaneIndex::Entry& b) { return a.x < b.x; }
+    bool CompareEntryToX(const LaneIndex::Entry& entry, float x) { return entry.x < x; }
+    bool CompareXToEntry(float x, const LaneIndex::Entry& entry) { return x < entry.x; }
+}
+
+
+/// <summary>
+/// Create an empty index with a lane for each row and one for each (row, color) pair.
+/// </summary>
+/// <param name="numRows">Number of rows of the lawn grid.</param>
+/// <param name="numColors">Number of colors in the palette.</param>
+LaneIndex::LaneIndex(int numRows, int numColors) :
+    numRows(numRows), numColors(numColors), size(0),
+    rowLanes(numRows), colorLanes(numRows * numColors)
+    { /* Constructor allocates the empty lanes */ }
+LaneIndex::~LaneIndex() {}
+
+
+/// <summary>
+/// Remove every entry of the index, the lanes keep their capacity for the next frame.
+/// </summary>
+void LaneIndex::Clear()
+{
+    for (auto& lane : rowLanes) lane.clear();
+    for (auto& lane : colorLanes) lane.clear();
+    size = 0;
+}
+
+
+/// <summary>
+/// Register an entity in the lane of its row and in the lane of its row and color.
+/// Entities outside the grid or with an unknown color are ignored.
+/// </summary>
+/// <param name="row">Row of the entity.</param>
+/// <param name="colorIndex">Index of the entity color inside Gcolors.</param>
+/// <param name="x">Horizontal position of the entity.</param>
+/// <param name="index">Index of the entity inside its container.</param>
+void LaneIndex::Insert(int row, int colorIndex, float x, int index)
+{
+    if (row < 0 || row >= numRows)
+    {
+        return;
+    }
+
+    Entry entry = { x, index, colorIndex };
+    rowLanes[row].push_back(entry);
+    if (colorIndex >= 0 && colorIndex < numColors)
+    {
+        colorLanes[row * numColors + colorIndex].push_back(entry);
+    }
+    size++;
+}
+
+
+/// <summary>
+/// Sort each lane by x, O(n log n) once per frame instead of a scan per query.
+/// </summary>
+void LaneIndex::Build()
+{
+    for (auto& lane : rowLanes) std::sort(lane.begin(), lane.end(), CompareEntryX);
+    for (auto& lane : colorLanes) std::sort(lane.begin(), lane.end(), CompareEntryX);
+}
+
+
+/// <summary>
+/// Find the entries of a row lying strictly between minX and maxX, any color.
+/// </summary>
+/// <param name="row">Row to search in.</param>
+/// <param name="minX">Left bound of the interval.</param>
+/// <param name="maxX">Right bound of the interval.</param>
+/// <returns>The sorted run of entries, empty if none is inside the interval.</returns>
+LaneIndex::Range LaneIndex::Query(int row, float minX, float maxX) const
+{
+    const std::vector<Entry>* lane = GetLane(row);
+    if (!lane)
+    {
+        Range empty = { nullptr, nullptr };
+        return empty;
+    }
+    return Slice(*lane, minX, maxX);
+}
+
+
+/// <summary>
+/// Find the entries of a row and color lying strictly between minX and maxX.
+/// </summary>
+/// <param name="row">Row to search in.</param>
+/// <param name="colorIndex">Index of the color inside Gcolors.</param>
+/// <param name="minX">Left bound of the interval.</param>
+/// <param name="maxX">Right bound of the interval.</param>
+/// <returns>The sorted run of entries, empty if none is inside the interval.</returns>
+LaneIndex::Range LaneIndex::Query(int row, int colorIndex, float minX, float maxX) const
+{
+    const std::vector<Entry>* lane = GetLane(row, colorIndex);
+    if (!lane)
+    {
+        Range empty = { nullptr, nullptr };
+        return empty;
+    }
+    return Slice(*lane, minX, maxX);
+}
+
+
+// Getter for the lane of a row, nullptr outside the grid.
+const std::vector<LaneIndex::Entry>* LaneIndex::GetLane(int row) const
+{
+    if (row < 0 || row >= numRows) return nullptr;
+    return &rowLanes[row];
+}
+
+
+// Getter for the lane of a row and color, nullptr outside the grid or palette.
+const std::vector<LaneIndex::Entry>* LaneIndex::GetLane(int row, int colorIndex) const
+{
+    if (row < 0 || row >= numRows || colorIndex < 0 || colorIndex >= numColors) return nullptr;
+    return &colorLanes[row * numColors + colorIndex];
+}
+
+
+// Binary search the open interval (minX, maxX) inside a sorted lane.
+LaneIndex::Range LaneIndex::Slice(const std::vector<Entry>& lane, float minX, float maxX)
+{
+    auto first = std::upper_bound(lane.begin(), lane.end(), minX, CompareXToEntry);
+    auto last = std::lower_bound(first, lane.end(), maxX, CompareEntryToX);
+
+    Range range = { lane.data() + (first - lane.begin()), lane.data() + (last - lane.begin()) };
+    return range;
+}
+
+
+// Getter for the number of rows of the index.
+int             LaneIndex::GetNumRows() const           { return numRows; }
+// Getter for the number of entries registered since the last Clear.
+int             LaneIndex::GetSize() const              { return size; }
@@ -0,0 +1,62 @@
+#pragma once
+
+#ifndef LANE_INDEX_H
+#define LANE_INDEX_H
+
+#include <vector>
+
+
+// Spatial index of the lawn lanes: entities are bucketed by row (and by row and color),
+// each bucket sorted by x, so the collision queries are binary searches inside one lane.
+class LaneIndex
+{
+public:
+    struct Entry
+    {
+        float x;          // Horizontal position, the sort key inside a lane
+        int index;        // Index of the entity inside the vector it was registered from
+        int colorIndex;   // Index of the entity color inside Gcolors
+    };
+
+    // Contiguous run of entries of a lane, sorted by x: [first, last).
+    struct Range
+    {
+        const Entry* first;
+        const Entry* last;
+
+        bool Empty() const { return first == last; }
+    };
+
+    LaneIndex(int numRows, int numColors);
+    ~LaneIndex();
+
+    // Remove every entry, keeping the memory of the buckets.
+    void Clear();
+    // Register an entity in its lane, Build must be called before querying.
+    void Insert(int row, int colorIndex, float x, int index);
+    // Sort every lane by x.
+    void Build();
+
+    // Entries of the row with minX < x < maxX, of any color.
+    Range Query(int row, float minX, float maxX) const;
+    // Entries of the row and color with minX < x < maxX.
+    Range Query(int row, int colorIndex, float minX, float maxX) const;
+
+    int GetNumRows() const;
+    int GetSize() const;
+
+private:
+    const std::vector<Entry>* GetLane(int row) const;
+    const std::vector<Entry>* GetLane(int row, int colorIndex) const;
+    static Range Slice(const std::vector<Entry>& lane, float minX, float maxX);
+
+private:
+    int numRows;
+    int numColors;
+    int size;
+
+    std::vector<std::vector<Entry>> rowLanes;      // One lane per row, all colors
+    std::vector<std::vector<Entry>> colorLanes;    // One lane per (row, color): row * numColors + color
+};
+
+#endif // LANE_INDEX_H
@@ -0,0 +1,53 @@
+#include "NameTable.h"
+
+
+NameTable::NameTable() {}
+NameTable::~NameTable() {}
+
+
+/// <summary>
+/// Get the id of a name, interning the name if it is new.
+/// </summary>
+/// <param name="name">The name to intern.</param>
+/// <returns>The id of the name, the same for every call with an equal name.</returns>
+NameId NameTable::Intern(const std::string& name)
+{
+    auto found = ids.find(name);
+    if (found != ids.end())
+    {
+        return found->second;
+    }
+
+    NameId id = static_cast<NameId>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+
+/// <summary>
+/// Get the id of a name without interning it.
+/// </summary>
+/// <param name="name">The name to search.</param>
+/// <returns>The id of the name, INVALID_NAME if it was never interned.</returns>
+NameId NameTable::Find(const std::string& name) const
+{
+    auto found = ids.find(name);
+    return (found != ids.end()) ? found->second : INVALID_NAME;
+}
+
+
+/// <summary>
+/// Get the name of an id, used by the debug messages.
+/// </summary>
+/// <param name="id">The id returned by Intern.</param>
+/// <returns>The interned name, an empty string for an unknown id.</returns>
+const std::string& NameTable::GetName(NameId id) const
+{
+    static const std::string unknown;
+    return (id >= 0 && id < static_cast<NameId>(names.size())) ? names[id] : unknown;
+}
+
+
+// Getter for the number of interned names.
+int NameTable::GetSize() const { return static_cast<int>(names.size()); }
@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// Dense identifier of an interned name.
+using NameId = int;
+constexpr NameId INVALID_NAME = -1;
+
+
+// Interned strings: each distinct name is stored once and identified by a dense id.
+// The names are only hashed when interned or searched (Init, debugging), the code
+// running every frame keeps the ids and indexes tables with them.
+class NameTable
+{
+public:
+    NameTable();
+    ~NameTable();
+
+    // Id of the name, the name is added on its first use.
+    NameId Intern(const std::string& name);
+    // Id of an interned name, INVALID_NAME if the name was never interned.
+    NameId Find(const std::string& name) const;
+    // Name of an id, an empty string for an unknown id.
+    const std::string& GetName(NameId id) const;
+    int GetSize() const;
+
+private:
+    std::unordered_map<std::string, NameId> ids;
+    std::vector<std::string> names;     // Indexed by id
+};
+
+#endif // NAME_TABLE_H
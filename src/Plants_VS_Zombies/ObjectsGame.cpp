@@ -385,3 +385,97 @@ Mesh* ObjectsGame::CreateInventory(
 
     return rectangle;
 }
+
+
+Mesh* ObjectsGame::CreateShape(
+    const std::string& name,
+    Shape shape, float size,
+    glm::vec2 params,
+    const glm::vec3 color, float rotation)
+{
+    // The quad is a bit larger than the shape, to cover the fragments of its anti-aliased edge.
+    const float margin = 1.1f;
+
+    // The shape is turned by rotating its coordinates at the corners the opposite way.
+    glm::mat3 inverseRotation = Transforms2D::Rotate(-rotation);
+
+    // The shape and its parameters are the same for the four vertices.
+    glm::vec3 shapeParams = glm::vec3(static_cast<float>(shape), params.x, params.y);
+
+    const glm::vec2 corners[4] = {
+        glm::vec2(-1, -1), glm::vec2(1, -1), glm::vec2(1, 1), glm::vec2(-1, 1)
+    };
+
+    std::vector<VertexFormat> shapeVertices;
+    for (const auto& corner : corners)
+    {
+        glm::vec3 shapeCoord = inverseRotation * glm::vec3(corner * margin, 1.0f);
+        shapeVertices.push_back(VertexFormat(glm::vec3(corner * margin * size, 0),
+                                             color, shapeParams, glm::vec2(shapeCoord)));
+    }
+
+    // Two triangles for the quad.
+    std::vector<unsigned int> shapeIndices = { 0, 1, 2, 0, 2, 3 };
+
+    Mesh* quad = new Mesh(name);
+    quad->InitFromData(shapeVertices, shapeIndices);
+    return quad;
+}
+
+
+Mesh* ObjectsGame::CreatePointScoreShape(
+    const std::string& name,
+    float radius, int segments,
+    float rayBigger, float raySmaller,
+    const glm::vec3 color)
+{
+    // The bigger rays are the tips, the tips of the smaller ones are the vertices between them.
+    float size = radius + rayBigger;
+    glm::vec2 params = glm::vec2(segments / 2, (radius + raySmaller) / size);
+
+    // The first bigger ray of CreatePointScore is the second one.
+    return CreateShape(name, Shape::SUN, size, params, color, 3 * F_PI / segments);
+}
+
+
+Mesh* ObjectsGame::CreateHearthShape(
+    const std::string& name,
+    float scale,
+    const glm::vec3 color)
+{
+    // The tip of the parametric heart is the farthest point from its center, 17 times the scale.
+    return CreateShape(name, Shape::HEART, 17 * scale, glm::vec2(0), color);
+}
+
+
+Mesh* ObjectsGame::CreateProjectileShape(
+    const std::string& name,
+    int segments,
+    float longerSide, float shorterSide,
+    const glm::vec3 color)
+{
+    glm::vec2 params = glm::vec2(segments, shorterSide / longerSide);
+    return CreateShape(name, Shape::STAR, longerSide, params, color);
+}
+
+
+Mesh* ObjectsGame::CreatePlantShape(
+    const std::string& name,
+    int numTriangles,
+    float innerLength, float outerLength,
+    const glm::vec3 color)
+{
+    glm::vec2 params = glm::vec2(numTriangles, innerLength / outerLength);
+    return CreateShape(name, Shape::RHOMBUS, outerLength, params, color);
+}
+
+
+Mesh* ObjectsGame::CreateZombieShape(
+    const std::string& name,
+    float innerRadius, float outerRadius,
+    const glm::vec3 color)
+{
+    // Rotated by 45 degrees like the hexagons of CreateZombie.
+    glm::vec2 params = glm::vec2(innerRadius / outerRadius, 0);
+    return CreateShape(name, Shape::HEXAGON, outerRadius, params, color, glm::radians(45.0f));
+}
@@ -105,4 +105,108 @@ namespace ObjectsGame
 						  float width, float height,
 						  const glm::vec3 color, bool fill = true);
 
+
+	/// <summary>
+	/// Signed distance functions of the SDFShape fragment shader, same values as its SHAPE_ defines.
+	/// </summary>
+	enum class Shape
+	{
+		CIRCLE = 0,
+		STAR,       // Projectiles
+		SUN,        // PointScores
+		HEXAGON,    // Zombies
+		HEART,      // Health
+		RHOMBUS     // Plants
+	};
+
+
+	/// <summary>
+	/// Create a Mesh of a single quad drawn with the SDFShape shader, which evaluates the
+	/// shape for each fragment instead of tessellating it. The quad covers the shape of the
+	/// given radius around the origin, the same model matrices as the tessellated Mesh apply.
+	/// </summary>
+	/// <param name="name">The unique name for the Mesh.</param>
+	/// <param name="shape">The signed distance function of the shape.</param>
+	/// <param name="size">The radius of the shape, the coordinates passed to the shader are divided by it.</param>
+	/// <param name="params">The two parameters of the shape, see SDFShape.FS.glsl.</param>
+	/// <param name="color">The color of the shape.</param>
+	/// <param name="rotation">The rotation of the shape inside the quad, in radians.</param>
+	/// <returns>A pointer to the created Mesh.</returns>
+	Mesh* CreateShape(const std::string& name,
+					  Shape shape, float size,
+					  glm::vec2 params,
+					  const glm::vec3 color, float rotation = 0.0f);
+
+
+	/// <summary>
+	/// Create the quad of a "SUN" (PointScores), same parameters as CreatePointScore.
+	/// The smaller rays are expected to be half the length of the bigger ones.
+	/// </summary>
+	/// <param name="name">The unique name for the Mesh.</param>
+	/// <param name="radius">The radius of the sun.</param>
+	/// <param name="segments">The number of segments in the sun, half of its rays are bigger.</param>
+	/// <param name="rayBigger">The length of the bigger rays.</param>
+	/// <param name="raySmaller">The length of the smaller rays.</param>
+	/// <param name="color">The color of the sun.</param>
+	/// <returns>A pointer to the created Mesh.</returns>
+	Mesh* CreatePointScoreShape(const std::string& name,
+								float radius, int segments,
+								float rayBigger, float raySmaller,
+								const glm::vec3 color);
+
+
+	/// <summary>
+	/// Create the quad of a "HEART" (Health), same parameters as CreateHearth.
+	/// </summary>
+	/// <param name="name">The unique name for the Mesh.</param>
+	/// <param name="scale">The scale factor for the heart.</param>
+	/// <param name="color">The color of the heart.</param>
+	/// <returns>A pointer to the created Mesh.</returns>
+	Mesh* CreateHearthShape(const std::string& name,
+							float scale,
+							const glm::vec3 color);
+
+
+	/// <summary>
+	/// Create the quad of a "CHATTERBOX - STAR" (Projectile), same parameters as CreateProjectile.
+	/// </summary>
+	/// <param name="name">The unique name for the Mesh.</param>
+	/// <param name="segments">The number of segments in the star.</param>
+	/// <param name="longerSide">The length of the longer side of the star.</param>
+	/// <param name="shorterSide">The length of the shorter side of the star.</param>
+	/// <param name="color">The color of the star.</param>
+	/// <returns>A pointer to the created Mesh.</returns>
+	Mesh* CreateProjectileShape(const std::string& name,
+								int segments,
+								float longerSide, float shorterSide,
+								const glm::vec3 color);
+
+
+	/// <summary>
+	/// Create the quad of "RHOMBUSES WITH A CENTER POINT" (Plants), same parameters as CreatePlant.
+	/// </summary>
+	/// <param name="name">The unique name for the Mesh.</param>
+	/// <param name="numTriangles">The number of triangles in the plant.</param>
+	/// <param name="innerLength">The inner length of the triangles.</param>
+	/// <param name="outerLength">The outer length of the triangles.</param>
+	/// <param name="color">The color of the plant.</param>
+	/// <returns>A pointer to the created Mesh.</returns>
+	Mesh* CreatePlantShape(const std::string& name,
+						   int numTriangles,
+						   float innerLength, float outerLength,
+						   const glm::vec3 color);
+
+
+	/// <summary>
+	/// Create the quad of "2 HEXAGONS WITH SAME CENTER" (Zombies), same parameters as CreateZombie.
+	/// </summary>
+	/// <param name="name">The unique name for the Mesh.</param>
+	/// <param name="innerRadius">The inner radius of the zombie.</param>
+	/// <param name="outerRadius">The outer radius of the zombie.</param>
+	/// <param name="color">The color of the zombie.</param>
+	/// <returns>A pointer to the created Mesh.</returns>
+	Mesh* CreateZombieShape(const std::string& name,
+							float innerRadius, float outerRadius,
+							const glm::vec3 color);
+
 } // namespace ObjectsGame
@@ -1,5 +1,4 @@
 #include "GameConstants.h"
-#include "ObjectsGame.h"
 
 #include "Plants.h"
 
@@ -9,8 +8,8 @@
 /// <summary>
 /// Constructor for creating a Plant object with specified properties.
 /// </summary>
-/// <param name="mesh">A pointer to the Mesh representing the plant's visual appearance.</param>
-/// <param name="name">The name of the Plant.</param>
+/// <param name="prototype">Handle of the shared plant mesh of this color.</param>
+/// <param name="name">The interned debug name of the Plant.</param>
 /// <param name="position">The position of the Plant in 3D space.</param>
 /// <param name="color">The color of the Plant.</param>
 /// <param name="radius">The radius of the Plant's circular shape.</param>
@@ -20,10 +19,10 @@
 /// <param name="row">The row index of the Plant in a grid or layout.</param>
 /// <param name="col">The column index of the Plant in a grid or layout.</param>
 /// <param name="cost">The cost associated with the Plant.</param>
-Plant::Plant(Mesh* mesh, const std::string& name, const glm::vec3& position,
+Plant::Plant(PrototypeHandle prototype, NameId name, const glm::vec3& position,
     const glm::vec3& color, float radius, int numTriangles,
     float innerLength, float outerLength, int row, int col, int cost)
-    : mesh(mesh), name(name), position(position), color(color), radius(radius),
+    : prototype(prototype), name(name), position(position), color(color), radius(radius),
     numTriangles(numTriangles), innerLength(innerLength), outerLength(outerLength),
     shootCooldown(5.0f), shootTimer(0.0f), row(row), col(col), cost(cost)
     { /* Constructor initializes a Plant with given properties */ }
@@ -61,16 +60,14 @@ void            Plant::SetColumn(int col)                   { this->col = col; }
 int             Plant::GetCost() const                      { return cost; }
 // Setter for the cost to buy the plant.
 void            Plant::SetCost(int cost)                    { this->cost = cost; }
-// Getter for the mesh associated with the plant.
-Mesh*           Plant::GetMesh() const                      { return mesh; }
+// Getter for the plant's shared mesh handle.
+PrototypeHandle Plant::GetPrototype() const                 { return prototype; }
 // Getter for the name of the plant.
-std::string     Plant::GetName() const                      { return name; }
+NameId          Plant::GetName() const                      { return name; }
 // Setter for the name of the plant.
-void            Plant::SetName(std::string name)            { this->name = name; }
+void            Plant::SetName(NameId name)                 { this->name = name; }
 // Getter for the position of the plant in 2D space.
 glm::vec2       Plant::GetPosition() const                  { return position; }
-// Setter for the mesh associated with the plant.
-void            Plant::SetMesh(Mesh* mesh)                  { this->mesh = mesh; }
 // Getter for the color of the plant.
 glm::vec3       Plant::GetColor() const                     { return color; }
 // Getter for the outer length of the plant's shape.
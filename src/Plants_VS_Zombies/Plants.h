@@ -5,17 +5,19 @@
 
 #include <glm/glm.hpp>
 
+#include "PrototypeMeshes.h"
+#include "NameTable.h"
+
 #include <string>
 
 
-class Mesh;
 class Projectile;
 
 class Plant 
 {
 public:
     // Constructor for Plants
-    Plant(Mesh* mesh, const std::string& name, const glm::vec3& position,
+    Plant(PrototypeHandle prototype, NameId name, const glm::vec3& position,
             const glm::vec3& color, float radius, int numTriangles,
             float innerLength, float outerLength,
             int row, int col, int cost);
@@ -29,8 +31,8 @@ public:
 
     // Getters
     bool IsActive() const;
-    std::string GetName() const;
-    Mesh* GetMesh() const;
+    NameId GetName() const;
+    PrototypeHandle GetPrototype() const;
     glm::vec2 GetPosition() const;
     glm::vec3 GetColor() const;
     float GetLength() const;
@@ -44,8 +46,7 @@ public:
 
     // Setters
     void SetActive(bool newActive);
-    void SetName(std::string name);
-    void SetMesh(Mesh* newMesh);
+    void SetName(NameId name);
     void SetPosition(const glm::vec2& position);
     void SetScale(float newScale);
     void SetRow(int row);
@@ -56,8 +57,8 @@ public:
     void SetShootCooldown(float cooldown) { shootCooldown = cooldown; }
 
 private:
-    Mesh* mesh;
-    std::string name;
+    PrototypeHandle prototype;  // Shared mesh, one per plant color
+    NameId name;          // Debug name, interned in the NameTable of the simulation
     glm::vec2 position;
     glm::vec3 color;
 
@@ -7,18 +7,20 @@
 #include "Transforms2D.h"
 #include "Objects2D.h"
 #include "ObjectsGame.h"
-#include "GreenSquares.h"
+#include "GameSimulation.h"
 
-#include "Zombies.h"
-#include "PointScore.h"
 #include "Plants.h"
 
+#include "core/profiler.h"
+#include "core/gpu/gl_state.h"
+#include "core/gpu/gpu_timer.h"
+
 #include <iostream>
+#include <cstdio>
 #include <cstdlib>
 #include <chrono>
 #include <ctime>
 #include <vector>
-#include <random>
 
 
 using namespace std;
@@ -33,8 +35,19 @@ using AddMeshToList = std::function<void(Mesh*)>;
 /// Handle game initialization, rendering, updates, and user input.
 /// Manage game objects like zombies, plants, projectiles, and pointscores.
 /// </summary>
-Plants_VS_Zombies::Plants_VS_Zombies() :
+/// <param name="seed">Seed of the random streams, a recorded game is replayed with its seed.</param>
+Plants_VS_Zombies::Plants_VS_Zombies(unsigned int seed) :
+    prototypes(),                                      // Meshes shared by zombies, projectiles and suns.
+    renderQueue(),                                     // Commands sorted and executed once per frame.
+    staticBatch(),                                     // Baked lawn and inventory, built at Init phase.
+    backgroundLayer(), backgroundRevision(0),          // Rendered at the first frame,
+    useBackgroundLayer(true),                          // then composited while nothing changes.
     renderScene(nullptr),                              // Manages rendering of all game objects.
+    // Game rules, zombies spawn at the right edge of the window.
+    simulation(SimulationConfig{ window->GetResolution(), seed }),
+    instancedShader(nullptr),                          // Created at Init phase.
+    useShapes(false),                                  // Tessellated meshes until F4 is pressed.
+    textRenderer(nullptr), showProfiler(false),        // Font loaded at Init phase, overlay hidden.
     resolution(window->GetResolution()),               // Current screen resolution.
     windowWidth(static_cast<float>(resolution.x)),     // Width of the game window.
     windowHeight(static_cast<float>(resolution.y)),    // Height of the game window.
@@ -45,67 +58,22 @@ Plants_VS_Zombies::Plants_VS_Zombies() :
     // State of the currently dragged object.
     modelMatrix(), polygonMode(GL_FILL), dragState(),
 
-    // Random device for generating random numbers.
-    // Random number engine.
-    // Distribution for random values.
-    rd(), eng(rd()), distr(),
-
-    // Flag indicating if the game is currently running.
-    // Flag for if a life was lost in the current frame.
-    isGameRunning(false), lifeLostThisFrame(false),
-    // Number of lives left in the game.
-    // Counter for the player's score.
-    livesLeft(GNumLives), pointScoreCounter(0),
     // Center coordinates for positioning.
-    cx(0.0f), cy(0.0f), corner(0.f),
-
-    // List of objects to delete.
-    objectsToDelete(),
-    // List of zombies, projectiles, pointScores and squares in the game.
-    zombies(), plants(), projectiles(), pointScores(), squares(),
-    // List of inventoryPlants, inventoryPointScores
-    inventoryPlants(), inventoryPointScores()
+    cx(0.0f), cy(0.0f),
+    // List of inventoryPlants
+    inventoryPlants()
 {
     renderScene = new RenderScene(
         [this](Mesh* mesh, Shader* shader, const glm::mat3& modelMatrix) 
               { RenderMesh2D(mesh, shader, modelMatrix); },
         [this](Mesh* mesh)
               { AddMeshToList(mesh); },
-        meshes, shaders
+        meshes, shaders, prototypes, renderQueue, staticBatch
     );
 }
-Plants_VS_Zombies::~Plants_VS_Zombies() {}
-
-
-/// <summary>
-/// Stop the game by setting the isGameRunning flag to false.
-/// </summary>
-void Plants_VS_Zombies::StopGame() { isGameRunning = false; }
-
-
-/// <summary>
-/// Decrease the player's lives by one and stops the game if player has 0 lives.
-/// </summary>
-void Plants_VS_Zombies::LoseLife() 
+Plants_VS_Zombies::~Plants_VS_Zombies()
 {
-    if (livesLeft > 0)
-    {
-        livesLeft--;
-        std::cout << "\t================================" << std::endl;
-        std::cout <<  "\t LIFE LOST. LIVES REMAINING:  "  << livesLeft << std::endl;
-        std::cout << "\t================================" << std::endl;
-        // Remove the last rendered heart from the screen
-        std::string heartName = "heart" + std::to_string(livesLeft);
-        renderScene->MarkForDeletion(heartName);
-    }
-
-    if (livesLeft == 0)
-    {
-        std::cout << "\t==========" << std::endl;
-        std::cout << "\tGAME OVER!" << std::endl;
-        std::cout << "\t==========" << std::endl;
-        Plants_VS_Zombies::StopGame();
-    }
+    delete textRenderer;
 }
 
 
@@ -114,10 +82,14 @@ void Plants_VS_Zombies::FrameStart()
     // Clear the color buffer and depth buffer
     glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
     // Clear the screen content, prepare for rendering.
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // The opaque background layer covers the whole screen, only the depth is left to clear
+    bool backgroundCovers = useBackgroundLayer && simulation.IsRunning();
+    glClear(backgroundCovers ? GL_DEPTH_BUFFER_BIT : GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     resolution = window->GetResolution();
     // Set the screen area where the rendering take place.
     glViewport(0, 0, resolution.x, resolution.y);
+    // Zombies keep spawning on the right edge of the resized window
+    simulation.SetBoardSize(resolution);
 }
 
 
@@ -126,10 +98,8 @@ void Plants_VS_Zombies::FrameStart()
 /// </summary>
 void Plants_VS_Zombies::Init()
 {
-    // Start the game, random generator plants in grid at begging,
-    // zombies, speed for projectiles and otehr properties...
-    srand(static_cast<unsigned int>(time(nullptr)));
-    isGameRunning = true;
+    // The random plants in grid at begging, the zombies, the speed for projectiles
+    // and otehr properties come from the streams of the simulation, seeded at construction.
 
     /// CONTINUA PARTEA DE RENDERED TEXT
 
@@ -145,10 +115,8 @@ void Plants_VS_Zombies::Init()
     // Set size to load glyphs as
 //    FT_Set_Pixel_Sizes(face, 0, fontSize);
 
-    cx = corner.x + GsideS / 2;
-    cy = corner.y + GsideS / 2;
-    // Initial corner point of the window, typically set to the origin.
-    corner = glm::vec3(cx, cy + 1.5 * GsideS, 0);
+    cx = Gcorner.x + GsideS / 2;
+    cy = Gcorner.y + GsideS / 2;
 
     // Camera and polygon mode
     polygonMode = GL_FILL;
@@ -159,230 +127,243 @@ void Plants_VS_Zombies::Init()
     camera->Update();
     GetCameraInput()->SetActive(false);
 
+    // Shader drawing every batched 2D instance, same fragment stage as VertexColor
+    {
+        Shader* shader = new Shader("Instanced2D");
+        shader->AddShader(PATH_JOIN(window->props.selfDir, RESOURCE_PATH::SHADERS, "Instanced2D.VS.glsl"), GL_VERTEX_SHADER);
+        shader->AddShader(PATH_JOIN(window->props.selfDir, RESOURCE_PATH::SHADERS, "VertexColor.FS.glsl"), GL_FRAGMENT_SHADER);
+        shader->CreateAndLink();
+        shaders[shader->GetName()] = shader;
+        instancedShader = shader;
+        renderScene->SetSpriteShader(shader);
+    }
+
+    // Shader evaluating the shapes of the SDF quads, drawn instead of the meshes in shape mode
+    {
+        Shader* shader = new Shader("SDFShape");
+        shader->AddShader(PATH_JOIN(window->props.selfDir, RESOURCE_PATH::SHADERS, "SDFShape.VS.glsl"), GL_VERTEX_SHADER);
+        shader->AddShader(PATH_JOIN(window->props.selfDir, RESOURCE_PATH::SHADERS, "SDFShape.FS.glsl"), GL_FRAGMENT_SHADER);
+        shader->CreateAndLink();
+        shaders[shader->GetName()] = shader;
+        renderScene->SetShapeShader(shader);
+    }
+
+    // Shader compositing the background layer, a textured full-screen quad
+    {
+        Shader* shader = new Shader("Screen");
+        shader->AddShader(PATH_JOIN(window->props.selfDir, RESOURCE_PATH::SHADERS, "Screen.VS.glsl"), GL_VERTEX_SHADER);
+        shader->AddShader(PATH_JOIN(window->props.selfDir, RESOURCE_PATH::SHADERS, "Screen.FS.glsl"), GL_FRAGMENT_SHADER);
+        shader->CreateAndLink();
+        shaders[shader->GetName()] = shader;
+        backgroundLayer.Init(shader, glm::vec4(0.2f, 0.2f, 0.2f, 1.0f));
+    }
+
     GameInit gameInitInstance([this](Mesh* mesh) { this->AddMeshToList(mesh); });
     gameInitInstance.InitializeInventorySlots();
-    gameInitInstance.InitializePlantsForInventory();
+    gameInitInstance.InitializePlantsForInventory(this->inventoryPlants, this->prototypes, simulation.GetNames());
     gameInitInstance.InitializeSunsForInventory();
     gameInitInstance.InitializeHeartsForInventory();
+    gameInitInstance.InitializeShapesForInventory();
     gameInitInstance.InitializeBaseRectangle();
-    gameInitInstance.InitializeGreenSquaresForPlants(this->squares);
-    gameInitInstance.InitializeRandomGridPlants(this->plants, cx, cy, GsideS, GspaceBetweenS);
+    gameInitInstance.InitializePrototypeMeshes(this->prototypes);
+    gameInitInstance.InitializeGreenSquaresForPlants();
     GameInit::PrintMeshNames();
+    renderScene->ResolveMeshes(meshes);
+
+    // The lawn and the inventory never move, baked once into the buffers of the static batch
+    BakeStaticGeometry();
+
+    // Text of the profiler overlay, in window pixels with the origin at the top-left corner
+    textRenderer = new gfxc::TextRenderer(window->props.selfDir, resolution.x, resolution.y);
+    textRenderer->Load(PATH_JOIN(window->props.selfDir, RESOURCE_PATH::FONTS, "Hack-Bold.ttf"), 16);
+
+    // Random plants on the lawn at the beginning of the game
+    simulation.PlantRandomGrid();
+
+    // The simulation ticks at a fixed rate whatever the refresh rate, the frames interpolate
+    SetFixedTimestep(GSimulationTickRate, GMaxCatchUpSteps);
 }
 
 
 /// <summary>
-///  Handle the logic to update the position and state of point scores.
+/// Bake the lawn and the inventory into the static batch, at Init phase and again
+/// when the shape mode changes the meshes of the inventory suns and hearts.
 /// </summary>
-/// <param name="deltaTimeSeconds">Time elapsed since the last update.</param>
-void Plants_VS_Zombies::UpdatePointScores(float deltaTimeSeconds)
+void Plants_VS_Zombies::BakeStaticGeometry()
 {
-    for (auto& pointScore : pointScores)
-    {
-        if (pointScore.IsActive())
-        {
-            float lifespan = pointScore.GetLifeSpan();
-            lifespan -= deltaTimeSeconds;
-            pointScore.SetLifeSpan(lifespan);
-            if (pointScore.GetLifeSpan() <= 0)
-            {
-                renderScene->MarkForDeletion(pointScore.GetName());
-                pointScore.SetActive(false);
-            }
-        }
-    }
+    staticBatch.Clear();
+    renderScene->BakeInventorySlots(meshes, shaders, cx, cy, GspaceBetweenS, GslotsINV);
+    renderScene->BakeSunsForInventory(meshes, shaders,
+                                      GstartXINV, GslotWidthINV, GpaddingINV,
+                                      GhorizontalOffsetSUN, GstartYINV, GslotHeightINV,
+                                      GverticalOffsetSUN, GscaleSunInINV, GradiusPST, GhorizontalGapSUN);
+    renderScene->BakeHearthsForInventory(meshes, shaders);
+    renderScene->BakeBaseRectangle(meshes, shaders, cx, cy, GspaceBetweenS);
+    renderScene->BakeGreenSquaresForPlants(meshes, shaders, cx, cy, GspaceBetweenS, GsideS);
 }
 
 
 /// <summary>
-/// Update the state and position of all active zombies.
-/// Check for collisions and handles interactions.
+/// Advance the game rules by one tick, called at the fixed tick rate before Update.
 /// </summary>
-/// <param name="deltaTimeSeconds">Time elapsed since the last update.</param>
-void Plants_VS_Zombies::UpdateZombies(float deltaTimeSeconds)
+/// <param name="fixedDeltaTimeSeconds">Duration of a tick.</param>
+void Plants_VS_Zombies::FixedUpdate(float fixedDeltaTimeSeconds)
 {
-    zombies.erase(std::remove_if(zombies.begin(), zombies.end(), [&](Zombie& zombie) -> bool {
-        if (!zombie.IsActive()) {
-            return false; // Keep inactive zombies
-        }
-
-        zombie.Move(deltaTimeSeconds);
+    /// SPAWN, MOVE, COLLIDE AND SHOOT, NO OPENGL CALL INSIDE
+    simulation.Step(fixedDeltaTimeSeconds);
+}
 
-        if (zombie.IsIntersectingWithRectangle(corner, GwidthR, GheightR)) {
-            Plants_VS_Zombies::LoseLife();
-            renderScene->MarkForDeletion(zombie.GetName());
-            return true; // Remove zombie if it intersects with the rectangle
-        }
 
-        return false; // Keep the zombie if it doesn't intersect
-    }), zombies.end());
+/// <summary>
+/// Render the game state for each frame, the simulation is stepped by FixedUpdate.
+/// Renders the zombies, plants, projectiles, point scores and the inventory,
+/// the moving entities are interpolated between the last two ticks.
+/// Check whether the game is running and stops rendering if the game has stopped.
+/// </summary>
+/// <param name="deltaTimeSeconds">The time elapsed since the last frame update.</param>
+void Plants_VS_Zombies::Update(float deltaTimeSeconds)
+{
+    GLState::PolygonMode(GL_FRONT_AND_BACK, polygonMode);
 
-    // Now handle rendering separately for active zombies
-    for (auto& zombie : zombies)
+    /// CHECK IF THE GAME IS STILL RUNNING (STOP RENDERING)!
+    if (!simulation.IsRunning())
     {
-        if (zombie.IsActive())
-        {
-            renderScene->RenderZombie(meshes, shaders, zombie);
-        }
+        // Skip updating if the game is not running
+        return;
     }
-}
 
+    /// DRAW THE MOVING ENTITIES BETWEEN THE LAST TWO TICKS
+    float alpha = GetInterpolationAlpha();
 
-/// <summary>
-/// Handle collisions between plants and zombies.
-/// If an active plant collides with an active zombie, the plant is set to inactive, effectively 'destroying' it.
-/// If a plant is already inactive, this method triggers its disappearance animation.
-/// </summary>
-/// <param name="deltaTimeSeconds">The time elapsed since the last frame, used for animations</param>
-void Plants_VS_Zombies::HandlePlantZombieCollisions(float deltaTimeSeconds) {
-    for (auto& plant : plants)
+    /// COMMANDS OF THE SCENE, IN ANY ORDER, THEIR LAYER DECIDES WHAT IS DRAWN FIRST
     {
-        if (plant.IsActive())
-        {
-            for (auto& zombie : zombies)
-            {
-                if (zombie.IsActive() && zombie.IsCollidingWithPlant(plant))
-                {
-                    plant.SetActive(false);
-                    plant.SetPlaced(false);
-                    plant.~Plant();
-                    break;
-                }
-            }
-        }
-        else
-        {
-            renderScene->AnimatePlantDisappearance(shaders, plant, deltaTimeSeconds);
-        }
+        PROFILE_GPU_ZONE("RenderScene");
+
+        /// COLLECT THIS FRAME COMMANDS, SORTED AND DRAWN AT THE END
+        renderQueue.Begin();
+
+        /// ZOMBIES WALKING OR SHRINKING AFTER BEING DESTROYED
+        renderScene->RenderZombies(meshes, shaders, simulation.GetZombies(), alpha);
+
+        ///////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// RENDER ACTIVE POINTSCORES ON SCREEN
+        renderScene->RenderPointScores(meshes, shaders, simulation.GetPointScores());
+        ///////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// POINTSCORE INVENTORY
+        renderScene->RenderPointScoresForInventory(meshes, shaders, simulation.GetPointScoreCounter());
+        /// PLANTS INSIDE OF THE INVENTORY
+        renderScene->RenderPlantsForInventory(shaders, inventoryPlants);
+        /// HEARTHS INSIDE OF THE INVENTORY, ONLY THEIR VISIBILITY CHANGES
+        renderScene->UpdateHearthsForInventory(simulation.GetLivesLeft());
+        ///////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// PLANTS WITHIN THE GREEN SQUARES
+        renderScene->RenderPlants(meshes, shaders, simulation.GetPlants());
+        /// RENDER THE DRAGGED PLANT
+        renderScene->RenderDraggedPlant(shaders, dragState);
+        /// RENDER PROJECTILES EXISTENT
+        renderScene->RenderProjectiles(meshes, shaders, simulation.GetProjectiles(), alpha);
+    }
+    auto camera = GetSceneCamera();
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// INVENTORY, RED BASE AND GREEN SQUARES FROM THE LAYER, THE ENTITIES ARE DRAWN OVER IT
+    if (useBackgroundLayer)
+    {
+        PROFILE_GPU_ZONE("Background");
+        RenderBackgroundLayer();
+    }
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// THE EDGES OF THE SDF QUADS ARE BLENDED, THE OTHER MESHES ARE OPAQUE
+    if (useShapes)
+    {
+        GLState::Enable(GL_BLEND);
+        GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ONE INSTANCED DRAW CALL PER RUN OF COMMANDS SHARING SHADER AND MESH
+    {
+        PROFILE_GPU_ZONE("RenderQueue");
+        renderQueue.Execute(camera->GetViewMatrix(), camera->GetProjectionMatrix());
+    }
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// INVENTORY, RED BASE AND GREEN SQUARES, AFTER THE ENTITIES DRAWN ON TOP OF THEM
+    if (!useBackgroundLayer)
+    {
+        PROFILE_GPU_ZONE("StaticBatch");
+        staticBatch.Render(instancedShader, camera->GetViewMatrix(), camera->GetProjectionMatrix());
+    }
+    if (useShapes)
+    {
+        GLState::Disable(GL_BLEND);
     }
 }
 
 
 /// <summary>
-/// Handle each active projectile for collisions with active zombies.
-/// If a collision occurs, the zombie takes a hit, and the projectile is marked for deletion.
-/// Additionally, if the zombie is destroyed as a result of the hit, it is also marked for deletion.
-/// Trigger the disappearance animation for inactive zombies.
+/// Composite the background layer, the static batch is rendered into it again only
+/// when one of its items changed, the window was resized or the polygon mode changed.
+/// The layer is always composited filled, even in wireframe mode.
 /// </summary>
-/// <param name="deltaTimeSeconds">The time elapsed since the last frame, used for animations.</param>
-void Plants_VS_Zombies::HandleProjectileZombieCollisions(float deltaTimeSeconds)
+void Plants_VS_Zombies::RenderBackgroundLayer()
 {
-    for (auto& projectile : projectiles)
+    if (staticBatch.GetRevision() != backgroundRevision)
     {
-        if (!projectile.IsActive())
-        {
-            continue;
-        }
-        for (auto& zombie : zombies)
+        backgroundRevision = staticBatch.GetRevision();
+        backgroundLayer.Invalidate();
+    }
+
+    if (backgroundLayer.BeginUpdate(resolution))
+    {
+        auto camera = GetSceneCamera();
+        // The SDF quads of the inventory are blended into the layer, it is composited opaque
+        if (useShapes)
         {
-            if (zombie.IsActive() && zombie.IsCollidingWithProjectile(projectile))
-            {
-                zombie.Hit();
-                renderScene->MarkForDeletion(projectile.GetName());
-                projectile.SetActive(false);
-
-                if (zombie.IsDestroyed())
-                {
-                    zombie.SetActive(false);
-                    renderScene->MarkForDeletion(zombie.GetName());
-                }
-                break;
-            }
-            if (!zombie.IsActive())
-            {
-                renderScene->AnimateZombieDisappearance(shaders, zombie, deltaTimeSeconds);
-            }
+            GLState::Enable(GL_BLEND);
+            GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         }
+        staticBatch.Render(instancedShader, camera->GetViewMatrix(), camera->GetProjectionMatrix());
+        GLState::Disable(GL_BLEND);
+        backgroundLayer.EndUpdate();
     }
+
+    GLState::PolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    backgroundLayer.Composite();
+    GLState::PolygonMode(GL_FRONT_AND_BACK, polygonMode);
 }
 
+
 /// <summary>
-/// Update the game state for each frame.
-/// Progresses the game state based on the elapsed time(deltaTimeSeconds).
-/// Handle various game functionalities such as 
-/// spawning zombies, moving and checking collisions, updating point scores, 
-/// rendering game elements, and managing plant projectile mechanics.
-/// Check whether the game is running and performs cleanup if the game has stopped.
+/// Print the draw calls issued by the last frame, toggled with F1.
+/// Commands sharing shader and mesh are drawn together once sorted, whichever subsystem submitted them.
+/// The occupancy of the entity pools is printed as live / capacity (peak).
 /// </summary>
-/// <param name="deltaTimeSeconds">The time elapsed since the last frame update.</param>
-void Plants_VS_Zombies::Update(float deltaTimeSeconds)
+void Plants_VS_Zombies::PrintDrawStats() const
 {
-    glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
-
-    // Reset the flag at the start of the update
-    lifeLostThisFrame = false;
-    // Random device signal HW
-    std::random_device rd;    
-    // Seed the generator
-    std::mt19937 eng(rd());
-    // Define the range if speed
-    std::uniform_real_distribution<> distr(GMINSPEED, GMAXSPEED);
-
-    /// CHECK IF THE GAME IS STILL RUNNING (STOP RENDERING)!
-    if (!isGameRunning)
-    {
-        // Perform deletion of objects marked for deletion
-        renderScene->DeferredDeletion();
-        // Skip updating if the game is not running
-        return;
-    }
-
-    /// RANDOMLY DECIDE WHEN A ZOMBIE SHOULD BE SPAWNED
-    Zombie::SpawnRandomZombies(deltaTimeSeconds, resolution, zombies);
-    /// ALL ACTIVE ZOMBIES MOVE THEM AND CHECK FOR COLLISIONS
-    Plants_VS_Zombies::UpdateZombies(deltaTimeSeconds);
-
-    /// SPAWN NEW POINTSCORES IF NEEDED
-    PointScore::SpawnPointScores(deltaTimeSeconds, windowWidth, windowHeight, pointScores, meshes);
-    /// UPDATE LIFE AND POINTSCORE
-    Plants_VS_Zombies::UpdatePointScores(deltaTimeSeconds);
-
-    /// COLLISION: PLANTS + ZOMBIES
-    Plants_VS_Zombies::HandlePlantZombieCollisions(deltaTimeSeconds);
-    /// COLLISION: PROJECTILES + ZOMBIES
-    Plants_VS_Zombies::HandleProjectileZombieCollisions(deltaTimeSeconds);
-
-    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// RENDER ACTIVE POINTSCORES ON SCREEN
-    renderScene->RenderPointScores(meshes, shaders, pointScores);
-    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// POINTSCORE INVENTORY
-    renderScene->RenderPointScoresForInventory(meshes, shaders, inventoryPointScores, pointScoreCounter);
-    /// INVENTORY SLOTS
-    renderScene->RenderInventorySlots(meshes, shaders, cx, cy, GspaceBetweenS, GslotsINV);
-    /// PLANTS INSIDE OF THE INVENTORY
-    renderScene->RenderPlantsForInventory(meshes, shaders, meshes, inventoryPlants);
-    /// SUNS INSIDE OF THE INVENTORY
-    renderScene->RenderSunsForInventory(meshes, shaders,
-                                        GstartXINV, GslotWidthINV, GpaddingINV,
-                                        GhorizontalOffsetSUN, GstartYINV, GslotHeightINV,
-                                        GverticalOffsetSUN, GscaleSunInINV, GradiusPST, GhorizontalGapSUN);
-    /// HEARTHS INSIDE OF THE INVENTORY
-    renderScene->RenderHearthsForInventory(meshes, shaders, livesLeft);
-    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// RENDER DROPPED WITHIN THE GREEN SQUARES -> HANDLE SHOOTING
-    renderScene->RenderDroppedPlant(meshes, shaders,
-                                     plants, zombies, projectiles,
-                                     GnumSegmentsPJ, GlengthLongerSidePJ, GlengthShorterSidePJ,
-                                     eng, distr, resolution, deltaTimeSeconds);
-
-    /// RENDER THE DRAGGED PLANT
-    renderScene->RenderDraggedPlant(shaders, dragState);
-    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// PLANTS WITHIN THE GREEN SQUARES -> HANDLE SHOOTING
-    renderScene->RenderPlantsProjectiles(meshes, shaders, 
-                                         plants, zombies, projectiles,
-                                         GnumSegmentsPJ, GlengthLongerSidePJ, GlengthShorterSidePJ,
-                                         eng, distr, deltaTimeSeconds);
-
-    /// RENDER PROJECTILES EXISTENT
-    renderScene->RenderProjectiles(meshes, shaders, deltaTimeSeconds, resolution, projectiles);
-    ///////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// RECTANGLE RED BASE
-    renderScene->RenderBaseRectangle(meshes, shaders, cx, cy, GspaceBetweenS);
-    /// GREEN SQUARES 
-    renderScene->RenderGreenSquaresForPlants(meshes, shaders, cx, cy, GspaceBetweenS, GsideS);
-    ///////////////////////////////////////////////////////////////////////////////////////////////////////
+    const RenderQueue::Stats& stats = renderQueue.GetStats();
+    const EntityStore& zombies = simulation.GetZombies();
+    const EntityStore& projectiles = simulation.GetProjectiles();
+    const EntityStore& pointScores = simulation.GetPointScores();
+    std::cout << "\t================================" << std::endl;
+    std::cout << "\t DRAW CALLS : " << stats.drawCalls << std::endl;
+    std::cout << "\t INSTANCES  : " << stats.instances << std::endl;
+    std::cout << "\t COMMANDS   : " << stats.commands << " in " << stats.layers << " layers ("
+              << stats.sortPasses << " sort passes)" << std::endl;
+    std::cout << "\t CHANGES    : " << stats.shaderChanges << " shaders, " << stats.meshChanges << " meshes" << std::endl;
+    std::cout << "\t STATIC     : " << staticBatch.GetStats().items << " items in "
+              << staticBatch.GetStats().drawCalls << " multi-draws" << std::endl;
+    std::cout << "\t BACKGROUND : " << (useBackgroundLayer ? "layer" : "direct") << ", rendered "
+              << backgroundLayer.GetUpdateCount() << " times" << std::endl;
+    std::cout << "\t SHAPES     : " << (useShapes ? "sdf quads" : "meshes") << std::endl;
+    std::cout << "\t GPU BUFFERS: " << GPUBuffers::GetLiveObjectCount() << std::endl;
+    std::cout << "\t GL CALLS   : " << GLState::GetLastFrameStats().GetCalls()
+              << " (" << GLState::GetLastFrameStats().GetRedundant() << " redundant skipped)" << std::endl;
+    std::cout << "\t ZOMBIES    : " << zombies.GetSize() << " / " << zombies.GetCapacity()
+              << " (" << zombies.GetPeakSize() << ")" << std::endl;
+    std::cout << "\t PROJECTILES: " << projectiles.GetSize() << " / " << projectiles.GetCapacity()
+              << " (" << projectiles.GetPeakSize() << ")" << std::endl;
+    std::cout << "\t SUNS       : " << pointScores.GetSize() << " / " << pointScores.GetCapacity()
+              << " (" << pointScores.GetPeakSize() << ")" << std::endl;
+    std::cout << "\t INV PLANTS : " << inventoryPlants.size() << std::endl;
+    std::cout << "\t================================" << std::endl;
 }
 
 
@@ -429,11 +410,106 @@ void Plants_VS_Zombies::OnKeyRelease(int key, int mods) {}
 void Plants_VS_Zombies::OnWindowResize(int width, int height) {}
 void Plants_VS_Zombies::OnInputUpdate(float deltaTime, int mods) {}
 void Plants_VS_Zombies::OnMouseScroll(int mouseX, int mouseY, int offsetX, int offsetY) {}
-void Plants_VS_Zombies::FrameEnd() {}
+void Plants_VS_Zombies::FrameEnd()
+{
+    if (showProfiler)
+    {
+        PROFILE_GPU_ZONE("Overlay");
+        RenderProfilerOverlay();
+    }
+}
+
+
+/// <summary>
+/// Draw the time of the profiled phases averaged over the last second, CPU and GPU,
+/// with the draw calls of the last frame and the occupancy of the entity pools.
+/// The GPU time is read back a few frames late, "-" until then.
+/// </summary>
+void Plants_VS_Zombies::RenderProfilerOverlay()
+{
+    const int frames = 60;
+    const float lineHeight = 18.0f;
+    const glm::vec3 textColor(1.0f, 1.0f, 0.6f);
+
+    std::vector<Profiler::ZoneSummary> zones;
+    Profiler::Summarize(frames, zones);
+
+    double frameMs = 0;
+    int frameCount = 0;
+    for (; frameCount < frames && Profiler::GetFrame(frameCount); frameCount++)
+    {
+        frameMs += Profiler::GetFrame(frameCount)->cpuMs;
+    }
+    if (frameCount > 0)
+    {
+        frameMs /= frameCount;
+    }
+
+    std::vector<std::string> lines;
+    char line[128];
+    snprintf(line, sizeof(line), "FRAME %6.2f ms  %5.1f fps", frameMs, frameMs > 0 ? 1000.0 / frameMs : 0.0);
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "%-18s %7s %7s", "PHASE", "CPU ms", "GPU ms");
+    lines.push_back(line);
+    for (const auto& zone : zones)
+    {
+        char gpu[16] = "-";
+        if (zone.gpuMs >= 0)
+        {
+            snprintf(gpu, sizeof(gpu), "%7.3f", zone.gpuMs);
+        }
+        std::string name = std::string(2 * zone.depth, ' ') + zone.name;
+        snprintf(line, sizeof(line), "%-18s %7.3f %7s", name.c_str(), zone.cpuMs, gpu);
+        lines.push_back(line);
+    }
+
+    const RenderQueue::Stats& stats = renderQueue.GetStats();
+    snprintf(line, sizeof(line), "DRAW CALLS %u  INSTANCES %u", stats.drawCalls, stats.instances);
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "COMMANDS %u  SHADERS %u  MESHES %u",
+        stats.commands, stats.shaderChanges, stats.meshChanges);
+    lines.push_back(line);
+    const GLState::Stats& glStats = GLState::GetLastFrameStats();
+    snprintf(line, sizeof(line), "GL CALLS %u  SKIPPED %u", glStats.GetCalls(), glStats.GetRedundant());
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "ZOMBIES %d/%d  PROJECTILES %d/%d  SUNS %d/%d",
+        simulation.GetZombies().GetSize(), simulation.GetZombies().GetCapacity(),
+        simulation.GetProjectiles().GetSize(), simulation.GetProjectiles().GetCapacity(),
+        simulation.GetPointScores().GetSize(), simulation.GetPointScores().GetCapacity());
+    lines.push_back(line);
+
+    // On top of the scene, whatever its depth
+    GLState::PolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    GLState::Disable(GL_DEPTH_TEST);
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        textRenderer->RenderText(lines[i], 10.0f, 10.0f + i * lineHeight, 1.0f, textColor);
+    }
+    GLState::Enable(GL_DEPTH_TEST);
+}
 
 
 void Plants_VS_Zombies::OnKeyPress(int key, int mods)
 {
+    if (key == GLFW_KEY_F1)
+    {
+        PrintDrawStats();
+    }
+    if (key == GLFW_KEY_F2)
+    {
+        showProfiler = !showProfiler;
+    }
+    if (key == GLFW_KEY_F3)
+    {
+        useBackgroundLayer = !useBackgroundLayer;
+    }
+    if (key == GLFW_KEY_F4)
+    {
+        useShapes = !useShapes;
+        renderScene->SetShapeMode(useShapes);
+        // The inventory suns and hearts change mesh, the new revision invalidates the layer
+        BakeStaticGeometry();
+    }
     if (key == GLFW_KEY_SPACE)
     {
         switch (polygonMode)
@@ -448,6 +524,8 @@ void Plants_VS_Zombies::OnKeyPress(int key, int mods)
             polygonMode = GL_LINE;
             break;
         }
+        // The layer holds the lawn drawn with the previous mode
+        backgroundLayer.Invalidate();
     }
 }
 
@@ -483,45 +561,18 @@ void Plants_VS_Zombies::OnMouseBtnPress(int mouseX, int mouseY, int button, int
     if (button == GLFW_MOUSE_BUTTON_RIGHT)
     { // MOUSE LEFT
         glm::vec2 worldMousePos = ConvertScreenToWorldCoords(mouseX, mouseY);
-        for (auto& pointScore : pointScores)
+        if (simulation.CollectPointScoresAt(worldMousePos) > 0)
         {
-            if (pointScore.IsMouseOver(worldMousePos.x, worldMousePos.y))
-            {
-                std::cout << "POINTSCORE CLICKED: " << pointScore.GetName() << std::endl;
-                std::cout << "COORDONATES ( "
-                    << pointScore.GetPosition().x << " , "
-                    << pointScore.GetPosition().y << " ) " << std::endl;
-                if (inventoryPointScores.size() < 3)
-                {
-                    std::cout << "POINTSCORE MODIFIED: " << pointScoreCounter << std::endl;
-                    // Clone the PointScore for the inventory
-                    PointScore inventoryPointScore = pointScore;
-                    // Set the disappearing flag
-                    inventoryPointScore.SetDissapearing(true);
-                    inventoryPointScores.push_back(inventoryPointScore);
-                }
-
-                pointScoreCounter++;  // Increment the inventory counter
-                // Mark the original PointScore for deletion
-                pointScore.SetDissapearing(true);
-                renderScene->MarkForDeletion(pointScore.GetName());
-            }
+            std::cout << "POINTSCORE MODIFIED: " << simulation.GetPointScoreCounter() << std::endl;
         }
 
-        // Remove PointScores that are marked for deletion
-        pointScores.erase(
-            std::remove_if(pointScores.begin(), pointScores.end(),
-                [](const PointScore& ps) { return ps.IsDissapearing(); }),
-            pointScores.end()
-        );
-
         for (auto& plant : inventoryPlants) {
             if (plant.IsActive() && plant.IsMouseOver(worldMousePos.x, worldMousePos.y)) {
                 int plantCost = plant.GetCost();
 
                 // Ensure pointScoreCounter is checked here before proceeding
-                if (pointScoreCounter >= plantCost) {
-                    if (plant.GetMesh() && shaders.find("VertexColor") != shaders.end()) {
+                if (simulation.GetPointScoreCounter() >= plantCost) {
+                    if (plant.GetPrototype() != INVALID_PROTOTYPE) {
                         dragState.isDragging = true;
                         dragState.selectedPlant = new Plant(plant);
                         dragState.originalPosition = plant.GetPosition();
@@ -538,27 +589,8 @@ void Plants_VS_Zombies::OnMouseBtnPress(int mouseX, int mouseY, int button, int
     if (button == GLFW_MOUSE_BUTTON_MIDDLE) // CLICK RIGHT removes the plant
     {
         glm::vec2 worldMousePos = ConvertScreenToWorldCoords(mouseX, mouseY);
-        for (auto it = plants.begin(); it != plants.end();) {
-            if (it->IsMouseOver(worldMousePos.x, worldMousePos.y)) {
-                std::cout << "PLANT CLICKED: " << it->GetName() << std::endl;
-
-                // Iterate over squares to find the one containing the clicked plant
-                for (auto& square : squares) {
-                    if (square.ContainsPlantAt(it->GetPosition())) {
-                        // Mark the square as unoccupied
-                        square.SetOccupied(false);
-                        break; // Exit the loop once the correct square is found and updated
-                    }
-                }
-
-                // Mark the plant for deletion and remove it from the collection
-                renderScene->MarkForDeletion(it->GetName());
-                it = plants.erase(it); // Erase returns the iterator following the last removed element
-            }
-            else {
-                ++it; // Continue if not erasing the plant
-            }
-        }
+        // The square of the removed plant becomes free again
+        simulation.RemovePlantAt(worldMousePos);
     }
 }
 
@@ -576,40 +608,14 @@ void Plants_VS_Zombies::OnMouseBtnPress(int mouseX, int mouseY, int button, int
 void Plants_VS_Zombies::OnMouseBtnRelease(int mouseX, int mouseY, int button, int mods) {
     if (button == GLFW_MOUSE_BUTTON_RIGHT && dragState.isDragging) {
         glm::vec2 worldMousePos = ConvertScreenToWorldCoords(mouseX, mouseY);
-        bool placed = false;
 
-        for (auto& square : squares) {
-            float distance = glm::distance(worldMousePos, square.GetCenterPosition());
-            if (!square.IsOccupied() && distance < DROP_TOLL && pointScoreCounter >= dragState.selectedPlant->GetCost()) {
-
-                // Update plant properties
-                dragState.selectedPlant->SetPosition(square.GetCenterPosition());
-                dragState.selectedPlant->SetActive(true);
-                dragState.selectedPlant->SetRow(square.GetRow());
-                dragState.selectedPlant->SetColumn(square.GetCol());
-
-                // Assuming ResetShootTimer and other methods are properly defined
-                dragState.selectedPlant->ResetShootTimer();
-                placed = true;
-
-                pointScoreCounter -= dragState.selectedPlant->GetCost();
-                std::cout << "POINTSCORE MODIFIED: " << pointScoreCounter << std::endl;
-
-                dragState.selectedPlant->SetActive(true);
-                dragState.selectedPlant->SetPlaced(true);
-
-                // Add the plant to the rendering list
-                plants.push_back(std::move(*dragState.selectedPlant));
-                delete dragState.selectedPlant;
-                break; // Plant placed successfully
-            }
-        }
-
-        if (!placed) {
-            // Revert changes if plant is not placed
-            delete dragState.selectedPlant;
+        // Placed on a free square close to the mouse, if the player can still pay for it
+        if (simulation.PlacePlant(*dragState.selectedPlant, worldMousePos))
+        {
+            std::cout << "POINTSCORE MODIFIED: " << simulation.GetPointScoreCounter() << std::endl;
         }
 
+        delete dragState.selectedPlant;
         dragState.Reset();
     }
 }
@@ -4,20 +4,20 @@
 #define PLANTS_VS_ZOMBIES_H
 
 #include "components/simple_scene.h"
+#include "components/text_renderer.h"
+#include "core/gpu/render_queue.h"
+#include "core/gpu/retained_layer.h"
+#include "core/gpu/static_batch_2d.h"
 
 #include "GameConstants.h"
+#include "GameSimulation.h"
 #include "RenderScene.h"
 
-#include "Zombies.h"
 #include "Plants.h"
-#include "Projectiles.h"
-#include "PointScore.h"
-#include "GreenSquares.h"
+#include "PrototypeMeshes.h"
 
-#include <random>
 #include <functional>
 #include <unordered_map>
-#include <unordered_set>
 
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
 #define MAX(a, b) (((a) > (b)) ? (a) : (b))
@@ -28,31 +28,39 @@ class RenderScene;
 class Plants_VS_Zombies : public gfxc::SimpleScene
 {
 public:
-    Plants_VS_Zombies();            // Constructor for Plants_VS_Zombies
+    explicit Plants_VS_Zombies(unsigned int seed);   // Constructor, the seed determines the whole game
     ~Plants_VS_Zombies();           // Destructor for Plants_VS_Zombies
 
     void Init() override;
 
-    int GetLivesLeft() const { return livesLeft; }
-    void SetLivesLeft(int newLivesLeft) { livesLeft = newLivesLeft; }
+    int GetLivesLeft() const { return simulation.GetLivesLeft(); }
     std::vector<Plant>& GetInventoryPlants() { return inventoryPlants; }
     void SetInventoryPlants(const std::vector<Plant>& newInventoryPlants) { inventoryPlants = newInventoryPlants; }
 
 private:
+    PrototypeMeshes prototypes;
+    RenderQueue renderQueue;        // Sorted commands of the moving entities, executed once per frame
+    StaticBatch2D staticBatch;      // Lawn and inventory that never move, baked at Init
+    RetainedLayer backgroundLayer;  // Static batch rendered once into a texture, toggled with F3
+    unsigned int backgroundRevision;    // Revision of the static batch held by the layer
+    bool useBackgroundLayer;
     RenderScene* renderScene;
+    GameSimulation simulation;      // Game rules, stepped by FixedUpdate at GSimulationTickRate, rendering interpolates them
+    Shader* instancedShader;        // Draws the render queue, found once at Init instead of by name every frame
+    bool useShapes;                 // Entities, suns and hearts drawn as SDF quads, toggled with F4
+    gfxc::TextRenderer* textRenderer;   // Draws the profiler overlay
+    bool showProfiler;              // Profiler overlay toggled with F2
 
-    void StopGame();
-    void LoseLife();
     glm::vec2 ConvertScreenToWorldCoords(int mouseX, int mouseY);
 
-    void HandlePlantZombieCollisions(float deltaTimeSeconds);
-    void HandleProjectileZombieCollisions(float deltaTimeSeconds);
-
-    void UpdatePointScores(float deltaTimeSeconds);
-    void UpdateZombies(float deltaTimeSeconds);
+    void PrintDrawStats() const;
+    void RenderProfilerOverlay();
+    void RenderBackgroundLayer();
+    void BakeStaticGeometry();
 
     ///
     void FrameStart() override;
+    void FixedUpdate(float fixedDeltaTimeSeconds) override;
     void Update(float deltaTimeSeconds) override;
     void FrameEnd() override;
 
@@ -81,30 +89,9 @@ protected:
     glm::mat3 modelMatrix;
     GLenum polygonMode;
 
-    std::random_device rd;
-    std::mt19937 eng;
-    std::uniform_real_distribution<> distr;
-
-    bool isGameRunning;
-    bool lifeLostThisFrame;
-
-    int livesLeft = 3;
-    int pointScoreCounter = 0;
-
     float cx, cy;
-    glm::vec3 corner;
-
-    std::unordered_set<std::string> objectsToDelete;
-
-    std::vector<Zombie> zombies;
-    std::vector<Plant> plants;
-
-    std::vector<Projectile> projectiles;
-    std::vector<PointScore> pointScores;
 
-    std::vector<GreenSquare> squares;
     std::vector<Plant> inventoryPlants;
-    std::vector<PointScore> inventoryPointScores;
 };
 
 #endif // PLANTS_VS_ZOMBIES_H
@@ -4,7 +4,6 @@
 #include <cstdlib>
 
 #include "GameConstants.h"
-#include "ObjectsGame.h"
 #include "Transforms2D.h"
 
 
@@ -22,10 +21,10 @@
 PointScore::PointScore(const std::string& name, const glm::vec3& position, const glm::vec3& color,
     float radius, int numSegments, int raySegments,
     float biggerRayLength, float smallerRayLength) :
-    mesh(nullptr), name(name), position(position), color(color),
+    prototype(INVALID_PROTOTYPE), name(name), position(position), color(color),
     radius(radius), numSegments(numSegments), raySegments(raySegments),
     biggerRayLength(biggerRayLength), smallerRayLength(smallerRayLength),
-    lifespan(5.0f), isActive(true), isDisappearing(false), disappearanceProgress(0.0f)
+    lifespan(GlifeSpanPST), isActive(true), isDisappearing(false), disappearanceProgress(0.0f)
     { /* Constructor initializes a PointScore with given properties */ }
 PointScore::~PointScore() {}
 
@@ -38,8 +37,22 @@ PointScore::~PointScore() {}
 /// <returns>True if the mouse is over the PointScore, false otherwise.</returns>
 bool PointScore::IsMouseOver(float worldMouseX, float worldMouseY) const
 {
-    float dx = worldMouseX - position.x;
-    float dy = worldMouseY - position.y;
+    return IsMouseOver(glm::vec2(position), radius, worldMouseX, worldMouseY);
+}
+
+
+/// <summary>
+/// Check if the mouse is inside the circle of a sun.
+/// </summary>
+/// <param name="center">Position of the sun.</param>
+/// <param name="radius">Radius of the sun.</param>
+/// <param name="worldMouseX">X coordinate of the mouse in the world space.</param>
+/// <param name="worldMouseY">Y coordinate of the mouse in the world space.</param>
+/// <returns>True if the mouse is over the sun, false otherwise.</returns>
+bool PointScore::IsMouseOver(const glm::vec2& center, float radius, float worldMouseX, float worldMouseY)
+{
+    float dx = worldMouseX - center.x;
+    float dy = worldMouseY - center.y;
     float distanceSquared = dx * dx + dy * dy;
     return distanceSquared <= (radius * radius);
 }
@@ -48,16 +61,15 @@ bool PointScore::IsMouseOver(float worldMouseX, float worldMouseY) const
 /// <summary>
 /// Spawn PointScores at random positions within the window.
 /// </summary>
+/// <param name="spawnTimer">Time accumulated since the last spawn, owned by the caller.</param>
 /// <param name="deltaTime">Time elapsed since the last frame.</param>
 /// <param name="windowWidth">Width of the rendering window.</param>
 /// <param name="windowHeight">Height of the rendering window.</param>
-/// <param name="pointScores">A vector to store the spawned PointScores.</param>
-/// <param name="meshes">A map of mesh names to Mesh objects.</param>
-void PointScore::SpawnPointScores(float deltaTime, float windowWidth, float windowHeight,
-    std::vector<PointScore>& pointScores, std::unordered_map<std::string, Mesh*>& meshes)
+/// <param name="pointScores">The store receiving the spawned PointScores.</param>
+/// <param name="random">Stream drawing the number and the positions of the PointScores.</param>
+void PointScore::SpawnPointScores(float& spawnTimer, float deltaTime, float windowWidth, float windowHeight,
+    EntityStore& pointScores, Random& random)
 {
-    /// TIMER TO DETERMINE IF I CAN SPAWN MORE
-    static float spawnTimer = 0.0f;
     /// FIX SPAWN INTERVAL FOR POINTSCORES
     static const float spawnInterval = 5.0f;
 
@@ -67,40 +79,18 @@ void PointScore::SpawnPointScores(float deltaTime, float windowWidth, float wind
     {
         spawnTimer -= spawnInterval;
         // Generates numbers between 3 and 6
-        int numberOfPointScoresToSpawn = rand() % 4 + 3;
+        int numberOfPointScoresToSpawn = random.NextInt(4) + 3;
 
         for (int i = 0; i < numberOfPointScoresToSpawn; ++i) {
-            float randomX = static_cast<float>(rand()) / RAND_MAX * windowWidth;
-            float randomY = static_cast<float>(rand()) / RAND_MAX * windowHeight;
-            glm::vec3 randomPosition = glm::vec3(randomX, randomY, 0.0f);
-
-            // Generate a unique name for each PointScore
-            std::string pointScoreName = "pointScore" + std::to_string(pointScores.size() + i);
-            PointScore newPointScore(pointScoreName,                // unique name of the plant
-                                     randomPosition,                // plant random position
-                                     glm::vec3(1.0f, 1.0f, 0.0f),   // color
-                                     20.0f,                         // radius
-                                     30, 75,                        // segments, raySegments
-                                     20.0f, 10.0f);                 // rayBigger, raySmaller
-
-            // Create mesh for the PointScore
-            Mesh* pointScoreMesh = ObjectsGame::CreatePointScore(pointScoreName, 
-                                                                 20.0f,                         // radius
-                                                                 30, 75,                        // segments, raySegments
-                                                                 20.0f, 10.0f,                  // rayBigger, raySmaller
-                                                                 glm::vec3(1.0f, 1.0f, 0.0f));  // color
-
-            // Check if mesh is valid
-            if (pointScoreMesh)
-            {
-                newPointScore.SetMesh(pointScoreMesh);
-                meshes[pointScoreName] = pointScoreMesh;
-                pointScores.push_back(newPointScore);
-            }
-            else 
+            float randomX = random.NextFloat() * windowWidth;
+            float randomY = random.NextFloat() * windowHeight;
+
+            // All the suns share the single mesh built at Init phase, first color slot
+            EntityHandle pointScore = pointScores.Create(randomX, randomY, 0.0f, 0, -1, 1);
+            if (pointScore != INVALID_ENTITY)
             {
-                // Log an error message if mesh creation fails
-                std::cerr << "FAILED TO CREATE POINTSCORE MESH: " << pointScoreName << std::endl;
+                // Time the sun stays on the screen
+                pointScores.timer[pointScores.GetSlot(pointScore)] = GlifeSpanPST;
             }
         }
     }
@@ -140,7 +130,5 @@ void            PointScore::SetDissapearing(bool dissapearing)          { this->
 bool            PointScore::IsActive() const                            { return isActive; }
 // Setter for the active status of the PointScore.
 void            PointScore::SetActive(bool active)                      { this->isActive = active; }
-// Setter for the mesh associated with the PointScore.
-void            PointScore::SetMesh(Mesh* mesh)                         { this->mesh = mesh; }
-// Getter for the mesh associated with the PointScore.
-Mesh*           PointScore::GetMesh() const                             { return mesh; }
+// Getter for the shared mesh handle of the PointScore.
+PrototypeHandle PointScore::GetPrototype() const                        { return prototype; }
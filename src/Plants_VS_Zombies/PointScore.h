@@ -5,12 +5,13 @@
 
 #include <glm/glm.hpp>
 
+#include "PrototypeMeshes.h"
+#include "EntityStore.h"
+#include "Random.h"
+
 #include <string>
 #include <vector>
-#include <unordered_map>
-
 
-class Mesh;
 
 class PointScore 
 {
@@ -25,13 +26,13 @@ public:
     void AnimateDisappearance(float deltaTime);
 
     // Spawn PointScores at random locations
-    static void SpawnPointScores(float deltaTime,
+    static void SpawnPointScores(float& spawnTimer, float deltaTime,
         float windowWidth, float windowHeight,
-        std::vector<PointScore>& pointScores,
-        std::unordered_map<std::string, Mesh*>& meshes);
+        EntityStore& pointScores, Random& random);
 
     // Checks if the mouse cursor is over the PointScore
     bool IsMouseOver(float mouseX, float mouseY) const;
+    static bool IsMouseOver(const glm::vec2& center, float radius, float mouseX, float mouseY);
 
     // Getters and Setters
     std::string GetName() const;
@@ -46,11 +47,10 @@ public:
     bool IsDissapearing() const;
     void SetDissapearing(bool dissapearing);
 
-    Mesh* GetMesh() const;
-    void SetMesh(Mesh* newMesh);
+    PrototypeHandle GetPrototype() const;
 
 private:
-    Mesh* mesh;
+    PrototypeHandle prototype;      // Shared mesh of all the suns
     std::string name;
     glm::vec3 position;
     glm::vec3 color;
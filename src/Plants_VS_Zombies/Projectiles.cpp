@@ -4,7 +4,7 @@
 /// <summary>
 /// Construct a new Projectile object with the specified properties.
 /// </summary>
-/// <param name="mesh">A pointer to the Mesh object associated with the projectile.</param>
+/// <param name="prototype">Handle of the shared projectile mesh of this color.</param>
 /// <param name="color">The color of the projectile.</param>
 /// <param name="longerSideLength">The length of the longer side of the projectile.</param>
 /// <param name="shorterSideLength">The length of the shorter side of the projectile.</param>
@@ -14,50 +14,26 @@
 /// <param name="rotation">The initial rotation angle of the projectile (in degrees).</param>
 /// <param name="isActive">A flag indicating whether the projectile is active.</param>
 /// <param name="speed">The speed at which the projectile moves.</param>
-Projectile::Projectile(Mesh* mesh, const glm::vec3& color,
+Projectile::Projectile(PrototypeHandle prototype, const glm::vec3& color,
                        float longerSideLength, float shorterSideLength,
                        int numSegments,
                        const std::string& name, const glm::vec2& position,
                        float rotation, bool isActive, float speed) :
-                       mesh(mesh), color(color),
+                       prototype(prototype), color(color),
                        longerSideLength(longerSideLength), shorterSideLength(shorterSideLength),
                        numSegments(numSegments),
                        name(name), position(position),
-                       rotation(rotation), isActive(isActive), speed(speed)
+                       rotation(rotation), isActive(isActive), speed(speed), row(-1)
                        { /* Constructor initializes a Projectile with given properties. */ }
 Projectile::~Projectile() {}
 
 
-/// <summary>
-/// Move the projectile based on its current speed and deltaTime.
-/// </summary>
-/// <param name="deltaTime">The time elapsed since the last frame (in seconds).</param>
-/// <param name="resolution">The resolution of the rendering window (width and height).</param>
-void Projectile::Move(float deltaTime, const glm::ivec2& resolution)
-{
-    // Make the projectile move on OX (velocity * time).
-    position.x += speed * deltaTime;
-    // Make the projectile rotate.
-    rotation += 5 * deltaTime;
-
-    if (rotation >= 360.0f)
-    {
-        rotation -= 360.0f;
-    }
-
-    // Deactivate the projectile instead of resetting its position.
-    if (position.x > resolution.x)
-    {
-        isActive = false;
-    }
-}
-
 // Getters & Setters for projectile properties.
 
 // Getter for the name of the projectile.
 std::string         Projectile::GetName() const                             { return name; }
-// Getter for the Mesh object associated with the projectile.
-Mesh* Projectile::GetMesh() const                                           { return mesh; }
+// Getter for the shared mesh handle of the projectile.
+PrototypeHandle     Projectile::GetPrototype() const                        { return prototype; }
 // Getter for the color of the projectile.
 glm::vec3           Projectile::GetColor() const                            { return color; }
 // Getter for the current position of the projectile.
@@ -72,6 +48,10 @@ void                Projectile::SetSpeed(float newSpeed)                    { sp
 float               Projectile::GetRotation() const                         { return rotation; }
 // Setter for the rotation angle of the projectile.
 void                Projectile::SetRotation(float newRotation)              { rotation = newRotation; }
+// Getter for the row the projectile travels on.
+int                 Projectile::GetRow() const                              { return row; }
+// Setter for the row the projectile travels on.
+void                Projectile::SetRow(int newRow)                          { row = newRow; }
 // Check if the projectile is active.
 bool                Projectile::IsActive() const                            { return isActive; }
 // Setter for the active state of the projectile.
@@ -5,26 +5,23 @@
 
 #include <glm/glm.hpp>
 
-#include <string>
+#include "PrototypeMeshes.h"
 
+#include <string>
 
-class Mesh;
 
 class Projectile 
 {
 public:
     // Constructor for Projectiles.
-    Projectile(Mesh* mesh, const glm::vec3& color, float longerSideLength,
+    Projectile(PrototypeHandle prototype, const glm::vec3& color, float longerSideLength,
         float shorterSideLength, int numSegments, const std::string& name,
         const glm::vec2& position, float rotation, bool isActive, float speed);
     ~Projectile();
 
-    // Move the projectile based on the current speed and deltaTime.
-    void Move(float deltaTime, const glm::ivec2& resolution);
-
     // Getters.
     std::string GetName() const;
-    Mesh* GetMesh() const;
+    PrototypeHandle GetPrototype() const;
     glm::vec3 GetColor() const;
 
     float GetLongerSideLength() const;
@@ -34,15 +31,17 @@ public:
     bool IsActive() const;
     float GetSpeed() const;
     float GetRotation() const;
+    int GetRow() const;
 
     // Setters.
     void SetPosition(const glm::vec2& newPosition);
     void SetActive(bool active);
     void SetSpeed(float newSpeed);
     void SetRotation(float newRotation);
+    void SetRow(int newRow);
 
 private:
-    Mesh* mesh;  
+    PrototypeHandle prototype;  // Shared mesh, one per projectile color
     std::string name;
     glm::vec2 position;
     glm::vec3 color;      
@@ -54,6 +53,7 @@ private:
     float rotation;             // The rotation angle (in degrees) of the projectile.
     bool isActive;              // A flag indicating whether the projectile is active or not.
     float speed;                // The speed at which the projectile is moving.
+    int row;                    // Row of the plant that shot the projectile, -1 if unknown.
 
 };
 
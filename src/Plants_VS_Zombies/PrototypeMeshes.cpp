@@ -0,0 +1,100 @@
+#include "PrototypeMeshes.h"
+
+#include "GameConstants.h"
+
+
+/// <summary>
+/// Create an empty registry with a slot for every (kind, color) pair.
+/// Meshes are owned by the scene mesh list, the registry only indexes them.
+/// </summary>
+PrototypeMeshes::PrototypeMeshes() :
+    meshes(static_cast<int>(PrototypeKind::COUNT) * Gcolors.size(), nullptr),
+    shapes(meshes.size(), nullptr)
+    { /* Constructor reserves one slot per (kind, color) pair */ }
+PrototypeMeshes::~PrototypeMeshes() {}
+
+
+/// <summary>
+/// Register the shared mesh of a (kind, color) pair.
+/// </summary>
+/// <param name="kind">The kind of entity drawn with this mesh.</param>
+/// <param name="colorIndex">Index of the color inside Gcolors.</param>
+/// <param name="mesh">The mesh created once at Init phase.</param>
+void PrototypeMeshes::Register(PrototypeKind kind, int colorIndex, Mesh* mesh)
+{
+    PrototypeHandle handle = GetHandle(kind, colorIndex);
+    if (handle != INVALID_PROTOTYPE)
+    {
+        meshes[handle] = mesh;
+    }
+}
+
+
+/// <summary>
+/// Register the SDF quad of a (kind, color) pair, drawn instead of the mesh in shape mode.
+/// </summary>
+/// <param name="kind">The kind of entity drawn with this quad.</param>
+/// <param name="colorIndex">Index of the color inside Gcolors.</param>
+/// <param name="shape">The quad created once at Init phase.</param>
+void PrototypeMeshes::RegisterShape(PrototypeKind kind, int colorIndex, Mesh* shape)
+{
+    PrototypeHandle handle = GetHandle(kind, colorIndex);
+    if (handle != INVALID_PROTOTYPE)
+    {
+        shapes[handle] = shape;
+    }
+}
+
+
+/// <summary>
+/// Compute the handle of a (kind, color) pair.
+/// </summary>
+/// <param name="kind">The kind of entity.</param>
+/// <param name="colorIndex">Index of the color inside Gcolors.</param>
+/// <returns>The handle, or INVALID_PROTOTYPE for an out of range pair.</returns>
+PrototypeHandle PrototypeMeshes::GetHandle(PrototypeKind kind, int colorIndex)
+{
+    const int numColors = static_cast<int>(Gcolors.size());
+    if (colorIndex < 0 || colorIndex >= numColors || kind == PrototypeKind::COUNT)
+    {
+        return INVALID_PROTOTYPE;
+    }
+    return static_cast<int>(kind) * numColors + colorIndex;
+}
+
+
+/// <summary>
+/// Recover the palette index a handle was computed with, used to bucket entities by color.
+/// </summary>
+/// <param name="handle">The handle of a prototype mesh.</param>
+/// <returns>The index inside Gcolors, -1 for an invalid handle.</returns>
+int PrototypeMeshes::GetColorIndex(PrototypeHandle handle)
+{
+    if (handle < 0)
+    {
+        return -1;
+    }
+    return handle % static_cast<int>(Gcolors.size());
+}
+
+
+// Getter for the mesh shared by the entities with the given handle.
+Mesh* PrototypeMeshes::GetMesh(PrototypeHandle handle) const
+{
+    if (handle < 0 || handle >= static_cast<int>(meshes.size()))
+    {
+        return nullptr;
+    }
+    return meshes[handle];
+}
+
+
+// Getter for the SDF quad of the entities with the given handle.
+Mesh* PrototypeMeshes::GetShape(PrototypeHandle handle) const
+{
+    if (handle < 0 || handle >= static_cast<int>(shapes.size()))
+    {
+        return nullptr;
+    }
+    return shapes[handle];
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef PROTOTYPE_MESHES_H
+#define PROTOTYPE_MESHES_H
+
+#include <vector>
+
+
+class Mesh;
+
+// Kinds of geometry shared by every spawned entity of the same color.
+enum class PrototypeKind
+{
+    ZOMBIE = 0,
+    PROJECTILE,
+    POINT_SCORE,
+    PLANT,
+    COUNT
+};
+
+// Handle to a shared mesh, the only geometry reference an entity keeps.
+using PrototypeHandle = int;
+constexpr PrototypeHandle INVALID_PROTOTYPE = -1;
+
+
+class PrototypeMeshes
+{
+public:
+    PrototypeMeshes();
+    ~PrototypeMeshes();
+
+    // Store the mesh built at Init phase for the (kind, color) pair.
+    void Register(PrototypeKind kind, int colorIndex, Mesh* mesh);
+    // Store the SDF quad drawing the same (kind, color) pair, see ObjectsGame::CreateShape.
+    void RegisterShape(PrototypeKind kind, int colorIndex, Mesh* shape);
+
+    // Handle of the (kind, color) pair, computed without touching the registry.
+    static PrototypeHandle GetHandle(PrototypeKind kind, int colorIndex);
+    // Index of the color a handle was computed with, -1 for an invalid handle.
+    static int GetColorIndex(PrototypeHandle handle);
+
+    // Getter for the mesh shared by all the entities with this handle.
+    Mesh* GetMesh(PrototypeHandle handle) const;
+    // Getter for the SDF quad of this handle, nullptr if it has none.
+    Mesh* GetShape(PrototypeHandle handle) const;
+
+private:
+    std::vector<Mesh*> meshes;  // Indexed by handle: kind * colors + colorIndex.
+    std::vector<Mesh*> shapes;  // Same indices, the quads of the SDFShape shader.
+};
+
+#endif // PROTOTYPE_MESHES_H
@@ -0,0 +1,86 @@
+#include "Random.h"
+
+
+namespace
+{
+    std::uint64_t SplitMix64(std::uint64_t& x)
+    {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    std::uint32_t RotateLeft(std::uint32_t x, int k)
+    {
+        return (x << k) | (x >> (32 - k));
+    }
+}
+
+
+/// <summary>
+/// Create the generator of one stream of a run.
+/// </summary>
+/// <param name="seed">Seed of the run, shared by all its streams.</param>
+/// <param name="stream">Subsystem drawing from the generator.</param>
+Random::Random(std::uint64_t seed, RandomStream stream)
+{
+    Seed(seed, stream);
+}
+Random::~Random() {}
+
+
+/// <summary>
+/// Restart the stream of a run, the same seed and stream give the same numbers.
+/// </summary>
+/// <param name="seed">Seed of the run, shared by all its streams.</param>
+/// <param name="stream">Subsystem drawing from the generator.</param>
+void Random::Seed(std::uint64_t seed, RandomStream stream)
+{
+    // Each stream starts from a different splitmix64 sequence, never from an all-zero state
+    std::uint64_t x = seed ^ (static_cast<std::uint64_t>(stream) + 1) * 0xD1B54A32D192ED03ull;
+    std::uint64_t a = SplitMix64(x);
+    std::uint64_t b = SplitMix64(x);
+    state[0] = static_cast<std::uint32_t>(a);
+    state[1] = static_cast<std::uint32_t>(a >> 32);
+    state[2] = static_cast<std::uint32_t>(b);
+    state[3] = static_cast<std::uint32_t>(b >> 32);
+}
+
+
+// Next output of xoshiro128**.
+std::uint32_t Random::Next()
+{
+    std::uint32_t result = RotateLeft(state[1] * 5, 7) * 9;
+    std::uint32_t t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = RotateLeft(state[3], 11);
+
+    return result;
+}
+
+
+// Uniform integer in [0, bound): the high bits of a 32 x 32 bit product, no division.
+int Random::NextInt(int bound)
+{
+    return static_cast<int>((static_cast<std::uint64_t>(Next()) * static_cast<std::uint32_t>(bound)) >> 32);
+}
+
+
+// Uniform float in [0, 1): the 24 high bits fill the mantissa exactly.
+float Random::NextFloat()
+{
+    return (Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+
+// Uniform float in [min, max).
+float Random::Range(float min, float max)
+{
+    return min + (max - min) * NextFloat();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+
+// Independent random streams of a run, one per subsystem, so drawing more numbers in
+// one subsystem (a new rule, a debug print) does not change what the others draw.
+enum class RandomStream
+{
+    ZOMBIES = 0,        // Spawn count, row, color and speed
+    POINT_SCORES,       // Spawn count and position
+    PROJECTILES,        // Speed
+    PLANTS,             // Starting lawn
+    AUTOPLAY            // Headless bot
+};
+
+
+// Small and fast seedable generator (xoshiro128**, 16 bytes of state) replacing rand()
+// and std::mt19937: the same seed gives the same numbers on every platform and library,
+// so a seed fully determines a run. Drawing a number costs a few nanoseconds.
+class Random
+{
+public:
+    // The state of the stream is derived from the seed of the run with splitmix64.
+    explicit Random(std::uint64_t seed = 0, RandomStream stream = RandomStream::ZOMBIES);
+    ~Random();
+
+    void Seed(std::uint64_t seed, RandomStream stream);
+
+    // Uniform 32 bits.
+    std::uint32_t Next();
+    // Uniform integer in [0, bound), bound > 0.
+    int NextInt(int bound);
+    // Uniform float in [0, 1).
+    float NextFloat();
+    // Uniform float in [min, max).
+    float Range(float min, float max);
+
+private:
+    std::uint32_t state[4];
+};
+
+#endif // RANDOM_H
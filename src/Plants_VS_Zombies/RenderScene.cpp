@@ -1,12 +1,109 @@
 #include "RenderScene.h"
 
 #include <iostream>
-#include <random>
+
+
+/// <summary>
+/// Resolve the names of the meshes drawn every frame into ids, the render methods
+/// index a table with them instead of hashing the names each frame.
+/// Called once at Init phase, after GameInit created the meshes.
+/// </summary>
+/// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
+void RenderScene::ResolveMeshes(const std::unordered_map<std::string, Mesh*>& meshes)
+{
+    inventorySlotMeshes.clear();
+    for (int i = 0; i < GslotsINV; ++i)
+    {
+        inventorySlotMeshes.push_back(ResolveMesh(meshes, "inventorySlot" + std::to_string(i), true));
+    }
+
+    // Each slot shows as many suns as the cost of its plant, the others are missing
+    sunMeshes.clear();
+    for (int i = 0; i < GslotsINV - 1; ++i)
+    {
+        for (int j = 0; j < GMaxCost; ++j)
+        {
+            sunMeshes.push_back(ResolveMesh(meshes, "sun" + std::to_string(i * 3 + j), false));
+        }
+    }
+
+    heartMeshes.clear();
+    for (int i = 0; i < GNumLives; ++i)
+    {
+        heartMeshes.push_back(ResolveMesh(meshes, "heart" + std::to_string(i), true));
+    }
+
+    squareMeshes.clear();
+    for (int square = 0; square < GNUM_COLS * GNUM_ROWS; ++square)
+    {
+        squareMeshes.push_back(ResolveMesh(meshes, "square" + std::to_string(square + 1), true));
+    }
+
+    baseRectangleMesh = ResolveMesh(meshes, "rectangle", true);
+
+    // Shape mode falls back to the tessellated meshes without them
+    sunShapeMesh = ResolveMesh(meshes, "sunShape", false);
+    heartShapeMesh = ResolveMesh(meshes, "heartShape", false);
+}
+
+
+/// <summary>
+/// Intern the name of a mesh and store the mesh under its id.
+/// </summary>
+/// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
+/// <param name="name">The name of the mesh.</param>
+/// <param name="required">Report the mesh if it does not exist.</param>
+/// <returns>The id of the mesh name.</returns>
+NameId RenderScene::ResolveMesh(const std::unordered_map<std::string, Mesh*>& meshes,
+    const std::string& name, bool required)
+{
+    NameId id = meshNames.Intern(name);
+    if (id >= static_cast<NameId>(meshTable.size()))
+    {
+        meshTable.resize(id + 1, nullptr);
+    }
+
+    auto found = meshes.find(name);
+    meshTable[id] = (found != meshes.end()) ? found->second : nullptr;
+    if (!meshTable[id] && required)
+    {
+        std::cerr << "Error: Mesh not found: " << name << std::endl;
+    }
+    return id;
+}
+
+
+// Getter for a mesh resolved by ResolveMeshes, nullptr if it does not exist.
+Mesh* RenderScene::GetMesh(NameId id) const
+{
+    return (id >= 0 && id < static_cast<NameId>(meshTable.size())) ? meshTable[id] : nullptr;
+}
+
+
+/// <summary>
+/// Submit one instance of a prototype to the render queue. In shape mode its SDF quad is
+/// drawn by the SDFShape shader, the quads of a kind and color still share one draw call.
+/// </summary>
+/// <param name="layer">The layer of the render queue.</param>
+/// <param name="handle">The handle of the prototype.</param>
+/// <param name="modelMatrix">The model matrix of the instance, the same for the mesh and the quad.</param>
+void RenderScene::SubmitPrototype(RenderLayer layer, PrototypeHandle handle, const glm::mat3& modelMatrix)
+{
+    Mesh* shape = useShapes ? prototypes.GetShape(handle) : nullptr;
+    if (shape)
+    {
+        renderQueue.Submit(layer, shapeShader, shape, modelMatrix);
+    }
+    else
+    {
+        renderQueue.Submit(layer, spriteShader, prototypes.GetMesh(handle), modelMatrix);
+    }
+}
 
 
 //////////////////////////////// GAME SCENE IMPORTANT ELEMENTS ////////////////////////////////
 /// <summary>
-/// Render inventory slots at the specified location with the given parameters.
+/// Bake the inventory slots into the static batch, they never move once created.
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
@@ -14,74 +111,47 @@
 /// <param name="cy">The Y-coordinate of the center of the inventory.</param>
 /// <param name="spaceBetweenS">The spacing between inventory slots.</param>
 /// <param name="slotsINV">The number of inventory slots to render.</param>
-void RenderScene::RenderInventorySlots(
+void RenderScene::BakeInventorySlots(
     const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
     float cx, float cy, float spaceBetweenS, int slotsINV
 ) {
-    for (int i = 0; i < slotsINV; ++i)
+    for (int i = 0; i < slotsINV && i < static_cast<int>(inventorySlotMeshes.size()); ++i)
     {
-        std::string inventorySlotName = "inventorySlot" + std::to_string(i);
+        Mesh* mesh = GetMesh(inventorySlotMeshes[i]);
+        if (!mesh) continue;
+
         glm::mat3 modelMatrix = glm::mat3(1); // Identity matrix for no transformation
         modelMatrix *= Transforms2D::Translate(cx + 0, cy - 2 * spaceBetweenS);
-        RenderMesh2D(meshes.at(inventorySlotName), shaders.at("VertexColor"), modelMatrix);
+        staticBatch.Add(mesh, modelMatrix);
     }
 }
 
 
 /// <summary>
 /// Render plant objects in the inventory with their corresponding positions and scales.
+/// The plants and their meshes are created once at Init phase, only drawn here.
 /// </summary>
-/// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
-/// <param name="newMeshes">A map of newly created plant meshes.</param>
+/// <param name="inventoryPlants">The plants of the inventory slots.</param>
 void RenderScene::RenderPlantsForInventory(
-    const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
-    std::unordered_map<std::string, Mesh*>& newMeshes,
-    std::vector<Plant>& inventoryPlants
+    const std::vector<Plant>& inventoryPlants
 ) {
-    // Create plant meshes for each inventory slot
-    for (int i = 0; i < GslotsINV - 1; ++i)
+    for (const auto& plant : inventoryPlants)
     {
-        std::string plantName = "plant" + std::to_string(i);
-        Mesh* plantMesh = ObjectsGame::CreatePlant(
-            plantName,
-            GradiusPT, GnumTrianglesPT, GtriangleInnerLenPT, GtriangleOuterLenPT,
-            Gcolors[i] // Use the i-th color for this plant
-        );
-        addMeshToList(plantMesh);
-
         // Render each plant mesh in its inventory slot with scaling
-        std::string inventorySlotName = "inventorySlot" + std::to_string(i);
-        glm::mat3 modelMatrix = glm::mat3(1); // Start with the identity matrix
-
-        // Compute the position within the inventory slot
-        float plantPosX = GstartXINV + i * (GslotWidthINV + GpaddingINV) + GslotWidthINV - GspaceBetweenS / 3;
-        float plantPosY = GstartYINV + GslotHeightINV / 2 + GspaceBetweenS / 2;
-        glm::vec3 plantPosition = glm::vec3(plantPosX, plantPosY, 0);
-
-        // Create plant object and add it to the plants vector
-        Plant newPlant(plantMesh, inventorySlotName, plantPosition, Gcolors[i], GradiusPT,
-            GnumTrianglesPT, GtriangleInnerLenPT, GtriangleOuterLenPT,
-            -1, -1, GcostPlantsINV[i]);
-
-        newPlant.SetPlaced(false);
-        newPlant.SetActive(true);
-        inventoryPlants.push_back(newPlant);
-        
-        // Add the new plant's mesh to the newMeshes map
-        newMeshes[plantName] = plantMesh;
-
-        modelMatrix *= Transforms2D::Translate(plantPosX, plantPosY);
+        glm::mat3 modelMatrix = glm::mat3(1);
+        modelMatrix *= Transforms2D::Translate(plant.GetPosition().x, plant.GetPosition().y);
         modelMatrix *= Transforms2D::Scale(GscalePlantsInINV, GscalePlantsInINV);
-        renderMesh2D(meshes.at(plantName), shaders.at("VertexColor"), modelMatrix);
+        SubmitPrototype(LAYER_PLANTS, plant.GetPrototype(), modelMatrix);
     }
 }
 
 
 /// <summary>
-/// Render sun objects in the inventory with their corresponding positions and scales.
+/// Bake the sun objects of the inventory into the static batch with their positions and scales.
+/// In shape mode every sun is the same SDF quad.
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
@@ -95,13 +165,15 @@ void RenderScene::RenderPlantsForInventory(
 /// <param name="scaleSunInINV">The scale factor for rendering suns in the inventory.</param>
 /// <param name="radiusPST">The radius of sun objects.</param>
 /// <param name="horizontalGapSUN">The horizontal gap between suns within each slot.</param>
-void RenderScene::RenderSunsForInventory(
+void RenderScene::BakeSunsForInventory(
     const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
     float startXINV, float slotWidthINV, float paddingINV, float horizontalOffsetSUN,
     float startYINV, float slotHeightINV, float verticalOffsetSUN,
     float scaleSunInINV, float radiusPST, float horizontalGapSUN)
 {
+    Mesh* sunShape = useShapes ? GetMesh(sunShapeMesh) : nullptr;
+
     // Render suns in the first eight inventory slots
     for (int i = 0; i < GslotsINV - 1; ++i)
     {
@@ -110,18 +182,21 @@ void RenderScene::RenderSunsForInventory(
 
         for (int j = 0; j < GMaxCost; ++j)
         {
-            std::string sunName = "sun" + std::to_string(i * 3 + j);
+            Mesh* mesh = GetMesh(sunMeshes[i * GMaxCost + j]);
 
             // Calculate horizontal position for each sun within the slot
             float sunPosX = firstSunPosX + j * ((radiusPST * scaleSunInINV) + horizontalGapSUN);
             // Calculate vertical position for each sun within the slot
             float sunPosY = startYINV + slotHeightINV - verticalOffsetSUN;
 
-            if (meshes.find(sunName) != meshes.end() && shaders.find("VertexColor") != shaders.end()) {
+            if (mesh) {
                 glm::mat3 modelMatrix = glm::mat3(1);
                 modelMatrix *= Transforms2D::Translate(sunPosX, sunPosY);
                 modelMatrix *= Transforms2D::Scale(scaleSunInINV, scaleSunInINV);
-                RenderMesh2D(meshes.at(sunName), shaders.at("VertexColor"), modelMatrix);
+                if (sunShape)
+                    staticBatch.Add(sunShape, modelMatrix, shapeShader);
+                else
+                    staticBatch.Add(mesh, modelMatrix);
             }
         }
     }
@@ -129,36 +204,61 @@ void RenderScene::RenderSunsForInventory(
 
 
 /// <summary>
-/// Render heart objects in the inventory based on the number of lives left.
+/// Bake one heart object for each life into the static batch, all of them visible.
+/// In shape mode every heart is the same SDF quad.
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
-/// <param name="livesLeft">The number of lives left to be represented by hearts.</param>
-void RenderScene::RenderHearthsForInventory(
+void RenderScene::BakeHearthsForInventory(
     const std::unordered_map<std::string, Mesh*>& meshes,
-    const std::unordered_map<std::string, Shader*>& shaders,
-    int livesLeft
+    const std::unordered_map<std::string, Shader*>& shaders
 ) {
     // Calculate the firstHeartX so that hearts are aligned to the right within the last slot
     float firstHeartX = GstartXHS + GslotWidthLIV - GtotalWidthHS / 1.05;
     // Calculate the heartY so that hearts are vertically centered in the slot
     float heartY = GstartYHS + (GslotHeightLIV - GscaleH * GspaceBetweenS) / 2;
 
-    for (int i = 0; i < livesLeft; ++i)
+    Mesh* heartShape = useShapes ? GetMesh(heartShapeMesh) : nullptr;
+
+    heartItems.clear();
+    for (int i = 0; i < static_cast<int>(heartMeshes.size()); ++i)
     {
-        std::string heartName = "heart" + std::to_string(i);
+        Mesh* mesh = GetMesh(heartMeshes[i]);
+        if (!mesh)
+        {
+            heartItems.push_back(-1);
+            continue;
+        }
+
         glm::mat3 modelMatrix = glm::mat3(1);
         float heartX = firstHeartX + i * (GscaleH * GspaceBetweenS + GspaceBetweenHS * 2.5);
         modelMatrix *= Transforms2D::Translate(heartX, heartY);
         modelMatrix *= Transforms2D::Scale(GscaleHearthInINV, GscaleHearthInINV);
 
-        // Assuming that you have a mesh for each heart and a map of meshes
-        renderMesh2D(meshes.at(heartName), shaders.at("VertexColor"), modelMatrix);
+        // One mesh for each heart, resolved at Init phase
+        if (heartShape)
+            heartItems.push_back(staticBatch.Add(heartShape, modelMatrix, shapeShader));
+        else
+            heartItems.push_back(staticBatch.Add(mesh, modelMatrix));
     }
 }
 
+
 /// <summary>
-/// Render green squares for plant placement in the game grid.
+/// Hide the baked hearts of the lives lost, called every frame.
+/// The draw ranges of the static batch are rebuilt only when a heart changes.
+/// </summary>
+/// <param name="livesLeft">The number of lives left to be represented by hearts.</param>
+void RenderScene::UpdateHearthsForInventory(int livesLeft)
+{
+    for (int i = 0; i < static_cast<int>(heartItems.size()); ++i)
+    {
+        staticBatch.SetVisible(heartItems[i], i < livesLeft);
+    }
+}
+
+/// <summary>
+/// Bake the green squares for plant placement in the game grid into the static batch.
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
@@ -166,7 +266,7 @@ void RenderScene::RenderHearthsForInventory(
 /// <param name="cy">The Y-coordinate of the center of the grid.</param>
 /// <param name="spaceBetweenS">The spacing between green squares.</param>
 /// <param name="sideS">The side length of each green square.</param>
-void RenderScene::RenderGreenSquaresForPlants(
+void RenderScene::BakeGreenSquaresForPlants(
     const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
     float cx, float cy, float spaceBetweenS, float sideS)
@@ -180,22 +280,25 @@ void RenderScene::RenderGreenSquaresForPlants(
                 cx + sideS * (col + 1) + col * spaceBetweenS,
                 cy + sideS * row + spaceBetweenS * (row + 1)
             );
-            std::string squareName = "square" + std::to_string(col * GNUM_ROWS + row + 1);
-            renderMesh2D(meshes.at(squareName), shaders.at("VertexColor"), modelMatrix);
+            Mesh* mesh = GetMesh(squareMeshes[col * GNUM_ROWS + row]);
+            if (mesh)
+            {
+                staticBatch.Add(mesh, modelMatrix);
+            }
         }
     }
 }
 
 
 /// <summary>
-/// Render the base rectangle in the game.
+/// Bake the base rectangle of the game into the static batch.
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
 /// <param name="cx">The X-coordinate of the center of the base rectangle.</param>
 /// <param name="cy">The Y-coordinate of the center of the base rectangle.</param>
 /// <param name="spaceBetweenS">The spacing between the base rectangle and other objects.</param>
-void RenderScene::RenderBaseRectangle(
+void RenderScene::BakeBaseRectangle(
     const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
     float cx, float cy, float spaceBetweenS
@@ -203,21 +306,23 @@ void RenderScene::RenderBaseRectangle(
 {
     glm::mat3 modelMatrix = glm::mat3(1);
     modelMatrix *= Transforms2D::Translate(cx, cy + spaceBetweenS);
-    RenderMesh2D(meshes.at("rectangle"), shaders.at("VertexColor"), modelMatrix);
+    Mesh* mesh = GetMesh(baseRectangleMesh);
+    if (mesh)
+    {
+        staticBatch.Add(mesh, modelMatrix);
+    }
 }
 
 
 /// <summary>
-/// Render point scores in the inventory based on collected point score objects.
+/// Render point scores in the inventory based on the number of collected point scores.
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
-/// <param name="inventoryPointScores">A vector of PointScore objects to render.</param>
 /// <param name="pointScoreCounter">The number of point scores to render.</param>
 void RenderScene::RenderPointScoresForInventory(
     const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
-    std::vector<PointScore> inventoryPointScores,
     int pointScoreCounter
 )
 {
@@ -235,6 +340,8 @@ void RenderScene::RenderPointScoresForInventory(
 
     // Number of pointScores to render in the Inventory
     int renderPoints = pointScoreCounter > 3 ? 3 : pointScoreCounter;
+    // Every collected sun is drawn with the shared sun mesh
+    PrototypeHandle pointScoreMesh = PrototypeMeshes::GetHandle(PrototypeKind::POINT_SCORE, 0);
 
     for (int i = 0; i < renderPoints; ++i)
     {
@@ -245,30 +352,37 @@ void RenderScene::RenderPointScoresForInventory(
 
         modelMatrix *= Transforms2D::Translate(posX, posY);
         modelMatrix *= Transforms2D::Scale(GscaleHearthInINV, GscaleHearthInINV);
-        RenderMesh2D(inventoryPointScores[i].GetMesh(), shaders.at("VertexColor"), modelMatrix);
+        SubmitPrototype(LAYER_POINT_SCORES, pointScoreMesh, modelMatrix);
     }
 }
 
 /////////////////////////////// GAME SCENE IMPORTANT ELEMENTS ///////////////////////////////
 /////////////////////////////// GAME SPAWN IMPORTANT ELEMENTS ///////////////////////////////
 /// <summary>
-/// Render a zombie object if it is active.
+/// Render the zombies of the simulation, the destroyed ones are drawn while they shrink.
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
-/// <param name="zombie">The Zombie object to render.</param>
-void RenderScene::RenderZombie(
+/// <param name="zombies">The columns of the zombies to render.</param>
+/// <param name="alpha">Fraction of a tick elapsed since the last one, 1 draws the current positions.</param>
+void RenderScene::RenderZombies(
     const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
-    Zombie& zombie
+    const EntityStore& zombies,
+    float alpha
 ) 
 {
-    if (zombie.IsActive())
+    for (int i = 0; i < zombies.GetSize(); ++i)
     {
-        glm::mat3 modelMatrix = glm::mat3(1);
-        modelMatrix *= Transforms2D::Translate(zombie.GetPosition().x, zombie.GetPosition().y);
-        modelMatrix *= Transforms2D::Scale(zombie.GetScale(), zombie.GetScale());
-        RenderMesh2D(zombie.GetMesh(), shaders.at("VertexColor"), modelMatrix);
+        if (zombies.scale[i] > 0.0f)
+        {
+            PrototypeHandle mesh = PrototypeMeshes::GetHandle(PrototypeKind::ZOMBIE, zombies.colorId[i]);
+            glm::mat3 modelMatrix = glm::mat3(1);
+            float x = zombies.prevX[i] + (zombies.x[i] - zombies.prevX[i]) * alpha;
+            modelMatrix *= Transforms2D::Translate(x, zombies.y[i]);
+            modelMatrix *= Transforms2D::Scale(zombies.scale[i], zombies.scale[i]);
+            SubmitPrototype(LAYER_ZOMBIES, mesh, modelMatrix);
+        }
     }
 }
 
@@ -279,28 +393,28 @@ void RenderScene::RenderZombie(
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
-/// <param name="pointScores">A vector of PointScore objects to render.</param>
+/// <param name="pointScores">The columns of the suns to render.</param>
 void RenderScene::RenderPointScores(
     const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
-    std::vector<PointScore> pointScores
+    const EntityStore& pointScores
 ) 
 {
-    for (auto& pointScore : pointScores)
+    // All the suns share the same prototype
+    PrototypeHandle mesh = PrototypeMeshes::GetHandle(PrototypeKind::POINT_SCORE, 0);
+    if (!prototypes.GetMesh(mesh))
     {
-        if (pointScore.IsActive()) 
+        std::cerr << "Error: Mesh not found for the point scores" << std::endl;
+        return;
+    }
+
+    for (int i = 0; i < pointScores.GetSize(); ++i)
+    {
+        if (pointScores.active[i]) 
         {
-            Mesh* mesh = pointScore.GetMesh();
-            if (mesh)
-            {
-                glm::mat3 modelMatrix = glm::mat3(1);
-                modelMatrix *= Transforms2D::Translate(pointScore.GetPosition().x, pointScore.GetPosition().y);
-                RenderMesh2D(mesh, shaders.at("VertexColor"), modelMatrix);
-            }
-            else 
-            {
-                std::cerr << "Error: Mesh not found for PointScore: " << pointScore.GetName() << std::endl;
-            }
+            glm::mat3 modelMatrix = glm::mat3(1);
+            modelMatrix *= Transforms2D::Translate(pointScores.x[i], pointScores.y[i]);
+            SubmitPrototype(LAYER_POINT_SCORES, mesh, modelMatrix);
         }
     }
 }
@@ -311,107 +425,50 @@ void RenderScene::RenderPointScores(
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
-/// <param name="deltaTime">The time elapsed since the last frame.</param>
-/// <param name="resolution">The resolution of the rendering window.</param>
-/// <param name="projectiles">A vector of Projectile objects to render.</param>
+/// <param name="projectiles">The columns of the projectiles to render.</param>
+/// <param name="alpha">Fraction of a tick elapsed since the last one, 1 draws the current positions.</param>
 void RenderScene::RenderProjectiles(
     const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
-    float deltaTime, glm::ivec2 resolution,
-    std::vector<Projectile>& projectiles)
+    const EntityStore& projectiles,
+    float alpha)
 {
-    for (auto& projectile : projectiles)
+    for (int i = 0; i < projectiles.GetSize(); ++i)
     {
-        if (projectile.IsActive())
+        if (projectiles.active[i])
         {
-            // Update the projectile's position
-            projectile.Move(deltaTime, resolution);
-
-            // Check if the projectile is off-screen and deactivate it
-            if (projectile.GetPosition().x > resolution.x || projectile.GetPosition().y > resolution.y)
-            {
-                projectile.SetActive(false);
-            }
-            else
-            {
-                // Render the projectile if it's active and on-screen
-                glm::mat3 modelMatrix = glm::mat3(1);
-                glm::vec2 position = projectile.GetPosition();
-                modelMatrix *= Transforms2D::Translate(position.x, position.y);
-                modelMatrix *= Transforms2D::Rotate(projectile.GetRotation());
-                modelMatrix *= Transforms2D::Scale(projectile.GetShorterSideLength(), projectile.GetShorterSideLength());
+            PrototypeHandle mesh = PrototypeMeshes::GetHandle(PrototypeKind::PROJECTILE, projectiles.colorId[i]);
+            glm::mat3 modelMatrix = glm::mat3(1);
+            float x = projectiles.prevX[i] + (projectiles.x[i] - projectiles.prevX[i]) * alpha;
+            modelMatrix *= Transforms2D::Translate(x, projectiles.y[i]);
+            modelMatrix *= Transforms2D::Rotate(projectiles.angle[i]);
+            modelMatrix *= Transforms2D::Scale(GlengthShorterSidePJ / 5, GlengthShorterSidePJ / 5);
 
-                renderMesh2D(projectile.GetMesh(), shaders.at("VertexColor"), modelMatrix);
-            }
+            SubmitPrototype(LAYER_PROJECTILES, mesh, modelMatrix);
         }
     }
 }
 
-
 /// <summary>
-/// Render plant and projectile objects, checking for interactions and shooting capability.
+/// Render the plants on the lawn, the destroyed ones are drawn while they shrink.
 /// </summary>
 /// <param name="meshes">A map of mesh names to their corresponding Mesh objects.</param>
 /// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
 /// <param name="plants">A vector of Plant objects to render.</param>
-/// <param name="zombies">A vector of Zombie objects for interaction checking.</param>
-/// <param name="projectiles">A vector of Projectile objects for rendering and interaction.</param>
-/// <param name="numSegmentsPJ">The number of segments in the projectile.</param>
-/// <param name="lengthLongerSidePJ">The length of the longer side of the projectile.</param>
-/// <param name="lengthShorterSidePJ">The length of the shorter side of the projectile.</param>
-/// <param name="eng">A random number generator engine.</param>
-/// <param name="distr">A uniform real distribution for generating projectile speed.</param>
-/// <param name="deltaTime">The time elapsed since the last frame.</param>
-void RenderScene::RenderPlantsProjectiles(
+void RenderScene::RenderPlants(
     const std::unordered_map<std::string, Mesh*>& meshes,
     const std::unordered_map<std::string, Shader*>& shaders,
-    std::vector<Plant>& plants,
-    std::vector<Zombie>& zombies,
-    std::vector<Projectile>& projectiles,
-    //
-    float numSegmentsPJ, float lengthLongerSidePJ, float lengthShorterSidePJ,
-    std::mt19937& eng, std::uniform_real_distribution<>& distr,
-    float deltaTime
+    const std::vector<Plant>& plants
 )
 {
-    for (auto& plant : plants)
+    for (const auto& plant : plants)
     {
-        if (plant.IsActive() && plant.IsPlaced())
+        if (plant.GetScale() > 0.0f)
         {
-            plant.UpdateShootTimer(deltaTime);
-
-            bool canShoot = false;
-            for (auto& zombie : zombies)
-            {
-                if (zombie.IsActive() && zombie.GetRow() == plant.GetRow() &&
-                    glm::all(glm::equal(zombie.GetColor(), plant.GetColor(), glm::epsilon<float>())))
-                {
-                    canShoot = true;
-                    break;
-                }
-            }
-
-            if (canShoot && plant.CanShoot())
-            {
-                std::string name = "Projectile_" + plant.GetName(); // Construct a unique name for the projectile
-                float rotation = 30.0f;                             // Arbitrary rotation value for projectile
-                float speed = distr(eng);                           // Speed for the projectile
-
-                Mesh* mesh = ObjectsGame::CreateProjectile(name, 
-                                                           numSegmentsPJ,
-                                                           lengthLongerSidePJ / 5, lengthShorterSidePJ / 5,
-                                                           plant.GetColor());
-                Projectile newProjectile(mesh, plant.GetColor(), 
-                                         lengthLongerSidePJ / 5, lengthShorterSidePJ / 5,
-                                         numSegmentsPJ, name, plant.GetPosition(), rotation, true, speed);
-                projectiles.push_back(newProjectile);
-
-                plant.ResetShootTimer();
-            }
-
             glm::mat3 modelMatrix = glm::mat3(1);
             modelMatrix *= Transforms2D::Translate(plant.GetPosition().x, plant.GetPosition().y);
-            renderMesh2D(plant.GetMesh(), shaders.at("VertexColor"), modelMatrix);
+            modelMatrix *= Transforms2D::Scale(plant.GetScale(), plant.GetScale());
+            SubmitPrototype(LAYER_PLANTS, plant.GetPrototype(), modelMatrix);
         }
     }
 }
@@ -432,183 +489,11 @@ void RenderScene::RenderDraggedPlant( /* PROBLEM CAN COME FROM HERE AT DRAG & DR
 ) {
     if (dragState.isDragging && dragState.selectedPlant)
     {
-        Plant draggedPlant = *dragState.selectedPlant;
+        const Plant& draggedPlant = *dragState.selectedPlant;
         glm::mat3 modelMatrix = glm::mat3(1);
         modelMatrix *= Transforms2D::Translate(draggedPlant.GetPosition().x, draggedPlant.GetPosition().y);
         modelMatrix *= Transforms2D::Scale(draggedPlant.GetScale(), draggedPlant.GetScale());
-        renderMesh2D(draggedPlant.GetMesh(), shaders.at("VertexColor"), modelMatrix);
-    }
-}
-
-
-/// <summary>
-/// 
-/// </summary>
-/// <param name="meshes"></param>
-/// <param name="shaders"></param>
-/// <param name="plants"></param>
-/// <param name="zombies"></param>
-/// <param name="projectiles"></param>
-/// <param name="numSegmentsPJ"></param>
-/// <param name="lengthLongerSidePJ"></param>
-/// <param name="lengthShorterSidePJ"></param>
-/// <param name="eng"></param>
-/// <param name="distr"></param>
-/// <param name="resolution"></param>
-/// <param name="deltaTime"></param>
-void RenderScene::RenderDroppedPlant(
-    const std::unordered_map<std::string, Mesh*>& meshes,
-    const std::unordered_map<std::string, Shader*>& shaders,
-    std::vector<Plant>& plants,
-    std::vector<Zombie>& zombies,
-    std::vector<Projectile>& projectiles,
-    //
-    float numSegmentsPJ, float lengthLongerSidePJ, float lengthShorterSidePJ,
-    std::mt19937& eng, std::uniform_real_distribution<>& distr,
-    glm::ivec2 resolution, float deltaTime
-) {
-    if (shaders.find("VertexColor") == shaders.end()) {
-        std::cerr << "Shader 'VertexColor' not found." << std::endl;
-        return;
-    }
-
-    // Iterate over plants
-    for (auto& plant : plants) {
-        if (!plant.IsActive()) continue; // Skip inactive plants
-
-        // Check if the plant can shoot projectiles
-        bool canShoot = false;
-        for (auto& zombie : zombies) {
-            if (zombie.IsActive() && zombie.GetRow() == plant.GetRow() &&
-                glm::all(glm::equal(zombie.GetColor(), plant.GetColor(), glm::epsilon<float>()))) {
-                canShoot = true;
-                break;
-            }
-        }
-
-        if (canShoot && plant.CanShoot()) {
-            // Construct a unique name for the projectile
-            std::string name = "Projectile_" + plant.GetName();
-            // Arbitrary rotation value for projectile
-            float rotation = 30.0f;
-            // Speed for the projectile
-            float speed = distr(eng);
-
-            // Create projectile mesh
-            Mesh* mesh = ObjectsGame::CreateProjectile(name,
-                numSegmentsPJ,
-                lengthLongerSidePJ / 5, lengthShorterSidePJ / 5,
-                plant.GetColor());
-            // Create and add new projectile
-            Projectile newProjectile(mesh, plant.GetColor(),
-                lengthLongerSidePJ / 5, lengthShorterSidePJ / 5,
-                numSegmentsPJ, name, plant.GetPosition(), rotation, true, speed);
-            projectiles.push_back(newProjectile);
-
-            // Reset plant shoot timer
-            plant.ResetShootTimer();
-        }
-
-        // Render the plant
-        glm::mat3 modelMatrix = glm::mat3(1);
-        modelMatrix *= Transforms2D::Translate(plant.GetPosition().x, plant.GetPosition().y);
-        modelMatrix *= Transforms2D::Scale(plant.GetScale(), plant.GetScale());
-
-        renderMesh2D(plant.GetMesh(), shaders.at("VertexColor"), modelMatrix);
+        SubmitPrototype(LAYER_PLANTS, draggedPlant.GetPrototype(), modelMatrix);
     }
 }
 /////////////////////////////////////  DRAG AND DROP  ///////////////////////////////////////
-/////////////////////////////// ANIMATE DISSAPEARANCE OBJECTS ///////////////////////////////
-
-/// <summary>
-/// Animate the disappearance of a zombie by gradually scaling it down and rendering it.
-/// </summary>
-/// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
-/// <param name="zombie">The Zombie object to animate.</param>
-/// <param name="deltaTime">The time elapsed since the last frame.</param>
-void RenderScene::AnimateZombieDisappearance(
-    const std::unordered_map<std::string, Shader*>& shaders,
-    Zombie& zombie, float deltaTime
-) 
-{
-    if (!zombie.IsActive() && zombie.GetScale() > 0.0f)
-    {
-        float newScale = zombie.GetScale() - GfadeOutSpeedZ * deltaTime;
-        zombie.SetScale(std::max(newScale, 0.0f));
-
-        if (zombie.GetScale() <= 0.0f)
-        {
-            MarkForDeletion(zombie.GetName());
-        }
-        else 
-        {
-            // Render the zombie with reduced scale
-            glm::mat3 modelMatrix = glm::mat3(1);
-            modelMatrix *= Transforms2D::Translate(zombie.GetPosition().x, zombie.GetPosition().y);
-            modelMatrix *= Transforms2D::Scale(zombie.GetScale(), zombie.GetScale());
-            RenderMesh2D(zombie.GetMesh(), shaders.at("VertexColor"), modelMatrix);
-        }
-    }
-}
-
-
-/// <summary>
-/// Animate the disappearance of a plant by gradually scaling it down and rendering it.
-/// </summary>
-/// <param name="shaders">A map of shader names to their corresponding Shader objects.</param>
-/// <param name="plant">The Plant object to animate.</param>
-/// <param name="deltaTime">The time elapsed since the last frame.</param>
-void RenderScene::AnimatePlantDisappearance(
-    const std::unordered_map<std::string, Shader*>& shaders,
-    Plant& plant, float deltaTime
-)
-{
-    if (!plant.IsActive() && plant.GetScale() > 0.0f)
-    {
-        float newScale = plant.GetScale() - GfadeOutSpeedP * deltaTime;
-        plant.SetScale(std::max(newScale, 0.0f));
-
-        if (plant.GetScale() <= 0.0f)
-        {
-            MarkForDeletion(plant.GetName());
-        }
-        else
-        {
-            // Render the plant with reduced scale
-            glm::mat3 modelMatrix = glm::mat3(1);
-            modelMatrix *= Transforms2D::Translate(plant.GetPosition().x, plant.GetPosition().y);
-            modelMatrix *= Transforms2D::Scale(plant.GetScale(), plant.GetScale());
-            RenderMesh2D(plant.GetMesh(), shaders.at("VertexColor"), modelMatrix);
-        }
-    }
-}
-
-
-/// <summary>
-/// Mark an object for deferred deletion, which will be performed later.
-/// </summary>
-/// <param name="name">The name of the object to mark for deletion.</param>
-void RenderScene::MarkForDeletion(const std::string& name) { objectsToDelete.insert(name); }
-
-
-/// <summary>
-/// Perform free memory for the marked objects in the game scene.
-/// </summary>
-void RenderScene::DeferredDeletion()
-{
-    for (const auto& name : objectsToDelete)
-    {
-        auto meshIter = meshes.find(name);
-        if (meshIter != meshes.end())
-        {
-            if (meshIter->second)
-            {
-                delete meshIter->second;
-                meshIter->second = nullptr;
-            }
-            meshes.erase(meshIter);
-        }
-    }
-    objectsToDelete.clear();
-}
-/////////////////////////////// ANIMATE DISSAPEARANCE OBJECTS ///////////////////////////////
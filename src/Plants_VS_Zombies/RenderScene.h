@@ -3,9 +3,11 @@
 #ifndef RENDER_SCENE_H
 #define RENDER_SCENE_H
 
-#include "components/simple_scene.h"
+#include "core/gpu/mesh.h"
+#include "core/gpu/shader.h"
+#include "core/gpu/render_queue.h"
+#include "core/gpu/static_batch_2d.h"
 
-#include "Plants_VS_Zombies.h"
 #include "GameConstants.h"
 
 #include "Transforms2D.h"
@@ -16,16 +18,28 @@
 #include "Projectiles.h"
 #include "PointScore.h"
 #include "GreenSquares.h"
+#include "PrototypeMeshes.h"
+#include "EntityStore.h"
+#include "NameTable.h"
 
-#include <random>
+#include <functional>
 #include <memory>
-#include <unordered_set>
 #include <unordered_map>
 
 
-class Plants_VS_Zombies;
+// Layers of the render queue, drawn in increasing order. Everything is drawn at the same
+// depth and the depth test keeps the first fragment, so the lower layers stay on top
+enum RenderLayer : unsigned int
+{
+    LAYER_ZOMBIES = 0,
+    LAYER_POINT_SCORES,     // Suns on the lawn and collected in the inventory
+    LAYER_PLANTS,           // Inventory, lawn and dragged plants, they share their meshes
+    LAYER_PROJECTILES
+};
 
-class RenderScene : public gfxc::SimpleScene {
+// Submits the game scene to the render queue and the static batch. It owns no GL state
+// of its own, so it is built without a window, the meshes are created by GameInit.
+class RenderScene {
 public:
     using RenderMesh2DFunction = std::function<void(Mesh*, Shader*, const glm::mat3&)>;
     using AddMeshToList = std::function<void(Mesh*)>;
@@ -35,19 +49,34 @@ public:
         RenderMesh2DFunction renderMesh2D,                  // RenderMesh2D
         AddMeshToList addMeshToList,                        // AddMeshToList
         std::unordered_map<std::string, Mesh*>& meshes,
-        std::unordered_map<std::string, Shader*>& shaders
+        std::unordered_map<std::string, Shader*>& shaders,
+        const PrototypeMeshes& prototypes,                  // Meshes shared by spawned entities
+        RenderQueue& renderQueue,                           // Commands sorted and drawn at the end of the frame
+        StaticBatch2D& staticBatch                          // Lawn and inventory baked at Init phase
     ) :
         renderMesh2D(std::move(renderMesh2D)),
         addMeshToList(std::move(addMeshToList)),
-        meshes(meshes), shaders(shaders) {}
+        meshes(meshes), shaders(shaders), prototypes(prototypes),
+        renderQueue(renderQueue), staticBatch(staticBatch) {}
+
+    // Resolve the names of the lawn and inventory meshes into ids, once they are all created.
+    void ResolveMeshes(const std::unordered_map<std::string, Mesh*>& meshes);
+
+    // Shader of the commands submitted to the render queue, Instanced2D.
+    void SetSpriteShader(Shader* shader) { spriteShader = shader; }
+    // Shader of the SDF quads drawn instead of the tessellated meshes in shape mode, SDFShape.
+    void SetShapeShader(Shader* shader) { shapeShader = shader; }
+    // Draw the entities and the inventory suns and hearts as SDF quads, the inventory must be baked again.
+    void SetShapeMode(bool enabled) { useShapes = enabled && shapeShader; }
+    bool IsShapeMode() const { return useShapes; }
 
-    // Access to RenderMesh2D function
+    // Access to RenderMesh2D function, draws immediately without batching
     void RenderMesh2D(Mesh* mesh, Shader* shader, const glm::mat3& modelMatrix) {
         renderMesh2D(mesh, shader, modelMatrix); 
     }
 
-    // Render inventory slots based on provided parameters.
-    void RenderInventorySlots(
+    // Bake the inventory slots into the static batch, once at Init phase.
+    void BakeInventorySlots(
         const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
         float cx, float cy, float spaceBetweenS, int slotsINV
@@ -55,14 +84,12 @@ public:
 
     // Render plants for the inventory based on provided parameters.
     void RenderPlantsForInventory(
-        const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
-        std::unordered_map<std::string, Mesh*>& newMeshes,
-        std::vector<Plant>& inventoryPlants
+        const std::vector<Plant>& inventoryPlants
     );
 
-    // Render suns cost for plants in the inventory
-    void RenderSunsForInventory(
+    // Bake the suns cost for plants in the inventory into the static batch, once at Init phase.
+    void BakeSunsForInventory(
         const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
         float startXINV, float slotWidthINV, float paddingINV, float horizontalOffsetSUN,
@@ -75,62 +102,60 @@ public:
     void RenderPointScoresForInventory(
         const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
-        std::vector<PointScore> inventoryPointScores,
         int pointScoreCounter
     );
 
-    // Render heart icons to represent remaining lives in the 
-    void RenderHearthsForInventory(
+    // Bake every heart icon of the inventory into the static batch, once at Init phase.
+    void BakeHearthsForInventory(
         const std::unordered_map<std::string, Mesh*>& meshes,
-        const std::unordered_map<std::string, Shader*>& shaders,
-        int livesLeft
+        const std::unordered_map<std::string, Shader*>& shaders
     );
 
-    // Render projectiles in the game 
+    // Show as many baked hearts as remaining lives, the static batch changes only when a life is lost.
+    void UpdateHearthsForInventory(int livesLeft);
+
+    // Render projectiles in the game, alpha interpolates between the last two ticks
     void RenderProjectiles(
         const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
-        float deltaTime, glm::ivec2 resolution,
-        std::vector<Projectile>& projectiles
+        const EntityStore& projectiles,
+        float alpha
     );
 
-    // Render green squares for placing plants in the game scene
-    void RenderGreenSquaresForPlants(
+    // Bake the green squares for placing plants into the static batch, once at Init phase.
+    void BakeGreenSquaresForPlants(
         const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
         float cx, float cy, float spaceBetweenS, float sideS
     );
 
-    // Render the base rectangle in the game scene
-    void RenderBaseRectangle(
+    // Bake the base rectangle into the static batch, once at Init phase.
+    void BakeBaseRectangle(
         const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
         float cx, float cy, float spaceBetweenS
     );
 
-    // Render a zombie in the game scene
-    void RenderZombie(
+    // Render the zombies in the game scene, alpha interpolates between the last two ticks
+    void RenderZombies(
         const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
-        Zombie& zombie
+        const EntityStore& zombies,
+        float alpha
     );
 
     // Render point scores in the game scene
     void RenderPointScores(
         const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
-        std::vector<PointScore> pointScores
+        const EntityStore& pointScores
     );
 
-    // Render plant projectiles in the game scene
-    void RenderPlantsProjectiles(
+    // Render the plants placed on the green squares
+    void RenderPlants(
         const std::unordered_map<std::string, Mesh*>& meshes,
         const std::unordered_map<std::string, Shader*>& shaders,
-        std::vector<Plant>& plants,
-        std::vector<Zombie>& zombies,
-        std::vector<Projectile>& projectiles,
-        float numSegmentsPJ, float lengthLongerSidePJ, float lengthShorterSidePJ,
-        std::mt19937& eng, std::uniform_real_distribution<>& distr, float deltaTime
+        const std::vector<Plant>& plants
     );
 
     // Render plant from inventory dragged in the game scene
@@ -139,40 +164,35 @@ public:
         const DragState& dragState
     );
 
-    void RenderDroppedPlant(
-        const std::unordered_map<std::string, Mesh*>& meshes,
-        const std::unordered_map<std::string, Shader*>& shaders,
-        std::vector<Plant>& plants,
-        std::vector<Zombie>& zombies,
-        std::vector<Projectile>& projectiles,
-        float numSegmentsPJ, float lengthLongerSidePJ, float lengthShorterSidePJ,
-        std::mt19937& eng, std::uniform_real_distribution<>& distr, glm::ivec2 resolution, float deltaTime
-    );
-
-    // Animate the disappearance of a zombie in the game scene
-    void AnimateZombieDisappearance(
-        const std::unordered_map<std::string, Shader*>& shaders,
-        Zombie& zombie, float deltaTime
-    );
-
-    // Animate the disappearance of a plant in the game scene
-    void AnimatePlantDisappearance(
-        const std::unordered_map<std::string, Shader*>& shaders,
-        Plant& plant,
-        float deltaTime
-    );
-
-    // Mark an object for deferred deletion by name
-    void MarkForDeletion(const std::string& name);
-    // Perform deferred deletion of marked objects
-    void DeferredDeletion();
+private:
+    // Submit the prototype mesh, or its SDF quad in shape mode
+    void SubmitPrototype(RenderLayer layer, PrototypeHandle handle, const glm::mat3& modelMatrix);
+    NameId ResolveMesh(const std::unordered_map<std::string, Mesh*>& meshes, const std::string& name, bool required);
+    Mesh* GetMesh(NameId id) const;
 
 private:
     AddMeshToList addMeshToList;
     RenderMesh2DFunction renderMesh2D;
     std::unordered_map<std::string, Mesh*> meshes;
     std::unordered_map<std::string, Shader*> shaders;
-    std::unordered_set<std::string> objectsToDelete;
+    const PrototypeMeshes& prototypes;
+    RenderQueue& renderQueue;
+    StaticBatch2D& staticBatch;
+
+    // Meshes drawn every frame, looked up by id instead of by name
+    NameTable meshNames;
+    std::vector<Mesh*> meshTable;                   // Indexed by the ids of meshNames, nullptr if missing
+    std::vector<NameId> inventorySlotMeshes;        // By inventory slot
+    std::vector<NameId> sunMeshes;                  // By slot * GMaxCost + sun
+    std::vector<NameId> heartMeshes;                // By life
+    std::vector<NameId> squareMeshes;               // By col * GNUM_ROWS + row
+    NameId baseRectangleMesh = INVALID_NAME;
+    NameId sunShapeMesh = INVALID_NAME;             // SDF quads shared by the suns and hearts in shape mode
+    NameId heartShapeMesh = INVALID_NAME;
+    std::vector<int> heartItems;                    // Items of the static batch by life
+    Shader* spriteShader = nullptr;
+    Shader* shapeShader = nullptr;
+    bool useShapes = false;
 };
 
 #endif // RENDER_SCENE_H
@@ -5,47 +5,48 @@
 
 #include <glm/glm.hpp>
 
-#include "Plants.h"
-#include "Projectiles.h"
+#include "PrototypeMeshes.h"
+#include "LaneIndex.h"
+#include "EntityStore.h"
+#include "Random.h"
 
 #include <string>
 #include <vector>
 
 
-class Mesh;
-
 class Zombie 
 {
 public:
     // Constructor for Zombies
-    Zombie(const std::string& name, Mesh* mesh, glm::vec2 position,
+    Zombie(const std::string& name, PrototypeHandle prototype, glm::vec2 position,
             float scale, float inRadius, float outRadius,
             glm::vec3 color, float speed, int row);
     ~Zombie();
 
-    // Zombie position is changing based on its speed & the elapsed time.
-    void Move(float deltaTime);
     // Zombie is hit by a projectile.
     void Hit();
     // Zombie has been destroyed, hit by 3 times.
     bool IsDestroyed() const;
 
     // Determine if a new zombie should be spawned.
-    static bool ShouldSpawnZombie(float deltaTime);
+    static bool ShouldSpawnZombie(float& spawnTimer, float deltaTime);
     // Spawn a zombie at a specific row.
-    static void SpawnZombieAtRow(int row, const glm::ivec2& resolution, std::vector<Zombie>& zombies);
-    // Spawn zombies at random rows.
-    static void SpawnRandomZombies(float deltaTimeSeconds, const glm::ivec2& resolution, std::vector<Zombie>& zombies);
-
-    // Collision detection methods
-    bool IsIntersectingWithRectangle(const glm::vec2& corner, float widthR, float heightR) const;
-    bool IsCollidingWithProjectile(const Projectile& projectile) const;
-    bool IsCollidingWithPlant(const Plant& plant) const;
+    static void SpawnZombieAtRow(int row, const glm::ivec2& resolution, EntityStore& zombies, Random& random);
+    // Spawn zombies at random rows among the first numRows.
+    static void SpawnRandomZombies(float& spawnTimer, float deltaTimeSeconds, const glm::ivec2& resolution,
+                                   int numRows, EntityStore& zombies, Random& random);
+    // Register the active zombies in the lanes of their row, sorted by x.
+    static void BuildLaneIndex(const EntityStore& zombies, LaneIndex& lanes);
+
+    // Collision tests of the zombie columns of an EntityStore
+    static bool IsCircleIntersectingRectangle(const glm::vec2& center, float radius,
+                                              const glm::vec2& corner, float widthR, float heightR);
+    static bool IsOverlapping(const glm::vec2& center, float radius, const glm::vec2& other, float otherSize);
 
     // Getters
     glm::vec2 GetPosition() const;
     glm::vec3 GetColor() const;
-    Mesh* GetMesh() const;
+    PrototypeHandle GetPrototype() const;
     float GetScale() const;
     float GetOutRadius() const;
     std::string GetName() const;
@@ -55,13 +56,12 @@ public:
 
     // Setters
     void SetScale(float newScale);
-    void SetMesh(Mesh* newMesh);
     void SetActive(bool isActive);
     void SetRow(int row);
 
 private:
     std::string name;
-    Mesh* mesh;
+    PrototypeHandle prototype;  // Shared mesh, one per zombie color
     glm::vec2 position;
     glm::vec3 color;
 
@@ -75,8 +75,6 @@ private:
 
     float innerRadius;       // Inner radius for collision detection
     float outerRadius;       // Outer radius for collision detection
-
-    static float spawnTimer; // Timer for controlling zombie spawn
 };
 
 #endif // ZOMBIES_H
@@ -6,6 +6,8 @@
 #include "components/camera_input.h"
 #include "components/scene_input.h"
 #include "components/transform.h"
+#include "core/gpu/camera_buffer.h"
+#include "core/gpu/gl_state.h"
 
 using namespace gfxc;
 
@@ -54,7 +56,8 @@ void SimpleScene::InitResources()
     (void)SI;
 
     xozPlane = new Mesh("plane");
-    xozPlane->LoadMesh(PATH_JOIN(window->props.selfDir, RESOURCE_PATH::MODELS, "primitives"), "plane50.obj");
+    // Drawn once loaded, the window shows up meanwhile
+    xozPlaneLoad = xozPlane->LoadMeshAsync(PATH_JOIN(window->props.selfDir, RESOURCE_PATH::MODELS, "primitives"), "plane50.obj");
 
     {
         std::vector<VertexFormat> vertices =
@@ -107,7 +110,7 @@ void SimpleScene::InitResources()
 
     // Default rendering mode will use depth buffer
     glDepthMask(GL_TRUE);
-    glEnable(GL_DEPTH_TEST);
+    GLState::Enable(GL_DEPTH_TEST);
 }
 
 
@@ -129,16 +132,15 @@ void SimpleScene::DrawCoordinateSystem()
 void SimpleScene::DrawCoordinateSystem(const glm::mat4 & viewMatrix, const glm::mat4 & projectionMaxtix)
 {
     glLineWidth(1);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    GLState::PolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
     // Render the coordinate system
     {
         Shader *shader = shaders["Color"];
         shader->Use();
-        glUniformMatrix4fv(shader->loc_view_matrix, 1, GL_FALSE, glm::value_ptr(viewMatrix));
-        glUniformMatrix4fv(shader->loc_projection_matrix, 1, GL_FALSE, glm::value_ptr(projectionMaxtix));
+        CameraBuffer::Update(viewMatrix, projectionMaxtix);
 
-        if (drawGroundPlane)
+        if (drawGroundPlane && xozPlaneLoad->Succeeded())
         {
             objectModel->SetScale(glm::vec3(1));
             objectModel->SetWorldPosition(glm::vec3(0));
@@ -147,7 +149,7 @@ void SimpleScene::DrawCoordinateSystem(const glm::mat4 & viewMatrix, const glm::
             xozPlane->Render();
         }
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        GLState::PolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
         glLineWidth(3);
         objectModel->SetScale(glm::vec3(1, 25, 1));
@@ -180,8 +182,7 @@ void SimpleScene::RenderMesh(Mesh * mesh, Shader * shader, glm::vec3 position, g
 
     // Render an object using the specified shader and the specified position
     shader->Use();
-    glUniformMatrix4fv(shader->loc_view_matrix, 1, GL_FALSE, glm::value_ptr(camera->GetViewMatrix()));
-    glUniformMatrix4fv(shader->loc_projection_matrix, 1, GL_FALSE, glm::value_ptr(camera->GetProjectionMatrix()));
+    CameraBuffer::Update(camera->GetViewMatrix(), camera->GetProjectionMatrix());
 
     glm::mat4 model(1);
     model = glm::translate(model, position);
@@ -203,8 +204,7 @@ void SimpleScene::RenderMesh2D(Mesh * mesh, Shader * shader, const glm::mat3 &mo
         return;
 
     shader->Use();
-    glUniformMatrix4fv(shader->loc_view_matrix, 1, GL_FALSE, glm::value_ptr(camera->GetViewMatrix()));
-    glUniformMatrix4fv(shader->loc_projection_matrix, 1, GL_FALSE, glm::value_ptr(camera->GetProjectionMatrix()));
+    CameraBuffer::Update(camera->GetViewMatrix(), camera->GetProjectionMatrix());
 
     glm::mat3 mm = modelMatrix;
     glm::mat4 model = glm::mat4(
@@ -234,8 +234,7 @@ void SimpleScene::RenderMesh2D(Mesh * mesh, const glm::mat3 & modelMatrix, const
 
     // Render an object using the specified shader and the specified position
     shader->Use();
-    glUniformMatrix4fv(shader->loc_view_matrix, 1, GL_FALSE, glm::value_ptr(camera->GetViewMatrix()));
-    glUniformMatrix4fv(shader->loc_projection_matrix, 1, GL_FALSE, glm::value_ptr(camera->GetProjectionMatrix()));
+    CameraBuffer::Update(camera->GetViewMatrix(), camera->GetProjectionMatrix());
     glUniformMatrix4fv(shader->loc_model_matrix, 1, GL_FALSE, glm::value_ptr(model));
     glUniform3f(shader->GetUniformLocation("color"), color.r, color.g, color.b);
 
@@ -250,8 +249,7 @@ void SimpleScene::RenderMesh(Mesh * mesh, Shader * shader, const glm::mat4 & mod
 
     // Render an object using the specified shader and the specified position
     shader->Use();
-    glUniformMatrix4fv(shader->loc_view_matrix, 1, GL_FALSE, glm::value_ptr(camera->GetViewMatrix()));
-    glUniformMatrix4fv(shader->loc_projection_matrix, 1, GL_FALSE, glm::value_ptr(camera->GetProjectionMatrix()));
+    CameraBuffer::Update(camera->GetViewMatrix(), camera->GetProjectionMatrix());
     glUniformMatrix4fv(shader->loc_model_matrix, 1, GL_FALSE, glm::value_ptr(modelMatrix));
 
     mesh->Render();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -10,6 +11,7 @@
 #include "core/gpu/mesh.h"
 #include "core/gpu/shader.h"
 #include "core/gpu/texture2D.h"
+#include "core/managers/resource_loader.h"
 #include "core/managers/resource_path.h"
 #include "core/managers/texture_manager.h"
 
@@ -72,6 +74,7 @@ namespace gfxc
 
         bool drawGroundPlane;
         Mesh *xozPlane;
+        std::shared_ptr<LoadHandle> xozPlaneLoad;
         Mesh *simpleLine;
         Transform *objectModel;
     };
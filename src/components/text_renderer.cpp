@@ -8,18 +8,28 @@
 ******************************************************************/
 #include "components/text_renderer.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include "utils/text_utils.h"
 #include "glm/gtc/matrix_transform.hpp"
 #include "core/managers/resource_path.h"
+#include "core/gpu/gl_state.h"
 
 #include "ft2build.h"
 #include FT_FREETYPE_H
 
 
 gfxc::TextRenderer::TextRenderer(const std::string &selfDir, GLuint width, GLuint height)
+    : VAO(0), VBO(0), m_vboCapacity(0), m_atlasTexture(0), m_locTextColor(-1)
 {
+    // No glyph until Load, the characters draw nothing
+    for (auto &character : Characters)
+    {
+        character = Character{ glm::vec2(0), glm::vec2(0), glm::ivec2(0), glm::ivec2(0), 0 };
+    }
+
     // Load and configure shader
     Shader *shader = new Shader("ShaderText");
     shader->AddShader(PATH_JOIN(selfDir, RESOURCE_PATH::SHADERS, "Text.VS.glsl"), GL_VERTEX_SHADER);
@@ -34,23 +44,41 @@ gfxc::TextRenderer::TextRenderer(const std::string &selfDir, GLuint width, GLuin
     int loc_text = glGetUniformLocation(shader->program, "text");
     glUniform1i(loc_text, 0);
 
-    // Configure VAO/VBO for texture quads
+    m_locTextColor = glGetUniformLocation(shader->program, "textColor");
+
+    // Configure VAO/VBO for texture quads, the VBO grows with the longest string drawn
     glGenVertexArrays(1, &this->VAO);
     glGenBuffers(1, &this->VBO);
-    glBindVertexArray(this->VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+    GLState::BindVertexArray(this->VAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, this->VBO);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::BindVertexArray(0);
+}
+
+
+gfxc::TextRenderer::~TextRenderer()
+{
+    GLState::DeleteTextures(1, &m_atlasTexture);
+    GLState::DeleteBuffers(1, &VBO);
+    GLState::DeleteVertexArrays(1, &VAO);
+    delete m_textShader;
 }
 
 
 void gfxc::TextRenderer::Load(std::string font, GLuint fontSize)
 {
+    // Atlas width in pixels, the height follows the number of glyph rows.
+    // The glyphs are one pixel apart so the linear filtering does not bleed between them
+    const int atlasWidth = 512;
+    const int padding = 1;
+
     // First clear the previously loaded Characters
-    this->Characters.clear();
+    for (auto &character : Characters)
+    {
+        character = Character{ glm::vec2(0), glm::vec2(0), glm::ivec2(0), glm::ivec2(0), 0 };
+    }
 
     // Initialize and load the freetype library. All freetype functions
     // return a value different than 0 whenever an error occurs.
@@ -59,6 +87,7 @@ void gfxc::TextRenderer::Load(std::string font, GLuint fontSize)
     if (FT_Init_FreeType(&ft))
     {
         std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+        return;
     }
 
     // Load font as face
@@ -66,16 +95,20 @@ void gfxc::TextRenderer::Load(std::string font, GLuint fontSize)
     if (FT_New_Face(ft, font.c_str(), 0, &face))
     {
         std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+        FT_Done_FreeType(ft);
+        return;
     }
 
     // Set size to load glyphs as
     FT_Set_Pixel_Sizes(face, 0, fontSize);
 
-    // Disable byte-alignment restriction
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    // Then for the first 128 ASCII characters, pre-load/compile their characters and
+    // place them on shelves, left to right, a new shelf when the current one is full
+    std::vector<std::vector<unsigned char>> bitmaps(NUM_CHARACTERS);
+    std::vector<glm::ivec2> positions(NUM_CHARACTERS);
+    int penX = padding, penY = padding, shelfHeight = 0;
 
-    // Then for the first 128 ASCII characters, pre-load/compile their characters and store them
-    for (GLubyte c = 0; c < 128; c++)
+    for (int c = 0; c < NUM_CHARACTERS; c++)
     {
         // Load character glyph 
         if (FT_Load_Char(face, c, FT_LOAD_RENDER))
@@ -84,106 +117,149 @@ void gfxc::TextRenderer::Load(std::string font, GLuint fontSize)
             continue;
         }
 
-        // Generate texture
-        GLuint texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-        );
-
-        // Set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        // Now store character for later use
-        Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+        const FT_Bitmap &bitmap = face->glyph->bitmap;
+        int width = static_cast<int>(bitmap.width);
+        int rows = static_cast<int>(bitmap.rows);
+
+        if (penX + width + padding > atlasWidth)
+        {
+            penX = padding;
+            penY += shelfHeight + padding;
+            shelfHeight = 0;
+        }
+        positions[c] = glm::ivec2(penX, penY);
+        penX += width + padding;
+        shelfHeight = std::max(shelfHeight, rows);
+
+        // Copy the rows, the pitch of the FreeType bitmap may differ from its width
+        bitmaps[c].resize(width * rows);
+        for (int row = 0; row < rows; row++)
+        {
+            memcpy(&bitmaps[c][row * width], bitmap.buffer + row * bitmap.pitch, width);
+        }
+
+        // Now store character for later use, the texture coordinates are set once the atlas size is known
+        Characters[c] = Character{
+            glm::vec2(0),
+            glm::vec2(0),
+            glm::ivec2(width, rows),
             glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
             (GLuint)face->glyph->advance.x
         };
-
-        Characters.insert(std::pair<GLchar, Character>(c, character));
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     // Destroy freetype once we're finished
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
-}
 
-
-void gfxc::TextRenderer::RenderText(std::string text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color)
-{
-    // Activate corresponding render state    
-    if (this->m_textShader)
+    // Copy every glyph into the atlas image
+    int atlasHeight = penY + shelfHeight + padding;
+    std::vector<unsigned char> atlas(atlasWidth * atlasHeight, 0);
+    for (int c = 0; c < NUM_CHARACTERS; c++)
     {
-        glUseProgram(this->m_textShader->program);
-        CheckOpenGLError();
+        Character &character = Characters[c];
+        for (int row = 0; row < character.Size.y; row++)
+        {
+            memcpy(&atlas[(positions[c].y + row) * atlasWidth + positions[c].x],
+                &bitmaps[c][row * character.Size.x], character.Size.x);
+        }
+
+        character.UvMin = glm::vec2(positions[c]) / glm::vec2(atlasWidth, atlasHeight);
+        character.UvMax = glm::vec2(positions[c] + character.Size) / glm::vec2(atlasWidth, atlasHeight);
     }
 
-    // TODO(developer): Update this class
-    int loc_text_color = glGetUniformLocation(this->m_textShader->program, "textColor");
-    glUniform3f(loc_text_color, color.r, color.g, color.b);
+    // Generate texture, a single one for the whole font
+    if (!m_atlasTexture)
+        glGenTextures(1, &m_atlasTexture);
+    GLState::BindTexture(GL_TEXTURE_2D, m_atlasTexture);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(this->VAO);
+    // Disable byte-alignment restriction
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlasWidth, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, &atlas[0]);
+
+    // Set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    // Iterate through all characters
-    for (auto c = text.cbegin(); c != text.cend(); c++)
+    GLState::BindTexture(GL_TEXTURE_2D, 0);
+}
+
+
+void gfxc::TextRenderer::RenderText(const std::string &text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color)
+{
+    if (!this->m_textShader || !this->m_textShader->program || !m_atlasTexture)
+        return;
+
+    // Build the quads of every character, two triangles each
+    m_vertices.clear();
+    const Character &reference = Characters['H'];
+
+    for (char c : text)
     {
-        Character ch = Characters[*c];
+        unsigned char code = static_cast<unsigned char>(c);
+        if (code >= NUM_CHARACTERS)
+            continue;
+
+        const Character &ch = Characters[code];
 
         GLfloat xpos = x + ch.Bearing.x * scale;
-        GLfloat ypos = y + (this->Characters['H'].Bearing.y - ch.Bearing.y) * scale;
+        GLfloat ypos = y + (reference.Bearing.y - ch.Bearing.y) * scale;
 
         GLfloat w = ch.Size.x * scale;
         GLfloat h = ch.Size.y * scale;
 
-        // Update VBO for each character
-        GLfloat vertices[6][4] = {
-            { xpos,     ypos + h,   0.0, 1.0 },
-            { xpos + w, ypos,       1.0, 0.0 },
-            { xpos,     ypos,       0.0, 0.0 },
+        // Now advance cursors for next glyph. Bitshift by 6
+        // to get value in pixels.
+        x += (ch.Advance >> 6) * scale;
 
-            { xpos,     ypos + h,   0.0, 1.0 },
-            { xpos + w, ypos + h,   1.0, 1.0 },
-            { xpos + w, ypos,       1.0, 0.0 }
-        };
+        // Spaces and control characters have no pixel
+        if (ch.Size.x == 0 || ch.Size.y == 0)
+            continue;
 
-        // Render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
+        const GLfloat quad[6][4] = {
+            { xpos,     ypos + h,   ch.UvMin.x, ch.UvMax.y },
+            { xpos + w, ypos,       ch.UvMax.x, ch.UvMin.y },
+            { xpos,     ypos,       ch.UvMin.x, ch.UvMin.y },
 
-        // Update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); // Be sure to use glBufferSubData and not glBufferData
+            { xpos,     ypos + h,   ch.UvMin.x, ch.UvMax.y },
+            { xpos + w, ypos + h,   ch.UvMax.x, ch.UvMax.y },
+            { xpos + w, ypos,       ch.UvMax.x, ch.UvMin.y }
+        };
+        m_vertices.insert(m_vertices.end(), &quad[0][0], &quad[0][0] + 6 * 4);
+    }
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (m_vertices.empty())
+        return;
 
-        // Render quad
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        glDisable(GL_BLEND);
+    // Activate corresponding render state    
+    GLState::UseProgram(this->m_textShader->program);
+    glUniform3f(m_locTextColor, color.r, color.g, color.b);
 
-        // Now advance cursors for next glyph. Bitshift by 6
-        // to get value in pixels.
-        x += (ch.Advance >> 6) * scale; 
-    }
+    GLState::ActiveTexture(GL_TEXTURE0);
+    GLState::BindTexture(GL_TEXTURE_2D, m_atlasTexture);
+    GLState::BindVertexArray(this->VAO);
 
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // Grow the buffer geometrically, otherwise orphan and refill it
+    GLsizeiptr size = sizeof(GLfloat) * m_vertices.size();
+    GLState::BindBuffer(GL_ARRAY_BUFFER, this->VBO);
+    if (size > m_vboCapacity)
+    {
+        m_vboCapacity = std::max(size, m_vboCapacity * 2);
+    }
+    glBufferData(GL_ARRAY_BUFFER, m_vboCapacity, NULL, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, &m_vertices[0]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Render every quad at once
+    GLState::PolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    GLState::Enable(GL_BLEND);
+    GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size() / 4));
+    GLState::Disable(GL_BLEND);
+
+    GLState::BindVertexArray(0);
+    GLState::BindTexture(GL_TEXTURE_2D, 0);
+    CheckOpenGLError();
 }
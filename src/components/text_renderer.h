@@ -9,8 +9,8 @@
 #ifndef TEXT_RENDERER_H
 #define TEXT_RENDERER_H
 
-#include <map>
 #include <string>
+#include <vector>
 
 #include "GL/glew.h"
 #include "glm/glm.hpp"
@@ -25,7 +25,8 @@ namespace gfxc
     /// Holds all state information relevant to a character as loaded using FreeType
     struct Character
     {
-        GLuint TextureID;   // ID handle of the glyph texture
+        glm::vec2 UvMin;    // Top-left corner of the glyph inside the atlas, in texture coordinates
+        glm::vec2 UvMax;    // Bottom-right corner of the glyph inside the atlas
         glm::ivec2 Size;    // Size of glyph
         glm::ivec2 Bearing; // Offset from baseline to left/top of glyph
         GLuint Advance;     // Horizontal offset to advance to next glyph
@@ -33,13 +34,17 @@ namespace gfxc
 
 
     // A renderer class for rendering text displayed by a font loaded using the 
-    // FreeType library. A single font is loaded, processed into a list of Character
-    // items for later rendering.
+    // FreeType library. A single font is loaded, its glyphs are packed into one
+    // atlas texture. Each string is built into one vertex buffer and drawn with
+    // a single draw call, whatever its length.
     class TextRenderer
     {
      public:
-        // Holds a list of pre-compiled Characters
-        std::map<GLchar, Character> Characters;
+        // Number of pre-compiled characters, the first ASCII ones
+        static const int NUM_CHARACTERS = 128;
+
+        // Holds the pre-compiled Characters, indexed by their code
+        Character Characters[NUM_CHARACTERS];
 
         // Shader used for text rendering
         Shader *m_textShader;
@@ -47,16 +52,21 @@ namespace gfxc
         public:
         // Constructor
         TextRenderer(const std::string &selfDir, GLuint width, GLuint height);
+        ~TextRenderer();
 
-        // Pre-compiles a list of characters from the given font
+        // Pre-compiles the characters of the given font into the atlas
         void Load(std::string font, GLuint fontSize);
 
-        // Renders a string of text using the precompiled list of characters
-        void RenderText(std::string text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color = glm::vec3(1.0f));
+        // Renders a string of text using the precompiled characters, one draw call
+        void RenderText(const std::string &text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color = glm::vec3(1.0f));
         
      private:
         // Render state
         GLuint VAO, VBO;
+        GLsizeiptr m_vboCapacity;       // Size in bytes of VBO
+        GLuint m_atlasTexture;          // Every glyph of the font, one channel
+        GLint m_locTextColor;
+        std::vector<GLfloat> m_vertices;    // Quads of the string being drawn, kept to avoid allocations
     };
 }
 
@@ -2,8 +2,13 @@
 
 #include <iostream>
 
+#include "core/gpu/camera_buffer.h"
+#include "core/gpu/program_cache.h"
+#include "core/jobs/job_system.h"
+#include "core/managers/resource_loader.h"
 #include "core/managers/texture_manager.h"
 #include "utils/gl_utils.h"
+#include "utils/text_utils.h"
 
 
 WindowObject* Engine::window = nullptr;
@@ -26,6 +31,13 @@ WindowObject* Engine::Init(const WindowProperties & props)
         exit(0);
     }
 
+    // Linked programs of the previous runs, the scenes skip compiling their shaders
+    ProgramCache::Init(PATH_JOIN(window->props.selfDir, "program_cache.bin"));
+
+    // One worker per core besides this thread, which keeps the OpenGL context
+    JobSystem::Init();
+
+    // The textures are decoded by the workers
     TextureManager::Init(window->props.selfDir);
 
     return window;
@@ -42,6 +54,10 @@ void Engine::Exit()
 {
     std::cout << "=====================================================" << std::endl;
     std::cout << "Engine closed. Exit" << std::endl;
+    JobSystem::Shutdown();
+    ResourceLoader::Shutdown();
+    CameraBuffer::Release();
+    ProgramCache::Save();
     glfwTerminate();
 }
 
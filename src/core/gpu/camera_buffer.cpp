@@ -0,0 +1,63 @@
+#include "core/gpu/camera_buffer.h"
+
+#include <cstring>
+
+#include "core/gpu/gl_state.h"
+
+
+const char *const CameraBuffer::BLOCK_NAME = "Camera";
+
+GLuint CameraBuffer::buffer = 0;
+CameraBuffer::Block CameraBuffer::block;
+unsigned int CameraBuffer::uploadCount = 0;
+
+
+void CameraBuffer::Update(const glm::mat4 &view, const glm::mat4 &projection)
+{
+    if (buffer == 0)
+    {
+        glGenBuffers(1, &buffer);
+        GLState::BindBuffer(GL_UNIFORM_BUFFER, buffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), nullptr, GL_DYNAMIC_DRAW);
+        GLState::BindBufferBase(GL_UNIFORM_BUFFER, BINDING, buffer);
+    }
+    else if (memcmp(&block.view, &view, sizeof(view)) == 0
+          && memcmp(&block.projection, &projection, sizeof(projection)) == 0)
+    {
+        return;
+    }
+
+    block.view = view;
+    block.projection = projection;
+
+    GLState::BindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Block), &block);
+    GLState::BindBuffer(GL_UNIFORM_BUFFER, 0);
+    uploadCount++;
+    CheckOpenGLError();
+}
+
+
+void CameraBuffer::BindBlock(GLuint program)
+{
+    // GLSL 330 has no binding layout qualifier for the blocks
+    GLuint index = glGetUniformBlockIndex(program, BLOCK_NAME);
+    if (index != GL_INVALID_INDEX)
+        glUniformBlockBinding(program, index, BINDING);
+}
+
+
+void CameraBuffer::Release()
+{
+    if (buffer)
+    {
+        GLState::DeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+}
+
+
+unsigned int CameraBuffer::GetUploadCount()
+{
+    return uploadCount;
+}
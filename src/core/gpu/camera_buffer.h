@@ -0,0 +1,45 @@
+#pragma once
+
+#include "utils/gl_utils.h"
+#include "utils/glm_utils.h"
+
+
+// View and projection matrices shared by every program through a std140 uniform buffer,
+// bound once at BINDING. The shaders declare the block as
+//
+//   layout(std140) uniform Camera
+//   {
+//       mat4 View;
+//       mat4 Projection;
+//   };
+//
+// and Shader binds it after linking. The matrices are uploaded only when they differ
+// from the ones in the buffer, a still camera costs no upload at all.
+class CameraBuffer
+{
+ public:
+    static const GLuint BINDING = 0;
+    static const char *const BLOCK_NAME;
+
+    // Upload the matrices if they changed, needs the OpenGL context
+    static void Update(const glm::mat4 &view, const glm::mat4 &projection);
+    // Bind the Camera block of the program, if it has one, to BINDING
+    static void BindBlock(GLuint program);
+    static void Release();
+
+    // Uploads done since the start, to check a still camera is uploaded once
+    static unsigned int GetUploadCount();
+
+ private:
+    // std140: a mat4 is 4 aligned vec4 columns, the block is 128 bytes without padding
+    struct Block
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+    };
+
+ private:
+    static GLuint buffer;
+    static Block block;
+    static unsigned int uploadCount;
+};
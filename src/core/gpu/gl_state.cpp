@@ -0,0 +1,274 @@
+#include "core/gpu/gl_state.h"
+
+
+GLuint GLState::program = GLState::UNKNOWN;
+GLuint GLState::vertexArray = GLState::UNKNOWN;
+GLuint GLState::buffers[NUM_TRACKED_BUFFERS] = { UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN };
+GLuint GLState::activeUnit = GLState::UNKNOWN;
+GLuint GLState::textures[MAX_TEXTURE_UNITS] = {
+    UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN,
+    UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN
+};
+GLuint GLState::capabilities[NUM_TRACKED_CAPABILITIES] = { UNKNOWN, UNKNOWN, UNKNOWN };
+GLuint GLState::blendSource = GLState::UNKNOWN;
+GLuint GLState::blendDestination = GLState::UNKNOWN;
+GLuint GLState::polygonMode = GLState::UNKNOWN;
+
+GLState::Stats GLState::frameStats = GLState::Stats();
+GLState::Stats GLState::lastFrameStats = GLState::Stats();
+
+
+unsigned int GLState::Stats::GetCalls() const
+{
+    unsigned int total = 0;
+    for (int i = 0; i < NUM_CATEGORIES; i++)
+        total += calls[i];
+    return total;
+}
+
+
+unsigned int GLState::Stats::GetRedundant() const
+{
+    unsigned int total = 0;
+    for (int i = 0; i < NUM_CATEGORIES; i++)
+        total += redundant[i];
+    return total;
+}
+
+
+bool GLState::Changes(Category category, bool changed)
+{
+    if (changed)
+        frameStats.calls[category]++;
+    else
+        frameStats.redundant[category]++;
+    return changed;
+}
+
+
+void GLState::UseProgram(GLuint program)
+{
+    if (!Changes(PROGRAM, GLState::program != program))
+        return;
+
+    glUseProgram(program);
+    GLState::program = program;
+}
+
+
+void GLState::BindVertexArray(GLuint vertexArray)
+{
+    if (!Changes(VERTEX_ARRAY, GLState::vertexArray != vertexArray))
+        return;
+
+    glBindVertexArray(vertexArray);
+    GLState::vertexArray = vertexArray;
+}
+
+
+int GLState::GetBufferSlot(GLenum target)
+{
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:           return ARRAY_BUFFER;
+    case GL_UNIFORM_BUFFER:         return UNIFORM_BUFFER;
+    case GL_SHADER_STORAGE_BUFFER:  return SHADER_STORAGE_BUFFER;
+    case GL_PIXEL_UNPACK_BUFFER:    return PIXEL_UNPACK_BUFFER;
+    default:                        return -1;
+    }
+}
+
+
+void GLState::BindBuffer(GLenum target, GLuint buffer)
+{
+    int slot = GetBufferSlot(target);
+    if (!Changes(BUFFER, slot < 0 || buffers[slot] != buffer))
+        return;
+
+    glBindBuffer(target, buffer);
+    if (slot >= 0)
+        buffers[slot] = buffer;
+}
+
+
+void GLState::BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    Changes(BUFFER, true);
+    glBindBufferBase(target, index, buffer);
+
+    int slot = GetBufferSlot(target);
+    if (slot >= 0)
+        buffers[slot] = buffer;
+}
+
+
+void GLState::ActiveTexture(GLenum unit)
+{
+    GLuint index = unit - GL_TEXTURE0;
+    if (!Changes(TEXTURE, activeUnit != index))
+        return;
+
+    glActiveTexture(unit);
+    activeUnit = index;
+}
+
+
+void GLState::BindTexture(GLenum target, GLuint texture)
+{
+    // Unknown unit, the binding cannot be compared
+    bool tracked = target == GL_TEXTURE_2D && activeUnit < static_cast<GLuint>(MAX_TEXTURE_UNITS);
+    if (!Changes(TEXTURE, !tracked || textures[activeUnit] != texture))
+        return;
+
+    glBindTexture(target, texture);
+    if (tracked)
+        textures[activeUnit] = texture;
+}
+
+
+void GLState::BindTextureUnit(GLenum unit, GLuint texture)
+{
+    ActiveTexture(unit);
+    BindTexture(GL_TEXTURE_2D, texture);
+}
+
+
+int GLState::GetCapabilitySlot(GLenum capability)
+{
+    switch (capability)
+    {
+    case GL_BLEND:          return BLEND;
+    case GL_DEPTH_TEST:     return DEPTH_TEST;
+    case GL_CULL_FACE:      return CULL_FACE;
+    default:                return -1;
+    }
+}
+
+
+void GLState::SetCapability(GLenum capability, bool enabled)
+{
+    int slot = GetCapabilitySlot(capability);
+    if (!Changes(RASTER, slot < 0 || capabilities[slot] != static_cast<GLuint>(enabled)))
+        return;
+
+    if (enabled)
+        glEnable(capability);
+    else
+        glDisable(capability);
+    if (slot >= 0)
+        capabilities[slot] = enabled;
+}
+
+
+void GLState::Enable(GLenum capability)
+{
+    SetCapability(capability, true);
+}
+
+
+void GLState::Disable(GLenum capability)
+{
+    SetCapability(capability, false);
+}
+
+
+void GLState::BlendFunc(GLenum sourceFactor, GLenum destinationFactor)
+{
+    if (!Changes(RASTER, blendSource != sourceFactor || blendDestination != destinationFactor))
+        return;
+
+    glBlendFunc(sourceFactor, destinationFactor);
+    blendSource = sourceFactor;
+    blendDestination = destinationFactor;
+}
+
+
+void GLState::PolygonMode(GLenum face, GLenum mode)
+{
+    // The core profile only accepts GL_FRONT_AND_BACK
+    bool tracked = face == GL_FRONT_AND_BACK;
+    if (!Changes(RASTER, !tracked || polygonMode != mode))
+        return;
+
+    glPolygonMode(face, mode);
+    polygonMode = tracked ? mode : UNKNOWN;
+}
+
+
+void GLState::DeleteProgram(GLuint program)
+{
+    glDeleteProgram(program);
+    // A current program is only deleted once replaced, but its name is not known to be in use anymore
+    if (GLState::program == program)
+        GLState::program = UNKNOWN;
+}
+
+
+void GLState::DeleteVertexArrays(GLsizei count, const GLuint *vertexArrays)
+{
+    glDeleteVertexArrays(count, vertexArrays);
+    // Deleting the bound vertex array binds 0
+    for (GLsizei i = 0; i < count; i++)
+    {
+        if (vertexArray == vertexArrays[i])
+            vertexArray = 0;
+    }
+}
+
+
+void GLState::DeleteBuffers(GLsizei count, const GLuint *buffers)
+{
+    glDeleteBuffers(count, buffers);
+    for (GLsizei i = 0; i < count; i++)
+    {
+        for (int slot = 0; slot < NUM_TRACKED_BUFFERS; slot++)
+        {
+            if (GLState::buffers[slot] == buffers[i])
+                GLState::buffers[slot] = 0;
+        }
+    }
+}
+
+
+void GLState::DeleteTextures(GLsizei count, const GLuint *textures)
+{
+    glDeleteTextures(count, textures);
+    for (GLsizei i = 0; i < count; i++)
+    {
+        for (int unit = 0; unit < MAX_TEXTURE_UNITS; unit++)
+        {
+            if (GLState::textures[unit] == textures[i])
+                GLState::textures[unit] = 0;
+        }
+    }
+}
+
+
+void GLState::Invalidate()
+{
+    program = UNKNOWN;
+    vertexArray = UNKNOWN;
+    activeUnit = UNKNOWN;
+    blendSource = UNKNOWN;
+    blendDestination = UNKNOWN;
+    polygonMode = UNKNOWN;
+    for (int i = 0; i < NUM_TRACKED_BUFFERS; i++)
+        buffers[i] = UNKNOWN;
+    for (int i = 0; i < MAX_TEXTURE_UNITS; i++)
+        textures[i] = UNKNOWN;
+    for (int i = 0; i < NUM_TRACKED_CAPABILITIES; i++)
+        capabilities[i] = UNKNOWN;
+}
+
+
+void GLState::BeginFrame()
+{
+    lastFrameStats = frameStats;
+    frameStats = Stats();
+}
+
+
+const GLState::Stats &GLState::GetLastFrameStats()
+{
+    return lastFrameStats;
+}
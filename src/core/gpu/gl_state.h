@@ -0,0 +1,107 @@
+#pragma once
+
+#include "utils/gl_utils.h"
+
+
+// Shadow of the OpenGL state most often set by the draws: program, vertex array, buffers,
+// 2D textures per unit, blending, depth test, face culling and polygon mode. A change to the
+// value already set is skipped instead of reaching the driver, where every call costs,
+// especially with the software drivers. The functions mirror the GL calls they replace,
+// every change of the tracked state must go through them or the shadow goes stale;
+// Invalidate forgets it after code that calls GL directly.
+// The deletions are tracked too: a deleted name may be handed out again by the driver.
+class GLState
+{
+ public:
+    static const int MAX_TEXTURE_UNITS = 16;
+
+    enum Category
+    {
+        PROGRAM = 0,
+        VERTEX_ARRAY,
+        BUFFER,
+        TEXTURE,
+        RASTER,             // Capabilities, blend function and polygon mode
+        NUM_CATEGORIES
+    };
+
+    // Calls of a frame by category, sent to the driver or skipped as redundant
+    struct Stats
+    {
+        unsigned int calls[NUM_CATEGORIES];
+        unsigned int redundant[NUM_CATEGORIES];
+
+        unsigned int GetCalls() const;
+        unsigned int GetRedundant() const;
+    };
+
+    static void UseProgram(GLuint program);
+    static void BindVertexArray(GLuint vertexArray);
+    // GL_ELEMENT_ARRAY_BUFFER belongs to the vertex array, it is always sent
+    static void BindBuffer(GLenum target, GLuint buffer);
+    // Also binds the generic binding point of the target
+    static void BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    static void ActiveTexture(GLenum unit);
+    // Tracked for GL_TEXTURE_2D, the other targets are always sent
+    static void BindTexture(GLenum target, GLuint texture);
+    static void BindTextureUnit(GLenum unit, GLuint texture);
+
+    // Tracked for GL_BLEND, GL_DEPTH_TEST and GL_CULL_FACE
+    static void Enable(GLenum capability);
+    static void Disable(GLenum capability);
+    static void BlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+    static void PolygonMode(GLenum face, GLenum mode);
+
+    static void DeleteProgram(GLuint program);
+    static void DeleteVertexArrays(GLsizei count, const GLuint *vertexArrays);
+    static void DeleteBuffers(GLsizei count, const GLuint *buffers);
+    static void DeleteTextures(GLsizei count, const GLuint *textures);
+
+    // Forget the whole shadow, the next change of each state is sent
+    static void Invalidate();
+
+    // Start counting a new frame, the counts of the finished one stay available
+    static void BeginFrame();
+    static const Stats &GetLastFrameStats();
+
+ private:
+    enum TrackedBuffer
+    {
+        ARRAY_BUFFER = 0,
+        UNIFORM_BUFFER,
+        SHADER_STORAGE_BUFFER,
+        PIXEL_UNPACK_BUFFER,
+        NUM_TRACKED_BUFFERS
+    };
+
+    enum TrackedCapability
+    {
+        BLEND = 0,
+        DEPTH_TEST,
+        CULL_FACE,
+        NUM_TRACKED_CAPABILITIES
+    };
+
+    static int GetBufferSlot(GLenum target);
+    static int GetCapabilitySlot(GLenum capability);
+    static void SetCapability(GLenum capability, bool enabled);
+    // Count a request, true when it changes the state and must be sent
+    static bool Changes(Category category, bool changed);
+
+ private:
+    // UNKNOWN never matches, a state is unknown until set through GLState
+    static const GLuint UNKNOWN = 0xFFFFFFFFu;
+
+    static GLuint program;
+    static GLuint vertexArray;
+    static GLuint buffers[NUM_TRACKED_BUFFERS];
+    static GLuint activeUnit;
+    static GLuint textures[MAX_TEXTURE_UNITS];
+    static GLuint capabilities[NUM_TRACKED_CAPABILITIES];
+    static GLuint blendSource;
+    static GLuint blendDestination;
+    static GLuint polygonMode;
+
+    static Stats frameStats;
+    static Stats lastFrameStats;
+};
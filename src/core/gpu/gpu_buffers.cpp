@@ -1,5 +1,6 @@
 #include "core/gpu/gpu_buffers.h"
 #include "core/gpu/vertex_format.h"
+#include "core/gpu/gl_state.h"
 
 
 enum VERTEX_ATTRIBUTE_LOC
@@ -25,6 +26,7 @@ void GPUBuffers::CreateBuffers(unsigned int size)
     this->m_size = size;
     glGenVertexArrays(1, &m_VAO);
     glGenBuffers(size, m_VBO);
+    LiveObjects() += size + 1;
 }
 
 
@@ -32,8 +34,9 @@ void GPUBuffers::ReleaseMemory()
 {
     if (m_size)
     {
-        glDeleteVertexArrays(1, &m_VAO);
-        glDeleteBuffers(m_size, m_VBO);
+        GLState::DeleteVertexArrays(1, &m_VAO);
+        GLState::DeleteBuffers(m_size, m_VBO);
+        LiveObjects() -= m_size + 1;
         m_size = 0;
     }
 }
@@ -45,24 +48,24 @@ GPUBuffers gpu_utils::UploadData(const std::vector<glm::vec3> &positions,
 {
     GPUBuffers buffers;
     buffers.CreateBuffers(3);
-    glBindVertexArray(buffers.m_VAO);
+    GLState::BindVertexArray(buffers.m_VAO);
 
     // Generate and populate the buffers with vertex attributes and the indices
-    glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[0]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[0]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(positions[0]) * positions.size(), &positions[0], GL_STATIC_DRAW);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::POS);
     glVertexAttribPointer(VERTEX_ATTRIBUTE_LOC::POS, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[1]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[1]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(normals[0]) * normals.size(), &normals[0], GL_STATIC_DRAW);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::NORMAL);
     glVertexAttribPointer(VERTEX_ATTRIBUTE_LOC::NORMAL, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.m_VBO[2]);
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.m_VBO[2]);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * indices.size(), &indices[0], GL_STATIC_DRAW);
 
     // Make sure the VAO is not changed from the outside
-    glBindVertexArray(0);
+    GLState::BindVertexArray(0);
 
     CheckOpenGLError();
 
@@ -78,29 +81,29 @@ GPUBuffers gpu_utils::UploadData(const std::vector<glm::vec3> &positions,
     // Create the VAO
     GPUBuffers buffers;
     buffers.CreateBuffers(4);
-    glBindVertexArray(buffers.m_VAO);
+    GLState::BindVertexArray(buffers.m_VAO);
 
     // Generate and populate the buffers with vertex attributes and the indices
-    glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[0]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[0]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(positions[0]) * positions.size(), &positions[0], GL_STATIC_DRAW);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::POS);
     glVertexAttribPointer(VERTEX_ATTRIBUTE_LOC::POS, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[1]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[1]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(normals[0]) * normals.size(), &normals[0], GL_STATIC_DRAW);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::NORMAL);
     glVertexAttribPointer(VERTEX_ATTRIBUTE_LOC::NORMAL, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[2]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[2]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(text_coords[0]) * text_coords.size(), &text_coords[0], GL_STATIC_DRAW);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::TEX_COORD);
     glVertexAttribPointer(VERTEX_ATTRIBUTE_LOC::TEX_COORD, 2, GL_FLOAT, GL_FALSE, 0, 0);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.m_VBO[3]);
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.m_VBO[3]);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * indices.size(), &indices[0], GL_STATIC_DRAW);
 
     // Make sure the VAO is not changed from the outside
-    glBindVertexArray(0);
+    GLState::BindVertexArray(0);
     CheckOpenGLError();
 
     return buffers;
@@ -115,36 +118,36 @@ GPUBuffers gpu_utils::UploadData(const std::vector<glm::vec3>& positions,
     // Create the VAO
     GPUBuffers buffers;
     buffers.CreateBuffers(5);
-    glBindVertexArray(buffers.m_VAO);
+    GLState::BindVertexArray(buffers.m_VAO);
 
     // Generate and populate the buffers with vertex attributes and the indices
-    glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[0]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[0]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(positions[0]) * positions.size(), &positions[0], GL_STATIC_DRAW);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::POS);
     glVertexAttribPointer(VERTEX_ATTRIBUTE_LOC::POS, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[1]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[1]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(normals[0]) * normals.size(), &normals[0], GL_STATIC_DRAW);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::NORMAL);
     glVertexAttribPointer(VERTEX_ATTRIBUTE_LOC::NORMAL, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[2]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[2]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(text_coords[0]) * text_coords.size(), &text_coords[0], GL_STATIC_DRAW);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::TEX_COORD);
     glVertexAttribPointer(VERTEX_ATTRIBUTE_LOC::TEX_COORD, 2, GL_FLOAT, GL_FALSE, 0, 0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[3]);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[3]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(bones[0]) * bones.size(), &bones[0], GL_STATIC_DRAW);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::BONE);
     glVertexAttribIPointer(VERTEX_ATTRIBUTE_LOC::BONE, 4, GL_INT, sizeof(VertexBoneData), (const GLvoid*)0);
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOC::WEIGHT);
     glVertexAttribPointer(VERTEX_ATTRIBUTE_LOC::WEIGHT, 4, GL_FLOAT, GL_FALSE, sizeof(VertexBoneData), (const GLvoid*)16);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.m_VBO[4]);
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.m_VBO[4]);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * indices.size(), &indices[0], GL_STATIC_DRAW);
 
     // Make sure the VAO is not changed from the outside
-    glBindVertexArray(0);
+    GLState::BindVertexArray(0);
     CheckOpenGLError();
 
     return buffers;
@@ -157,10 +160,10 @@ GPUBuffers gpu_utils::UploadData(const std::vector<VertexFormat> &vertices,
         // Create the VAO
         GPUBuffers buffers;
         buffers.CreateBuffers(2);
-        glBindVertexArray(buffers.m_VAO);
+        GLState::BindVertexArray(buffers.m_VAO);
 
         // Generate and populate the buffers with vertex attributes and the indices
-        glBindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[0]);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, buffers.m_VBO[0]);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices[0]) * vertices.size(), &vertices[0], GL_STATIC_DRAW);
 
         glEnableVertexAttribArray(0);
@@ -175,11 +178,11 @@ GPUBuffers gpu_utils::UploadData(const std::vector<VertexFormat> &vertices,
         glEnableVertexAttribArray(3);
         glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(VertexFormat), (void*)(2 * sizeof(glm::vec3) + sizeof(glm::vec2)));
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.m_VBO[1]);
+        GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.m_VBO[1]);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * indices.size(), &indices[0], GL_STATIC_DRAW);
 
         // Make sure the VAO is not changed from the outside
-        glBindVertexArray(0);
+        GLState::BindVertexArray(0);
         CheckOpenGLError();
 
         return buffers;
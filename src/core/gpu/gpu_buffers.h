@@ -17,10 +17,20 @@ class GPUBuffers
     void CreateBuffers(unsigned int size);
     void ReleaseMemory();
 
+    // Number of VAOs and VBOs created through CreateBuffers and not released yet
+    static unsigned int GetLiveObjectCount() { return LiveObjects(); }
+
  public:
     GLuint m_VAO;
     GLuint m_VBO[6];
 
+ private:
+    static unsigned int &LiveObjects()
+    {
+        static unsigned int liveObjects = 0;
+        return liveObjects;
+    }
+
  private:
     unsigned int m_size;
 };
@@ -0,0 +1,86 @@
+#include "core/gpu/gpu_timer.h"
+
+
+GpuTimer::Query GpuTimer::queries[GpuTimer::MAX_QUERIES];
+int GpuTimer::nextQuery = 0;
+bool GpuTimer::created = false;
+bool GpuTimer::running = false;
+
+
+void GpuTimer::Collect()
+{
+    if (!created)
+        return;
+
+    for (auto &query : queries)
+    {
+        if (!query.pending)
+            continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(query.id, GL_QUERY_RESULT, &nanoseconds);
+        Profiler::SetGpuTime(query.frameIndex, query.zone, nanoseconds / 1.0e6);
+        query.pending = false;
+    }
+}
+
+
+int GpuTimer::Begin(int zone)
+{
+    if (zone < 0 || running)
+        return -1;
+
+    if (!created)
+    {
+        for (auto &query : queries)
+        {
+            glGenQueries(1, &query.id);
+            query.pending = false;
+        }
+        created = true;
+    }
+
+    // The queries are reused in turn, one still in flight is skipped for this zone
+    Query &query = queries[nextQuery];
+    if (query.pending)
+        return -1;
+    nextQuery = (nextQuery + 1) % MAX_QUERIES;
+
+    query.frameIndex = Profiler::GetFrameIndex();
+    query.zone = zone;
+    glBeginQuery(GL_TIME_ELAPSED, query.id);
+    running = true;
+
+    return static_cast<int>(&query - queries);
+}
+
+
+void GpuTimer::End(int query)
+{
+    if (query < 0)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    queries[query].pending = true;
+    running = false;
+}
+
+
+void GpuTimer::Release()
+{
+    if (!created)
+        return;
+
+    for (auto &query : queries)
+    {
+        glDeleteQueries(1, &query.id);
+        query.pending = false;
+    }
+    created = false;
+    running = false;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "core/profiler.h"
+#include "utils/gl_utils.h"
+
+
+// GPU time of the profiler zones, measured with GL_TIME_ELAPSED queries begun and ended
+// around the zone. The results are read back a few frames later, only once available,
+// so the CPU never waits for the GPU. GL_TIME_ELAPSED queries cannot nest: a GPU zone
+// opened inside another one is only timed on the CPU.
+class GpuTimer
+{
+ public:
+    static const int MAX_QUERIES = 128;         // Queries in flight, about MAX_QUERIES / zones per frame frames
+
+    // Read back the available results into the profiler, call once per frame
+    static void Collect();
+    // Start timing a zone of the current frame, returns the query slot, -1 if not timed
+    static int Begin(int zone);
+    static void End(int query);
+    // Delete the queries, needs the OpenGL context
+    static void Release();
+
+ private:
+    struct Query
+    {
+        GLuint id;
+        unsigned long long frameIndex;
+        int zone;
+        bool pending;           // Ended, the result was not read back yet
+    };
+
+ private:
+    static Query queries[MAX_QUERIES];
+    static int nextQuery;
+    static bool created;
+    static bool running;        // A query is active, GL_TIME_ELAPSED allows a single one
+};
+
+
+// Scoped zone timed on the CPU and on the GPU
+class GpuProfileZone
+{
+ public:
+    explicit GpuProfileZone(const char *name) : cpuZone(name), query(GpuTimer::Begin(cpuZone.GetZone())) {}
+    ~GpuProfileZone() { GpuTimer::End(query); }
+
+ private:
+    GpuProfileZone(const GpuProfileZone &) = delete;
+    GpuProfileZone &operator=(const GpuProfileZone &) = delete;
+
+ private:
+    ProfileZone cpuZone;
+    int query;
+};
+
+
+// Time the rest of the enclosing scope on the CPU and on the GPU
+#define PROFILE_GPU_ZONE(name)      GpuProfileZone PROFILE_CONCAT(gpuProfileZone, __LINE__)(name)
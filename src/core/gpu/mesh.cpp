@@ -6,7 +6,10 @@
 #include "assimp/postprocess.h"         // Post processing flags
 
 #include "core/gpu/gpu_buffers.h"
+#include "core/gpu/gl_state.h"
 #include "core/gpu/texture2D.h"
+#include "core/jobs/job_system.h"
+#include "core/managers/resource_loader.h"
 #include "core/managers/texture_manager.h"
 
 #include "utils/memory_utils.h"
@@ -107,6 +110,31 @@ void Mesh::ClearRootNode(aiNode* node)
 
 bool Mesh::LoadMesh(const std::string& fileLocation,
     const std::string& fileName)
+{
+    return ImportMesh(fileLocation, fileName) && UploadMesh(false);
+}
+
+
+std::shared_ptr<LoadHandle> Mesh::LoadMeshAsync(const std::string& fileLocation,
+    const std::string& fileName)
+{
+    std::shared_ptr<LoadHandle> handle = std::make_shared<LoadHandle>();
+
+    JobSystem::Run([this, fileLocation, fileName, handle]()
+    {
+        bool imported = ImportMesh(fileLocation, fileName);
+        ResourceLoader::QueueUpload([this, imported, handle]()
+        {
+            handle->Finish(imported && UploadMesh(true));
+        });
+    });
+
+    return handle;
+}
+
+
+bool Mesh::ImportMesh(const std::string& fileLocation,
+    const std::string& fileName)
 {
     ClearData();
     this->fileLocation = fileLocation;
@@ -245,8 +273,28 @@ bool Mesh::InitFromScene(const aiScene* pScene)
     if (useMaterial && !InitMaterials(pScene))
         return false;
 
+    return true;
+}
+
+
+bool Mesh::UploadMesh(bool asyncTextures)
+{
+    if (useMaterial)
+    {
+        for (auto material : materials)
+        {
+            if (material->textureFile.empty())
+                continue;
+
+            material->texture = asyncTextures
+                ? TextureManager::LoadTextureAsync(fileLocation, material->textureFile.c_str())
+                : TextureManager::LoadTexture(fileLocation, material->textureFile.c_str());
+        }
+    }
+
     buffers->ReleaseMemory();
     *buffers = gpu_utils::UploadData(positions, normals, texCoords, bones, indices);
+    CheckOpenGLError();
     return buffers->m_VAO != 0;
 }
 
@@ -413,7 +461,8 @@ bool Mesh::InitMaterials(const aiScene* pScene)
             aiString Path;
             if (pMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &Path, NULL, NULL, NULL, NULL, NULL) == AI_SUCCESS)
             {
-                materials[i]->texture = TextureManager::LoadTexture(fileLocation, Path.data);
+                // Loaded by UploadMesh, on the thread owning the context
+                materials[i]->textureFile = Path.data;
             }
         }
 
@@ -430,7 +479,6 @@ bool Mesh::InitMaterials(const aiScene* pScene)
             memcpy((void *)&materials[i]->emissive, &color, sizeof(color));
     }
 
-    CheckOpenGLError();
     return ret;
 }
 
@@ -455,13 +503,15 @@ void Mesh::UseMaterials(bool value)
 
 void Mesh::Render() const
 {
-    glBindVertexArray(buffers->m_VAO);
+    GLState::BindVertexArray(buffers->m_VAO);
     for (unsigned int i = 0; i < meshEntries.size(); i++)
     {
         if (useMaterial)
         {
             auto materialIndex = meshEntries[i].materialIndex;
-            if (materialIndex != INVALID_MATERIAL && materials[materialIndex]->texture)
+            // A texture still loading has no GL name yet
+            if (materialIndex != INVALID_MATERIAL && materials[materialIndex]->texture
+                && materials[materialIndex]->texture->GetTextureID())
             {
                 (materials[materialIndex]->texture)->BindToTextureUnit(GL_TEXTURE0);
             } else {
@@ -473,5 +523,5 @@ void Mesh::Render() const
             GL_UNSIGNED_INT, (void*)(sizeof(unsigned int) * meshEntries[i].baseIndex),
             meshEntries[i].baseVertex);
     }
-    glBindVertexArray(0);
+    // The vertex array stays bound, the next draw of the same mesh skips the bind
 }
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 #include "core/gpu/vertex_format.h"
 #include "core/gpu/texture2D.h"
@@ -10,6 +11,8 @@
 
 #include "assimp/scene.h"   // Output data structure
 
+class LoadHandle;
+
 class Material {
 public:
     Material() : texture(nullptr) {}
@@ -21,6 +24,7 @@ public:
     float shininess;
 
     Texture2D* texture;
+    std::string textureFile;    // Diffuse texture, loaded along the GL resources
 };
 
 static const unsigned int INVALID_MATERIAL = std::numeric_limits<unsigned int>::max();
@@ -66,6 +70,11 @@ class Mesh {
     bool LoadMesh(const std::string& fileLocation,
                   const std::string& fileName);
 
+    // Returns right away, the file is imported on a worker and the buffers and textures are
+    // uploaded by ResourceLoader. The mesh must not be rendered, nor deleted, before the handle is done
+    std::shared_ptr<LoadHandle> LoadMeshAsync(const std::string& fileLocation,
+                                              const std::string& fileName);
+
     glm::mat4 ConvertMatrix(const aiMatrix4x4& aiMat);
     void UseMaterials(bool value);
 
@@ -82,6 +91,10 @@ class Mesh {
  protected:
     void InitFromData();
 
+    // LoadMesh in two steps, the import makes no GL call
+    bool ImportMesh(const std::string& fileLocation, const std::string& fileName);
+    bool UploadMesh(bool asyncTextures);
+
     void InitMesh(int index, const aiMesh* paiMesh);
     void LoadBones(int MeshIndex, const aiMesh* pMesh);
     bool InitMaterials(const aiScene* pScene);
@@ -9,6 +9,8 @@
 #include "components/camera.h"
 #include "components/transform.h"
 
+#include "core/gpu/camera_buffer.h"
+#include "core/gpu/gl_state.h"
 #include "core/gpu/shader.h"
 #include "core/gpu/texture2D.h"
 #include "core/gpu/ssbo.h"
@@ -69,15 +71,14 @@ void ParticleEffect<T>::Render(gfxc::Camera *camera, Shader *shader, unsigned in
 {
     // Bind MVP
     glUniformMatrix4fv(shader->loc_model_matrix, 1, GL_FALSE, glm::value_ptr(source->GetModel()));
-    glUniformMatrix4fv(shader->loc_view_matrix, 1, false, glm::value_ptr(camera->GetViewMatrix()));
-    glUniformMatrix4fv(shader->loc_projection_matrix, 1, false, glm::value_ptr(camera->GetProjectionMatrix()));
+    CameraBuffer::Update(camera->GetViewMatrix(), camera->GetProjectionMatrix());
     glUniform3fv(shader->loc_eye_pos, 1, glm::value_ptr(camera->m_transform->GetWorldPosition()));
 
     // Bind Particle Storage
     particles->BindBuffer(0);
 
     // Render Particles
-    glBindVertexArray(VAO);
+    GLState::BindVertexArray(VAO);
     glDrawElements(GL_POINTS, MIN(particleCount, nrParticles), GL_UNSIGNED_INT, 0);
 }
 
@@ -87,15 +88,14 @@ void ParticleEffect<T>::RenderNEW(gfxc::Camera* camera, Shader* shader, glm::mat
 {
     // Bind MVP
     glUniformMatrix4fv(shader->loc_model_matrix, 1, GL_FALSE, glm::value_ptr(source->GetModel()));
-    glUniformMatrix4fv(shader->loc_view_matrix, 1, false, glm::value_ptr(*modelMatrix));
-    glUniformMatrix4fv(shader->loc_projection_matrix, 1, false, glm::value_ptr(camera->GetProjectionMatrix()));
+    CameraBuffer::Update(*modelMatrix, camera->GetProjectionMatrix());
     glUniform3fv(shader->loc_eye_pos, 1, glm::value_ptr(camera->m_transform->GetWorldPosition()));
 
     // Bind Particle Storage
     particles->BindBuffer(0);
 
     // Render Particles
-    glBindVertexArray(VAO);
+    GLState::BindVertexArray(VAO);
     glDrawElements(GL_POINTS, MIN(particleCount, nrParticles), GL_UNSIGNED_INT, 0);
 }
 
@@ -119,13 +119,13 @@ void ParticleEffect<T>::Generate(unsigned int particleCount, bool createLocalBuf
     GLuint IBO;
 
     glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
+    GLState::BindVertexArray(VAO);
 
     glGenBuffers(1, &IBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, particleCount * sizeof(unsigned int), indices, GL_STATIC_DRAW);
 
-    glBindVertexArray(0);
+    GLState::BindVertexArray(0);
 
     delete[] indices;
 }
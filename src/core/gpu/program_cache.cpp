@@ -0,0 +1,266 @@
+#include "core/gpu/program_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "core/gpu/gl_state.h"
+
+
+bool ProgramCache::enabled = false;
+bool ProgramCache::dirty = false;
+std::string ProgramCache::filePath;
+unsigned long long ProgramCache::driverHash = 0;
+std::unordered_map<std::string, ProgramCache::Entry> ProgramCache::entries;
+
+int ProgramCache::hits = 0;
+int ProgramCache::misses = 0;
+int ProgramCache::rejected = 0;
+
+
+namespace
+{
+    const char MAGIC[4] = { 'P', 'V', 'Z', 'P' };
+    const unsigned int VERSION = 1;
+
+    // FNV-1a, stable across runs and platforms
+    unsigned long long Hash(const void *data, size_t size, unsigned long long hash = 14695981039346656037ULL)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    unsigned long long HashString(GLenum name, unsigned long long hash)
+    {
+        const char *value = reinterpret_cast<const char *>(glGetString(name));
+        return value ? Hash(value, strlen(value) + 1, hash) : hash;
+    }
+
+    template <typename T>
+    bool ReadValue(FILE *file, T &value)
+    {
+        return fread(&value, sizeof(T), 1, file) == 1;
+    }
+
+    template <typename T>
+    void WriteValue(FILE *file, const T &value)
+    {
+        fwrite(&value, sizeof(T), 1, file);
+    }
+
+    // A length read from the file is only trusted if that many bytes are left in it,
+    // a corrupted one must not size an allocation
+    bool FitsInFile(FILE *file, long fileSize, unsigned int length)
+    {
+        long position = ftell(file);
+        return position >= 0 && position <= fileSize
+            && static_cast<unsigned long>(fileSize - position) >= length;
+    }
+}
+
+
+void ProgramCache::Init(const std::string &filePath)
+{
+    ProgramCache::filePath = filePath;
+
+    GLint formats = 0;
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+    {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    }
+    enabled = formats > 0;
+    if (!enabled)
+    {
+        std::cout << "ProgramCache: the driver has no program binary format, shaders compile on each start" << std::endl;
+        return;
+    }
+
+    driverHash = HashString(GL_VENDOR, HashString(GL_RENDERER, HashString(GL_VERSION, Hash(nullptr, 0))));
+    if (!Read())
+    {
+        entries.clear();
+    }
+}
+
+
+bool ProgramCache::Read()
+{
+    FILE *file = fopen(filePath.c_str(), "rb");
+    if (!file)
+        return false;
+
+    long fileSize = -1;
+    if (fseek(file, 0, SEEK_END) == 0)
+    {
+        fileSize = ftell(file);
+    }
+    rewind(file);
+
+    char magic[4];
+    unsigned int version = 0, count = 0;
+    unsigned long long fileDriverHash = 0;
+    bool valid = fileSize >= 0 && fread(magic, 1, 4, file) == 4 && memcmp(magic, MAGIC, 4) == 0
+        && ReadValue(file, version) && version == VERSION
+        && ReadValue(file, fileDriverHash) && ReadValue(file, count);
+
+    // Binaries of another driver would all be rejected, they are replaced as the programs link
+    if (valid && fileDriverHash != driverHash)
+    {
+        std::cout << "ProgramCache: the driver changed, the programs are compiled again" << std::endl;
+        fclose(file);
+        dirty = true;
+        return false;
+    }
+
+    for (unsigned int i = 0; valid && i < count; i++)
+    {
+        unsigned int nameLength = 0, format = 0, size = 0;
+        std::string name;
+        Entry entry;
+
+        valid = ReadValue(file, nameLength) && FitsInFile(file, fileSize, nameLength);
+        if (valid)
+        {
+            name.resize(nameLength);
+            valid = fread(&name[0], 1, nameLength, file) == nameLength;
+        }
+        valid = valid && ReadValue(file, entry.key) && ReadValue(file, format) && ReadValue(file, size)
+            && FitsInFile(file, fileSize, size);
+        if (valid)
+        {
+            entry.format = format;
+            entry.binary.resize(size);
+            valid = fread(entry.binary.data(), 1, size, file) == size;
+        }
+        if (valid)
+        {
+            entries[name] = std::move(entry);
+        }
+    }
+    fclose(file);
+
+    if (!valid)
+    {
+        std::cerr << "ProgramCache: " << filePath << " is corrupted, the programs are compiled again" << std::endl;
+        dirty = true;
+    }
+    return valid;
+}
+
+
+void ProgramCache::Save()
+{
+    if (!enabled)
+        return;
+
+    std::cout << "ProgramCache: " << hits << " programs loaded from the cache, " << misses << " compiled, "
+              << rejected << " binaries rejected by the driver" << std::endl;
+
+    if (!dirty)
+        return;
+
+    FILE *file = fopen(filePath.c_str(), "wb");
+    if (!file)
+    {
+        std::cerr << "ProgramCache: cannot write " << filePath << std::endl;
+        return;
+    }
+
+    fwrite(MAGIC, 1, 4, file);
+    WriteValue(file, VERSION);
+    WriteValue(file, driverHash);
+    WriteValue(file, static_cast<unsigned int>(entries.size()));
+
+    for (auto &it : entries)
+    {
+        const Entry &entry = it.second;
+        WriteValue(file, static_cast<unsigned int>(it.first.size()));
+        fwrite(it.first.data(), 1, it.first.size(), file);
+        WriteValue(file, entry.key);
+        WriteValue(file, static_cast<unsigned int>(entry.format));
+        WriteValue(file, static_cast<unsigned int>(entry.binary.size()));
+        fwrite(entry.binary.data(), 1, entry.binary.size(), file);
+    }
+
+    fclose(file);
+    dirty = false;
+}
+
+
+bool ProgramCache::IsEnabled()
+{
+    return enabled;
+}
+
+
+unsigned long long ProgramCache::MakeKey(const Sources &sources)
+{
+    unsigned long long key = driverHash;
+    for (auto &source : sources)
+    {
+        key = Hash(&source.first, sizeof(source.first), key);
+        key = Hash(source.second.data(), source.second.size(), key);
+    }
+    return key;
+}
+
+
+GLuint ProgramCache::Load(const std::string &name, unsigned long long key)
+{
+    if (!enabled)
+        return 0;
+
+    auto it = entries.find(name);
+    if (it == entries.end() || it->second.key != key)
+    {
+        misses++;
+        return 0;
+    }
+
+    const Entry &entry = it->second;
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, entry.format, entry.binary.data(), static_cast<GLsizei>(entry.binary.size()));
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked == GL_FALSE)
+    {
+        // A driver update may reject the binaries of the same version string
+        GLState::DeleteProgram(program);
+        entries.erase(it);
+        dirty = true;
+        rejected++;
+        misses++;
+        return 0;
+    }
+
+    hits++;
+    CheckOpenGLError();
+    return program;
+}
+
+
+void ProgramCache::Store(const std::string &name, unsigned long long key, GLuint program)
+{
+    if (!enabled || program == 0)
+        return;
+
+    GLint size = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size <= 0)
+        return;
+
+    Entry entry;
+    entry.key = key;
+    entry.binary.resize(size);
+    glGetProgramBinary(program, size, nullptr, &entry.format, entry.binary.data());
+    CheckOpenGLError();
+
+    entries[name] = std::move(entry);
+    dirty = true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils/gl_utils.h"
+
+
+// On-disk cache of the linked shader programs, as returned by glGetProgramBinary. An entry
+// is keyed by a hash of the stage sources and of the vendor, renderer and version strings
+// of the driver, a program found with the same key is reloaded with glProgramBinary and
+// skips the compilation. A changed source, another driver, or a binary the driver rejects
+// fall back to compiling the sources, the new binary then replaces the entry.
+//
+// File layout, native byte order since the binaries only load on the same machine:
+//   header   "PVZP", version u32, driver hash u64, entries u32
+//   entries  name length u32, name, key u64, binary format u32, binary size u32, binary
+class ProgramCache
+{
+ public:
+    // Type and source code of each stage of a program
+    typedef std::vector<std::pair<GLenum, std::string>> Sources;
+
+    // Read the cache file, needs the GL context. Disabled when the driver has no binary format
+    static void Init(const std::string &filePath);
+    // Write the entries back if they changed, prints the hits and misses of the session
+    static void Save();
+
+    static bool IsEnabled();
+    static unsigned long long MakeKey(const Sources &sources);
+
+    // Linked program created from the binary cached for the key, 0 if there is none
+    static GLuint Load(const std::string &name, unsigned long long key);
+    // Keep the binary of a program linked from source, it must be linked with the retrievable hint
+    static void Store(const std::string &name, unsigned long long key, GLuint program);
+
+ private:
+    struct Entry
+    {
+        unsigned long long key;
+        GLenum format;
+        std::vector<char> binary;
+    };
+
+    static bool Read();
+
+ private:
+    static bool enabled;
+    static bool dirty;
+    static std::string filePath;
+    static unsigned long long driverHash;
+    static std::unordered_map<std::string, Entry> entries;      // One per program name, the last one linked
+
+    static int hits;
+    static int misses;
+    static int rejected;
+};
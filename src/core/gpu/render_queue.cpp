@@ -0,0 +1,241 @@
+#include "core/gpu/render_queue.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "core/gpu/camera_buffer.h"
+#include "core/gpu/gl_state.h"
+#include "utils/gl_utils.h"
+
+
+// First attribute location used by the per-instance data,
+// locations 0..3 are taken by the VertexFormat attributes
+#define INSTANCE_ATTRIBUTE_LOC  (4)
+
+// Key, from the most significant bits: layer (8) | shader (12) | mesh (20) | sequence (24)
+#define KEY_LAYER_SHIFT         (56)
+#define KEY_SHADER_SHIFT        (44)
+#define KEY_MESH_SHIFT          (24)
+#define KEY_SEQUENCE_MASK       ((uint64_t(1) << KEY_MESH_SHIFT) - 1)
+// Shader and mesh, the commands drawn by the same call
+#define KEY_RUN_MASK            (((uint64_t(1) << KEY_LAYER_SHIFT) - 1) & ~KEY_SEQUENCE_MASK)
+
+
+RenderQueue::RenderQueue()
+{
+    instanceVBO = 0;
+    capacity = 0;
+    stats = Stats();
+}
+
+
+RenderQueue::~RenderQueue()
+{
+    if (instanceVBO)
+        GLState::DeleteBuffers(1, &instanceVBO);
+}
+
+
+void RenderQueue::Begin()
+{
+    keys.clear();
+    commands.clear();
+    instances.clear();
+    // Meshes not drawn since may have been deleted, their address must not keep an id
+    shaderIds.clear();
+    meshIds.clear();
+    stats.commands = 0;
+}
+
+
+unsigned int RenderQueue::GetShaderId(const Shader *shader)
+{
+    auto it = shaderIds.find(shader);
+    if (it == shaderIds.end())
+        it = shaderIds.insert(std::make_pair(shader, static_cast<unsigned int>(shaderIds.size()))).first;
+    return it->second;
+}
+
+
+unsigned int RenderQueue::GetMeshId(const Mesh *mesh)
+{
+    auto it = meshIds.find(mesh);
+    if (it == meshIds.end())
+        it = meshIds.insert(std::make_pair(mesh, static_cast<unsigned int>(meshIds.size()))).first;
+    return it->second;
+}
+
+
+void RenderQueue::Submit(unsigned int layer, Shader *shader, Mesh *mesh,
+                         const glm::mat3 &modelMatrix, const glm::vec3 &tint)
+{
+    if (!shader || !mesh || keys.size() >= MAX_COMMANDS)
+        return;
+
+    unsigned int shaderId = GetShaderId(shader);
+    unsigned int meshId = GetMeshId(mesh);
+    if (layer >= MAX_LAYERS || shaderId >= MAX_SHADERS || meshId >= MAX_MESHES)
+    {
+        std::cerr << "RenderQueue: layer, shader or mesh out of the range of the sort key" << std::endl;
+        return;
+    }
+
+    uint64_t key = (uint64_t(layer) << KEY_LAYER_SHIFT)
+                 | (uint64_t(shaderId) << KEY_SHADER_SHIFT)
+                 | (uint64_t(meshId) << KEY_MESH_SHIFT)
+                 | uint64_t(keys.size());
+    keys.push_back(key);
+
+    Command command;
+    command.shader = shader;
+    command.mesh = mesh;
+    commands.push_back(command);
+
+    InstanceData instance;
+    instance.model0 = modelMatrix[0];
+    instance.model1 = modelMatrix[1];
+    instance.model2 = modelMatrix[2];
+    instance.tint = tint;
+    instances.push_back(instance);
+
+    stats.commands++;
+}
+
+
+// LSD radix sort, one byte per pass. The keys are submitted by increasing sequence and
+// each pass is stable, so the sequence bytes need no pass: only the layer, shader and
+// mesh bytes are sorted. A byte equal in every key skips its pass
+void RenderQueue::SortKeys()
+{
+    size_t count = keys.size();
+    sortBuffer.resize(count);
+
+    for (unsigned int shift = KEY_MESH_SHIFT; shift < 64; shift += 8)
+    {
+        size_t histogram[256] = { 0 };
+        for (size_t i = 0; i < count; i++)
+            histogram[(keys[i] >> shift) & 0xFF]++;
+
+        if (histogram[(keys[0] >> shift) & 0xFF] == count)
+            continue;
+
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; digit++)
+        {
+            size_t digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+        for (size_t i = 0; i < count; i++)
+            sortBuffer[histogram[(keys[i] >> shift) & 0xFF]++] = keys[i];
+
+        keys.swap(sortBuffer);
+        stats.sortPasses++;
+    }
+}
+
+
+void RenderQueue::DrawRun(const Command &command, size_t first, size_t count)
+{
+    // The instance attributes of the vertex array point at the run in the frame buffer
+    GLState::BindVertexArray(command.mesh->GetBuffers()->m_VAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    for (int i = 0; i < 4; i++)
+    {
+        GLuint location = INSTANCE_ATTRIBUTE_LOC + i;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            (void*)(first * sizeof(InstanceData) + i * sizeof(glm::vec3)));
+        glVertexAttribDivisor(location, 1);
+    }
+
+    for (const auto &entry : command.mesh->meshEntries)
+    {
+        glDrawElementsInstancedBaseVertex(command.mesh->GetDrawMode(), entry.nrIndices,
+            GL_UNSIGNED_INT, (void*)(sizeof(unsigned int) * entry.baseIndex),
+            static_cast<GLsizei>(count), entry.baseVertex);
+        stats.drawCalls++;
+    }
+    stats.instances += static_cast<unsigned int>(count);
+}
+
+
+void RenderQueue::Execute(const glm::mat4 &viewMatrix, const glm::mat4 &projectionMatrix)
+{
+    stats.drawCalls = 0;
+    stats.instances = 0;
+    stats.shaderChanges = 0;
+    stats.meshChanges = 0;
+    stats.layers = 0;
+    stats.sortPasses = 0;
+
+    if (keys.empty())
+        return;
+
+    SortKeys();
+
+    // Instances of a run are contiguous, they are uploaded at once for the whole frame
+    size_t count = keys.size();
+    sortedInstances.resize(count);
+    for (size_t i = 0; i < count; i++)
+        sortedInstances[i] = instances[keys[i] & KEY_SEQUENCE_MASK];
+
+    // Grow the instance buffer geometrically, otherwise orphan and refill it
+    if (!instanceVBO)
+        glGenBuffers(1, &instanceVBO);
+    GLsizeiptr size = sizeof(InstanceData) * count;
+    GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (size > capacity)
+    {
+        capacity = std::max(size, capacity * 2);
+    }
+    glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, &sortedInstances[0]);
+
+    CameraBuffer::Update(viewMatrix, projectionMatrix);
+
+    const Shader *currentShader = nullptr;
+    const Mesh *currentMesh = nullptr;
+    uint64_t currentLayer = MAX_LAYERS;
+    size_t runStart = 0;
+    for (size_t i = 1; i <= count; i++)
+    {
+        uint64_t layer = keys[i - 1] >> KEY_LAYER_SHIFT;
+        if (layer != currentLayer)
+        {
+            currentLayer = layer;
+            stats.layers++;
+        }
+
+        // Consecutive commands of the same shader and mesh are drawn together, even across layers
+        if (i < count && (keys[i] & KEY_RUN_MASK) == (keys[runStart] & KEY_RUN_MASK))
+            continue;
+
+        const Command &command = commands[keys[runStart] & KEY_SEQUENCE_MASK];
+        if (command.shader != currentShader)
+        {
+            command.shader->Use();
+            currentShader = command.shader;
+            stats.shaderChanges++;
+        }
+        if (command.mesh != currentMesh)
+        {
+            currentMesh = command.mesh;
+            stats.meshChanges++;
+        }
+
+        DrawRun(command, runStart, i - runStart);
+        runStart = i;
+    }
+
+    GLState::BindVertexArray(0);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+
+    CheckOpenGLError();
+}
+
+
+const RenderQueue::Stats &RenderQueue::GetStats() const
+{
+    return stats;
+}
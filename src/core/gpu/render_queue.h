@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+#include "core/gpu/mesh.h"
+#include "core/gpu/shader.h"
+#include "utils/glm_utils.h"
+
+
+// Front-end of the 2D draws: every subsystem submits (layer, shader, mesh, instance data)
+// commands in any order during the frame. Execute radix-sorts their 64-bit keys once and
+// draws them back to back, every run of commands sharing the shader and the mesh (and so
+// its material) with a single instanced draw call, whichever subsystem submitted them.
+// Layers are drawn in increasing order, the commands of a run keep their submission order.
+// The per-instance data is streamed through attribute locations 4..7, see the Instanced2D
+// vertex shader, from one buffer holding the instances of the whole frame.
+class RenderQueue
+{
+ public:
+    static const unsigned int MAX_LAYERS = 1 << 8;
+    static const unsigned int MAX_SHADERS = 1 << 12;
+    static const unsigned int MAX_MESHES = 1 << 20;
+    static const unsigned int MAX_COMMANDS = 1 << 24;
+
+    struct Stats
+    {
+        unsigned int commands;          // Commands submitted since Begin
+        unsigned int drawCalls;         // glDrawElementsInstanced* calls issued by the last Execute
+        unsigned int instances;         // Instances drawn by the last Execute
+        unsigned int shaderChanges;     // Programs used by the last Execute
+        unsigned int meshChanges;       // Vertex arrays bound by the last Execute
+        unsigned int layers;            // Distinct layers drawn by the last Execute
+        unsigned int sortPasses;        // Radix passes not skipped, out of 5 (bytes from the mesh up)
+    };
+
+ public:
+    RenderQueue();
+    ~RenderQueue();
+
+    // Drop the commands of the last frame, keeps the memory and the GPU buffer
+    void Begin();
+    // Queue one instance, ignored once MAX_COMMANDS are queued or if the shader or mesh is null
+    void Submit(unsigned int layer, Shader *shader, Mesh *mesh,
+                const glm::mat3 &modelMatrix, const glm::vec3 &tint = glm::vec3(1));
+    // Sort the commands, upload their instance data and draw them
+    void Execute(const glm::mat4 &viewMatrix, const glm::mat4 &projectionMatrix);
+
+    const Stats &GetStats() const;
+
+ private:
+    // Matches the per-instance attributes of Instanced2D.VS.glsl
+    struct InstanceData
+    {
+        glm::vec3 model0;
+        glm::vec3 model1;
+        glm::vec3 model2;
+        glm::vec3 tint;
+    };
+
+    struct Command
+    {
+        Shader *shader;
+        Mesh *mesh;
+    };
+
+    // Ids in order of first submission this frame, a few bits of the key instead of a pointer
+    unsigned int GetShaderId(const Shader *shader);
+    unsigned int GetMeshId(const Mesh *mesh);
+    void SortKeys();
+    void DrawRun(const Command &command, size_t first, size_t count);
+
+ private:
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> sortBuffer;
+    std::vector<Command> commands;
+    std::vector<InstanceData> instances;        // By submission order
+    std::vector<InstanceData> sortedInstances;  // By key order, the content of instanceVBO
+
+    std::unordered_map<const Shader *, unsigned int> shaderIds;
+    std::unordered_map<const Mesh *, unsigned int> meshIds;
+
+    GLuint instanceVBO;
+    GLsizeiptr capacity;                        // Size in bytes of instanceVBO
+    Stats stats;
+};
@@ -0,0 +1,111 @@
+#include "core/gpu/retained_layer.h"
+
+#include <vector>
+
+#include "core/gpu/gl_state.h"
+#include "utils/gl_utils.h"
+#include "utils/memory_utils.h"
+
+
+RetainedLayer::RetainedLayer()
+{
+    screenShader = nullptr;
+    quad = nullptr;
+    resolution = glm::ivec2(0);
+    generated = false;
+    valid = false;
+    updateCount = 0;
+}
+
+
+RetainedLayer::~RetainedLayer()
+{
+    if (generated)
+        frameBuffer.Clean();
+    SAFE_FREE(quad);
+}
+
+
+void RetainedLayer::Init(Shader *screenShader, const glm::vec4 &clearColor)
+{
+    this->screenShader = screenShader;
+    frameBuffer.SetClearColor(clearColor);
+
+    // Two triangles in normalized device coordinates, the texture covers them exactly
+    std::vector<glm::vec3> positions = {
+        glm::vec3(-1, -1, 0), glm::vec3(1, -1, 0), glm::vec3(1, 1, 0), glm::vec3(-1, 1, 0)
+    };
+    std::vector<glm::vec3> normals(4, glm::vec3(0, 0, 1));
+    std::vector<glm::vec2> texCoords = {
+        glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 1)
+    };
+    std::vector<unsigned int> indices = { 0, 1, 2, 0, 2, 3 };
+
+    SAFE_FREE(quad);
+    quad = new Mesh("retained_layer_quad");
+    quad->InitFromData(positions, normals, texCoords, indices);
+    // Keep the layer texture bound to unit 0 instead of the default texture
+    quad->UseMaterials(false);
+
+    valid = false;
+}
+
+
+void RetainedLayer::Invalidate()
+{
+    valid = false;
+}
+
+
+bool RetainedLayer::BeginUpdate(const glm::ivec2 &resolution)
+{
+    if (valid && resolution == this->resolution)
+        return false;
+    if (resolution.x <= 0 || resolution.y <= 0)
+        return false;
+
+    // 8 bits per channel, the depth texture keeps the order of the content drawn at the same depth
+    if (!generated)
+    {
+        frameBuffer.Generate(resolution.x, resolution.y, 1, true, 8);
+        frameBuffer.GetTexture(0)->SetFiltering(GL_NEAREST, GL_NEAREST);
+        generated = true;
+    }
+    else if (resolution != this->resolution)
+    {
+        // The textures are created again with the same filtering
+        frameBuffer.Resize(resolution.x, resolution.y, 8);
+    }
+    this->resolution = resolution;
+
+    frameBuffer.Bind(true);
+    return true;
+}
+
+
+void RetainedLayer::EndUpdate()
+{
+    FrameBuffer::BindDefault(resolution);
+    valid = true;
+    updateCount++;
+}
+
+
+void RetainedLayer::Composite() const
+{
+    if (!generated || !screenShader || !screenShader->program)
+        return;
+
+    screenShader->Use();
+    frameBuffer.BindTexture(0, GL_TEXTURE0);
+
+    GLState::Disable(GL_DEPTH_TEST);
+    quad->Render();
+    GLState::Enable(GL_DEPTH_TEST);
+}
+
+
+unsigned int RetainedLayer::GetUpdateCount() const
+{
+    return updateCount;
+}
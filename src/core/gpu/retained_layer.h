@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/gpu/frame_buffer.h"
+#include "core/gpu/mesh.h"
+#include "core/gpu/shader.h"
+#include "utils/glm_utils.h"
+
+
+// Content that rarely changes, rendered once into the color texture of a FrameBuffer and
+// composited every frame with a single full-screen quad. The content is rendered again
+// only after Invalidate, or when the resolution changes. The layer is opaque, it covers
+// whatever was drawn before and the color buffer does not need to be cleared under it.
+class RetainedLayer
+{
+ public:
+    RetainedLayer();
+    ~RetainedLayer();
+
+    // Needs the OpenGL context, the shader samples u_texture_0 over the quad (Screen.VS/FS)
+    void Init(Shader *screenShader, const glm::vec4 &clearColor);
+    // The content is rendered again before the next Composite
+    void Invalidate();
+
+    // True when the content must be rendered again: the layer is bound and cleared,
+    // the caller draws the content then calls EndUpdate. False leaves the state untouched
+    bool BeginUpdate(const glm::ivec2 &resolution);
+    // Back to the default framebuffer and its viewport
+    void EndUpdate();
+
+    // Draw the layer over the whole viewport, without depth test
+    void Composite() const;
+
+    // Times the content was rendered since Init
+    unsigned int GetUpdateCount() const;
+
+ private:
+    Shader *screenShader;
+    Mesh *quad;
+    FrameBuffer frameBuffer;
+    glm::ivec2 resolution;
+    bool generated;
+    bool valid;
+    unsigned int updateCount;
+};
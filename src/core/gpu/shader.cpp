@@ -3,6 +3,10 @@
 #include <fstream>
 #include <iostream>
 
+#include "core/gpu/camera_buffer.h"
+#include "core/gpu/gl_state.h"
+#include "core/gpu/program_cache.h"
+
 
 Shader::Shader(const std::string &name)
 {
@@ -14,7 +18,7 @@ Shader::Shader(const std::string &name)
 
 Shader::~Shader()
 {
-    glDeleteProgram(program);
+    GLState::DeleteProgram(program);
 }
 
 
@@ -34,7 +38,7 @@ void Shader::Use() const
 {
     if (program)
     {
-        glUseProgram(program);
+        GLState::UseProgram(program);
         CheckOpenGLError();
     }
 }
@@ -43,7 +47,7 @@ void Shader::Use() const
 unsigned int Shader::Reload()
 {
     if (program) {
-        glDeleteProgram(program);
+        GLState::DeleteProgram(program);
         program = 0;
     }
 
@@ -105,6 +109,9 @@ void Shader::GetUniforms()
     // Text
     text_color              = GetUniformLocation("text_color");
 
+    // View and projection, shared by the programs
+    CameraBuffer::BindBlock(program);
+
     BindTexturesUnits();
 
     CheckOpenGLError();
@@ -131,41 +138,57 @@ void Shader::AddShaderCode(const std::string &shaderCode, GLenum shaderType)
 
 unsigned int Shader::CreateAndLink()
 {
-    std::vector<unsigned int> shaders;
-
-    // Compile shaders
+    // The sources key the program binary cache, they are read even when the binary is used
+    ProgramCache::Sources sources;
     for (auto S : shaderFiles) {
-        auto shaderID = Shader::CreateShader(S.file, S.type);
-        if (shaderID) {
-            shaders.push_back(shaderID);
-        } else {
-            return 0;
-        }
+        sources.push_back(std::make_pair(S.type, Shader::ReadShader(S.file)));
+    }
+    for (auto S : shaderCodes) {
+        sources.push_back(std::make_pair(S.type, S.file));
     }
 
-    for (auto S : shaderCodes)
-    {
-        auto shaderID = Shader::CompileShader(S.file, S.type);
-        if (shaderID) {
-            shaders.push_back(shaderID);
-        } else {
-            return 0;
+    if (sources.empty())
+        return 0;
+
+    unsigned long long cacheKey = ProgramCache::MakeKey(sources);
+    program = ProgramCache::Load(shaderName, cacheKey);
+
+    if (program) {
+        for (auto S : shaderFiles) {
+            std::cout << "\tFILE = " << S.file << "\t ..... CACHED " << std::endl;
         }
     }
+    else {
+        std::vector<unsigned int> shaders;
 
-    // Create Program and Link
-    if (shaders.size()) {
-        program = Shader::CreateProgram(shaders);
-
-        if (program)
-        {
-            glUseProgram(program);
-            GetUniforms();
-            for (auto Observer : loadObservers) {
-                Observer();
+        // Compile shaders
+        for (size_t i = 0; i < sources.size(); i++) {
+            if (i < shaderFiles.size()) {
+                std::cout << "\tFILE = " << shaderFiles[i].file;
+            }
+            auto shaderID = Shader::CompileShader(sources[i].second, sources[i].first);
+            if (shaderID) {
+                shaders.push_back(shaderID);
+            } else {
+                return 0;
             }
-            return program;
         }
+
+        // Create Program and Link
+        if (shaders.size()) {
+            program = Shader::CreateProgram(shaders);
+            ProgramCache::Store(shaderName, cacheKey, program);
+        }
+    }
+
+    if (program)
+    {
+        GLState::UseProgram(program);
+        GetUniforms();
+        for (auto Observer : loadObservers) {
+            Observer();
+        }
+        return program;
     }
     return 0;
 }
@@ -195,7 +218,7 @@ static std::string InjectDefines(const std::string &shaderCode)
 }
 
 
-unsigned int Shader::CreateShader(const std::string &shaderFile, GLenum shaderType)
+std::string Shader::ReadShader(const std::string &shaderFile)
 {
     std::string shader_code;
     std::ifstream file(shaderFile.c_str(), std::ios::in);
@@ -205,8 +228,6 @@ unsigned int Shader::CreateShader(const std::string &shaderFile, GLenum shaderTy
         std::terminate();
     }
 
-    std::cout << "\tFILE = " << shaderFile;
-
     // Get file content
     file.seekg(0, std::ios::end);
     shader_code.resize((unsigned int)file.tellg());
@@ -214,7 +235,7 @@ unsigned int Shader::CreateShader(const std::string &shaderFile, GLenum shaderTy
     file.read(&shader_code[0], shader_code.size());
     file.close();
 
-    return CompileShader(InjectDefines(shader_code), shaderType);
+    return InjectDefines(shader_code);
 }
 
 
@@ -277,6 +298,8 @@ unsigned int Shader::CreateProgram(const std::vector<unsigned int> &shaderObject
 
     // build OpenGL program object and link all the OpenGL shader objects
     unsigned int glProgramObject = glCreateProgram();
+    if (ProgramCache::IsEnabled())
+        glProgramParameteri(glProgramObject, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
     for (auto shader : shaderObjects)
         glAttachShader(glProgramObject, shader);
@@ -0,0 +1,184 @@
+#include "core/gpu/static_batch_2d.h"
+
+#include <iostream>
+
+#include "core/gpu/camera_buffer.h"
+#include "core/gpu/gl_state.h"
+#include "utils/gl_utils.h"
+
+
+// Per-instance attributes of Instanced2D.VS.glsl, see RenderQueue
+#define INSTANCE_ATTRIBUTE_LOC  (4)
+
+
+StaticBatch2D::StaticBatch2D()
+{
+    geometryDirty = false;
+    rangesDirty = false;
+    revision = 0;
+    stats.drawCalls = 0;
+    stats.items = 0;
+    stats.uploads = 0;
+}
+
+
+StaticBatch2D::~StaticBatch2D()
+{
+    buffers.ReleaseMemory();
+}
+
+
+void StaticBatch2D::Clear()
+{
+    vertices.clear();
+    indices.clear();
+    items.clear();
+    runs.clear();
+    geometryDirty = true;
+    rangesDirty = true;
+    revision++;
+}
+
+
+int StaticBatch2D::Add(const Mesh *mesh, const glm::mat3 &modelMatrix, Shader *shader)
+{
+    if (!mesh || mesh->vertices.empty() || mesh->indices.empty())
+    {
+        std::cerr << "StaticBatch2D: " << (mesh ? mesh->GetMeshID() : "null")
+                  << " has no vertices on the CPU, it cannot be baked" << std::endl;
+        return -1;
+    }
+
+    Item item;
+    item.drawMode = mesh->GetDrawMode();
+    item.shader = shader;
+    item.nrIndices = static_cast<GLsizei>(mesh->indices.size());
+    item.baseIndex = static_cast<unsigned int>(indices.size());
+    item.baseVertex = static_cast<GLint>(vertices.size());
+    item.visible = true;
+
+    // Same transform as the Instanced2D vertex shader
+    for (VertexFormat vertex : mesh->vertices)
+    {
+        glm::vec3 world = modelMatrix * glm::vec3(vertex.position.x, vertex.position.y, 1);
+        vertex.position = glm::vec3(world.x, world.y, vertex.position.z * modelMatrix[2][2]);
+        vertices.push_back(vertex);
+    }
+    indices.insert(indices.end(), mesh->indices.begin(), mesh->indices.end());
+
+    items.push_back(item);
+    geometryDirty = true;
+    rangesDirty = true;
+    revision++;
+    return static_cast<int>(items.size()) - 1;
+}
+
+
+void StaticBatch2D::SetVisible(int item, bool visible)
+{
+    if (item < 0 || item >= static_cast<int>(items.size()) || items[item].visible == visible)
+        return;
+
+    items[item].visible = visible;
+    rangesDirty = true;
+    revision++;
+}
+
+
+bool StaticBatch2D::IsVisible(int item) const
+{
+    return item >= 0 && item < static_cast<int>(items.size()) && items[item].visible;
+}
+
+
+unsigned int StaticBatch2D::GetRevision() const
+{
+    return revision;
+}
+
+
+void StaticBatch2D::Upload()
+{
+    buffers.ReleaseMemory();
+    if (!vertices.empty())
+    {
+        buffers = gpu_utils::UploadData(vertices, indices);
+        stats.uploads++;
+    }
+    geometryDirty = false;
+}
+
+
+void StaticBatch2D::BuildRuns()
+{
+    runs.clear();
+    for (const auto &item : items)
+    {
+        if (!item.visible)
+            continue;
+
+        if (runs.empty() || runs.back().drawMode != item.drawMode || runs.back().shader != item.shader)
+        {
+            Run run;
+            run.drawMode = item.drawMode;
+            run.shader = item.shader;
+            runs.push_back(run);
+        }
+
+        Run &run = runs.back();
+        run.counts.push_back(item.nrIndices);
+        run.offsets.push_back((void*)(sizeof(unsigned int) * item.baseIndex));
+        run.baseVertices.push_back(item.baseVertex);
+    }
+    rangesDirty = false;
+}
+
+
+void StaticBatch2D::Render(Shader *shader, const glm::mat4 &viewMatrix, const glm::mat4 &projectionMatrix)
+{
+    stats.drawCalls = 0;
+    stats.items = 0;
+
+    if (!shader || !shader->program)
+    {
+        std::cerr << "StaticBatch2D: no valid shader to render with" << std::endl;
+        return;
+    }
+
+    if (geometryDirty)
+        Upload();
+    if (rangesDirty)
+        BuildRuns();
+    if (runs.empty())
+        return;
+
+    CameraBuffer::Update(viewMatrix, projectionMatrix);
+
+    // The vertex array has no instance attributes, the shaders read
+    // their current value: identity model matrix and no tint
+    glVertexAttrib3f(INSTANCE_ATTRIBUTE_LOC + 0, 1, 0, 0);
+    glVertexAttrib3f(INSTANCE_ATTRIBUTE_LOC + 1, 0, 1, 0);
+    glVertexAttrib3f(INSTANCE_ATTRIBUTE_LOC + 2, 0, 0, 1);
+    glVertexAttrib3f(INSTANCE_ATTRIBUTE_LOC + 3, 1, 1, 1);
+
+    GLState::BindVertexArray(buffers.m_VAO);
+    for (const auto &run : runs)
+    {
+        // Programs already in use are skipped by GLState
+        (run.shader ? run.shader : shader)->Use();
+
+        GLsizei count = static_cast<GLsizei>(run.counts.size());
+        glMultiDrawElementsBaseVertex(run.drawMode, run.counts.data(), GL_UNSIGNED_INT,
+            run.offsets.data(), count, run.baseVertices.data());
+        stats.drawCalls++;
+        stats.items += count;
+    }
+
+    CheckOpenGLError();
+}
+
+
+const StaticBatch2D::Stats &StaticBatch2D::GetStats() const
+{
+    return stats;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include "core/gpu/mesh.h"
+#include "core/gpu/shader.h"
+#include "utils/glm_utils.h"
+
+
+// 2D geometry that never moves, baked once into a single vertex and index buffer.
+// The vertices of each item are transformed on the CPU by its model matrix, its indices
+// are kept as they are and drawn from the base vertex of the item. The visible items are
+// drawn in the order they were added, one glMultiDrawElementsBaseVertex per run of
+// consecutive items sharing the same primitive and shader. Hiding or showing an item only rebuilds
+// the draw ranges, the buffers are uploaded again only when items are added or cleared.
+class StaticBatch2D
+{
+ public:
+    struct Stats
+    {
+        unsigned int drawCalls;         // glMultiDrawElementsBaseVertex calls issued by the last Render
+        unsigned int items;             // Items drawn by the last Render
+        unsigned int uploads;           // Uploads of the baked geometry since the start
+    };
+
+ public:
+    StaticBatch2D();
+    ~StaticBatch2D();
+
+    // Drop every item, the geometry is uploaded again at the next Render
+    void Clear();
+    // Bake the mesh, which must keep its vertices and indices on the CPU, drawn with
+    // the shader given to Render unless it has its own one, using the same attributes.
+    // Returns the index of the item or -1 if the mesh cannot be baked
+    int Add(const Mesh *mesh, const glm::mat3 &modelMatrix, Shader *shader = nullptr);
+    // Only marks the draw ranges dirty when the visibility actually changes
+    void SetVisible(int item, bool visible);
+    bool IsVisible(int item) const;
+    // Changes on every Add, Clear or change of visibility, to tell when a cached image is stale
+    unsigned int GetRevision() const;
+
+    // Upload what changed and draw the visible items with the Instanced2D shader or their own,
+    // the per-instance attributes stay disabled and read as the identity transform
+    void Render(Shader *shader, const glm::mat4 &viewMatrix, const glm::mat4 &projectionMatrix);
+
+    const Stats &GetStats() const;
+
+ private:
+    struct Item
+    {
+        GLenum drawMode;
+        Shader *shader;
+        GLsizei nrIndices;
+        unsigned int baseIndex;
+        GLint baseVertex;
+        bool visible;
+    };
+
+    // Consecutive visible items with the same primitive and shader, the arguments of one multi-draw
+    struct Run
+    {
+        GLenum drawMode;
+        Shader *shader;
+        std::vector<GLsizei> counts;
+        std::vector<const void *> offsets;
+        std::vector<GLint> baseVertices;
+    };
+
+    void Upload();
+    void BuildRuns();
+
+ private:
+    std::vector<VertexFormat> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<Item> items;
+    std::vector<Run> runs;
+    GPUBuffers buffers;
+    bool geometryDirty;
+    bool rangesDirty;
+    unsigned int revision;
+    Stats stats;
+};
@@ -1,5 +1,6 @@
 #include "core/gpu/texture2D.h"
 
+#include <cstring>
 #include <thread>
 #include <iostream>
 
@@ -9,6 +10,7 @@
 #include "stb/stb_image_write.h"
 
 #include "utils/memory_utils.h"
+#include "core/gpu/gl_state.h"
 
 
 void write_image_thread(const char* fileName, unsigned int width, unsigned int height, unsigned int channels, const unsigned char *data)
@@ -39,6 +41,7 @@ Texture2D::Texture2D()
     wrappingMode = GL_REPEAT;
     textureMinFilter = GL_LINEAR;
     textureMagFilter = GL_LINEAR;
+    imageData = nullptr;
 }
 
 
@@ -62,6 +65,16 @@ void Texture2D::Init(GLuint gpuTextureID, unsigned int width, unsigned int heigh
 
 
 bool Texture2D::Load2D(const char *fileName, GLenum wrapping_mode)
+{
+    if (!Decode(fileName, wrapping_mode))
+        return false;
+
+    UploadDecoded();
+    return true;
+}
+
+
+bool Texture2D::Decode(const char *fileName, GLenum wrapping_mode)
 {
     int width, height, chn;
     imageData = stbi_load(fileName, &width, &height, &chn, 0);
@@ -78,21 +91,56 @@ bool Texture2D::Load2D(const char *fileName, GLenum wrapping_mode)
     cout << width << " * " << height << " channels: " << chn << endl << endl;
 #endif
 
+    this->width = width;
+    this->height = height;
+    this->channels = chn;
     textureMinFilter = GL_LINEAR_MIPMAP_LINEAR;
     wrappingMode = wrapping_mode;
 
-    Init2DTexture(width, height, chn);
-    glTexImage2D(targetType, 0, internalFormat[0][chn], width, height, 0, pixelFormat[chn], GL_UNSIGNED_BYTE, imageData);
+    return true;
+}
+
+
+void Texture2D::UploadDecoded(GLuint pixelBuffer)
+{
+    Init2DTexture(width, height, channels);
+
+    // The pixels are copied to memory owned by the driver, which transfers them to the
+    // GPU while the frame goes on. Without the buffer glTexImage2D waits for the copy
+    const unsigned char *pixels = imageData;
+    if (pixelBuffer)
+    {
+        GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * channels;
+        GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        // Orphans the storage of the previous upload, which may still be in flight
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        void *staging = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (staging)
+        {
+            memcpy(staging, imageData, size);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            // Offset in the bound buffer
+            pixels = NULL;
+        }
+        else
+        {
+            GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            pixelBuffer = 0;
+        }
+    }
+
+    glTexImage2D(targetType, 0, internalFormat[0][channels], width, height, 0, pixelFormat[channels], GL_UNSIGNED_BYTE, pixels);
+    if (pixelBuffer)
+        GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
     glGenerateMipmap(targetType);
-    glBindTexture(targetType, 0);
+    GLState::BindTexture(targetType, 0);
     CheckOpenGLError();
 
     if (cacheInMemory == false)
     {
         stbi_image_free(imageData);
+        imageData = nullptr;
     }
-
-    return true;
 }
 
 
@@ -102,7 +150,7 @@ void Texture2D::SaveToFile(const char *fileName)
     {
         imageData = new unsigned char[width * height * channels];
     }
-    glBindTexture(targetType, textureID);
+    GLState::BindTexture(targetType, textureID);
     glGetTexImage(targetType, 0, pixelFormat[channels], GL_UNSIGNED_BYTE, (void *)imageData);
 
     stbi_write_png(fileName, width, height, channels, imageData, width * channels);
@@ -155,10 +203,10 @@ void Texture2D::CreateCubeTexture(const float *data, unsigned int width, unsigne
     this->height = height;
     targetType = GL_TEXTURE_CUBE_MAP;
 
-    glDeleteTextures(1, &textureID);
+    GLState::DeleteTextures(1, &textureID);
     glGenTextures(1, &textureID);
 
-    glBindTexture(targetType, textureID);
+    GLState::BindTexture(targetType, textureID);
     glTexParameteri(targetType, GL_TEXTURE_MIN_FILTER, textureMinFilter);
     glTexParameteri(targetType, GL_TEXTURE_MAG_FILTER, textureMagFilter);
     glTexParameteri(targetType, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -200,21 +248,21 @@ void Texture2D::CreateDepthBufferTexture(unsigned int width, unsigned int height
 
 void Texture2D::Bind() const
 {
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    GLState::BindTexture(GL_TEXTURE_2D, textureID);
 }
 
 
 void Texture2D::BindToTextureUnit(GLenum TextureUnit) const
 {
     if (!textureID) return;
-    glActiveTexture(TextureUnit);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    GLState::ActiveTexture(TextureUnit);
+    GLState::BindTexture(GL_TEXTURE_2D, textureID);
 }
 
 
 void Texture2D::UnBind() const
 {
-    glBindTexture(targetType, 0);
+    GLState::BindTexture(targetType, 0);
     CheckOpenGLError();
 }
 
@@ -271,7 +319,7 @@ void Texture2D::SetWrappingMode(GLenum mode)
 
     if (textureID)
     {
-        glBindTexture(targetType, textureID);
+        GLState::BindTexture(targetType, textureID);
         glTexParameteri(targetType, GL_TEXTURE_WRAP_S, mode);
         glTexParameteri(targetType, GL_TEXTURE_WRAP_T, mode);
         glTexParameteri(targetType, GL_TEXTURE_WRAP_R, mode);
@@ -284,7 +332,7 @@ void Texture2D::SetFiltering(GLenum minFilter, GLenum magFilter)
 {
     if (textureID)
     {
-        glBindTexture(targetType, textureID);
+        GLState::BindTexture(targetType, textureID);
 
         if (textureMinFilter != minFilter) {
             glTexParameteri(targetType, GL_TEXTURE_MIN_FILTER, minFilter);
@@ -308,9 +356,9 @@ void Texture2D::Init2DTexture(unsigned int width, unsigned int height, unsigned
     this->channels = channels;
 
     if (textureID)
-        glDeleteTextures(1, &textureID);
+        GLState::DeleteTextures(1, &textureID);
     glGenTextures(1, &textureID);
-    glBindTexture(targetType, textureID);
+    GLState::BindTexture(targetType, textureID);
     SetTextureParameters();
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
     CheckOpenGLError();
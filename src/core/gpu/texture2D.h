@@ -25,6 +25,11 @@ class Texture2D
     void CreateDepthBufferTexture(unsigned int width, unsigned int height);
 
     bool Load2D(const char* fileName, GLenum wrappingMode = GL_REPEAT);
+    // Load2D in two steps: Decode reads the file without any GL call, it can run on a worker
+    // thread, then UploadDecoded creates the texture on the thread owning the context,
+    // through the pixel buffer object when one is given
+    bool Decode(const char* fileName, GLenum wrappingMode = GL_REPEAT);
+    void UploadDecoded(GLuint pixelBuffer = 0);
     void SaveToFile(const char* fileName);
     void CacheInMemory(bool state);
 
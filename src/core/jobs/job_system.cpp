@@ -0,0 +1,319 @@
+#include "core/jobs/job_system.h"
+
+#include <algorithm>
+#include <iostream>
+
+
+std::vector<JobSystem::Worker *> JobSystem::workers;
+std::atomic<int> JobSystem::queuedTasks(0);
+std::atomic<unsigned int> JobSystem::nextWorker(0);
+std::atomic<bool> JobSystem::stopping(false);
+std::mutex JobSystem::sleepMutex;
+std::condition_variable JobSystem::sleepCondition;
+std::thread::id JobSystem::mainThread;
+
+std::mutex JobSystem::mainThreadMutex;
+std::vector<JobSystem::Task> JobSystem::mainThreadTasks;
+
+
+namespace
+{
+    // 0 outside the workers, the worker index + 1 inside
+    thread_local int threadIndex = 0;
+}
+
+
+JobCounter::JobCounter()
+    : pending(0)
+{
+}
+
+
+void JobSystem::Init(int workerCount)
+{
+    Shutdown();
+
+    if (workerCount < 0)
+    {
+        // hardware_concurrency is 0 when unknown, the jobs then run on the caller
+        int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = std::max(hardwareThreads - 1, 0);
+    }
+
+    mainThread = std::this_thread::get_id();
+    stopping = false;
+    for (int i = 0; i < workerCount; i++)
+    {
+        workers.push_back(new Worker());
+    }
+    // Started once every deque exists, a worker steals from all of them
+    for (int i = 0; i < workerCount; i++)
+    {
+        workers[i]->thread = std::thread(WorkerLoop, i);
+    }
+
+    std::cout << "JobSystem: " << workerCount << " worker threads" << std::endl;
+}
+
+
+void JobSystem::Shutdown()
+{
+    if (workers.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepCondition.notify_all();
+
+    // The workers leave once the deques are empty
+    for (Worker *worker : workers)
+    {
+        worker->thread.join();
+        delete worker;
+    }
+    workers.clear();
+    stopping = false;
+}
+
+
+int JobSystem::GetWorkerCount()
+{
+    return static_cast<int>(workers.size());
+}
+
+
+int JobSystem::GetThreadIndex()
+{
+    return threadIndex;
+}
+
+
+void JobSystem::Run(Job job, JobCounter *counter)
+{
+    if (counter)
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    Task task = { std::move(job), counter };
+    Push(std::move(task));
+}
+
+
+void JobSystem::RunAfter(JobCounter &dependency, Job job, JobCounter *counter)
+{
+    if (counter)
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        // Finish takes the same lock for the last decrement, the continuation is
+        // either queued before it or sees the dependency done
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+        if (!dependency.IsDone())
+        {
+            JobCounter::Continuation continuation = { std::move(job), counter };
+            dependency.continuations.push_back(std::move(continuation));
+            return;
+        }
+    }
+
+    Task task = { std::move(job), counter };
+    Push(std::move(task));
+}
+
+
+void JobSystem::Wait(JobCounter &counter)
+{
+    bool onMainThread = std::this_thread::get_id() == mainThread;
+
+    while (!counter.IsDone())
+    {
+        Task task;
+        if (Pop(task))
+        {
+            Execute(task);
+        }
+        // The jobs waited on may need the main thread
+        else if (!onMainThread || ExecuteMainThreadJobs() == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // The last job may still hold the lock of the counter, the caller can free it after this
+    std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+
+void JobSystem::ParallelFor(int begin, int end, int grainSize, const RangeJob &function)
+{
+    if (end <= begin)
+        return;
+
+    grainSize = std::max(grainSize, 1);
+    if (workers.empty() || end - begin <= grainSize)
+    {
+        function(begin, end);
+        return;
+    }
+
+    // The caller runs the first range instead of waiting idle
+    JobCounter counter;
+    int firstEnd = begin + grainSize;
+    for (int first = firstEnd; first < end;)
+    {
+        int last = first + std::min(grainSize, end - first);
+        Run([&function, first, last]() { function(first, last); }, &counter);
+        first = last;
+    }
+
+    function(begin, firstEnd);
+    Wait(counter);
+}
+
+
+void JobSystem::RunOnMainThread(Job job, JobCounter *counter)
+{
+    if (counter)
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    Task task = { std::move(job), counter };
+    std::lock_guard<std::mutex> lock(mainThreadMutex);
+    mainThreadTasks.push_back(std::move(task));
+}
+
+
+int JobSystem::ExecuteMainThreadJobs()
+{
+    // Jobs scheduled by these ones run next time
+    std::vector<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        if (mainThreadTasks.empty())
+            return 0;
+        tasks.swap(mainThreadTasks);
+    }
+
+    for (Task &task : tasks)
+    {
+        Execute(task);
+    }
+    return static_cast<int>(tasks.size());
+}
+
+
+void JobSystem::WorkerLoop(int index)
+{
+    threadIndex = index + 1;
+
+    while (true)
+    {
+        Task task;
+        if (Pop(task))
+        {
+            Execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, []() { return queuedTasks.load() > 0 || stopping.load(); });
+        if (stopping && queuedTasks.load() == 0)
+            break;
+    }
+}
+
+
+void JobSystem::Push(Task task)
+{
+    // Without worker the job runs right away
+    if (workers.empty())
+    {
+        Execute(task);
+        return;
+    }
+
+    // A worker keeps the jobs it starts, the other threads spread theirs
+    int index = threadIndex > 0 ? threadIndex - 1 : static_cast<int>(nextWorker++ % workers.size());
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks++;
+    }
+    sleepCondition.notify_one();
+}
+
+
+bool JobSystem::Pop(Task &task)
+{
+    if (workers.empty() || queuedTasks.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    // Newest job of the own deque first, still in the cache
+    int count = static_cast<int>(workers.size());
+    int own = threadIndex - 1;
+    if (own >= 0)
+    {
+        Worker *worker = workers[own];
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if (!worker->tasks.empty())
+        {
+            task = std::move(worker->tasks.back());
+            worker->tasks.pop_back();
+            queuedTasks--;
+            return true;
+        }
+    }
+
+    // Then the oldest job of another deque, likely the largest piece of work left
+    for (int i = 1; i <= count; i++)
+    {
+        int victim = (own + i + count) % count;
+        if (victim == own)
+            continue;
+
+        Worker *worker = workers[victim];
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if (!worker->tasks.empty())
+        {
+            task = std::move(worker->tasks.front());
+            worker->tasks.pop_front();
+            queuedTasks--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void JobSystem::Execute(Task &task)
+{
+    task.function();
+    Finish(task.counter);
+}
+
+
+void JobSystem::Finish(JobCounter *counter)
+{
+    if (!counter)
+        return;
+
+    std::vector<JobCounter::Continuation> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex);
+        if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        ready.swap(counter->continuations);
+    }
+
+    // The counter may be gone once unlocked, only the continuations moved out are used
+    for (JobCounter::Continuation &continuation : ready)
+    {
+        Task task = { std::move(continuation.function), continuation.counter };
+        Push(std::move(task));
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class JobSystem;
+
+// Number of jobs left to finish, to wait on or to start other jobs after.
+// A counter can be reused once it is done, it must outlive its jobs.
+class JobCounter
+{
+    friend class JobSystem;
+
+ public:
+    JobCounter();
+
+    bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+ private:
+    JobCounter(const JobCounter &) = delete;
+    JobCounter &operator=(const JobCounter &) = delete;
+
+ private:
+    struct Continuation
+    {
+        std::function<void()> function;
+        JobCounter *counter;
+    };
+
+    std::atomic<int> pending;
+    std::mutex mutex;                           // Guards the continuations and the last decrement
+    std::vector<Continuation> continuations;    // Scheduled when the counter reaches zero
+};
+
+
+// Pool of worker threads running short jobs, each worker owns a deque: it pushes and
+// pops its own jobs at the back and, once empty, steals the oldest job of another worker
+// from the front. A thread waiting on a counter runs jobs instead of blocking, so jobs
+// can wait on the jobs they start. Without worker thread the jobs run on the caller.
+// GL calls are only valid on the main thread, jobs hand them over with RunOnMainThread.
+// The profiler only records the main thread, zones opened inside jobs are ignored.
+class JobSystem
+{
+ public:
+    typedef std::function<void()> Job;
+    // Runs the range [first, last) of a ParallelFor
+    typedef std::function<void(int first, int last)> RangeJob;
+
+    // Start the workers, -1 starts one per hardware thread besides the calling one
+    static void Init(int workerCount = -1);
+    // Run the jobs left and join the workers
+    static void Shutdown();
+
+    static int GetWorkerCount();
+    // 0 outside the workers, the worker index + 1 inside, to index per-thread data
+    static int GetThreadIndex();
+
+    // Schedule a job, counted by the counter until it returns
+    static void Run(Job job, JobCounter *counter = nullptr);
+    // Schedule a job once the dependency is done, counted by the counter from now on
+    static void RunAfter(JobCounter &dependency, Job job, JobCounter *counter = nullptr);
+    // Run jobs until the counter is done
+    static void Wait(JobCounter &counter);
+
+    // Split [begin, end) in ranges of about grainSize items run in parallel, returns
+    // once they are all done. Small ranges run on the caller
+    static void ParallelFor(int begin, int end, int grainSize, const RangeJob &function);
+
+    // Schedule a job on the main thread, run by ExecuteMainThreadJobs
+    static void RunOnMainThread(Job job, JobCounter *counter = nullptr);
+    // Run the jobs scheduled on the main thread so far, returns their number
+    static int ExecuteMainThreadJobs();
+
+ private:
+    struct Task
+    {
+        Job function;
+        JobCounter *counter;
+    };
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+ private:
+    static void WorkerLoop(int index);
+    static void Push(Task task);
+    static bool Pop(Task &task);
+    static void Execute(Task &task);
+    static void Finish(JobCounter *counter);
+
+ private:
+    static std::vector<Worker *> workers;
+    static std::atomic<int> queuedTasks;        // Tasks in the deques, wakes the idle workers
+    static std::atomic<unsigned int> nextWorker;    // Deque of the next task pushed from outside the workers
+    static std::atomic<bool> stopping;
+    static std::mutex sleepMutex;
+    static std::condition_variable sleepCondition;
+    static std::thread::id mainThread;          // Thread of Init, runs the main thread jobs
+
+    static std::mutex mainThreadMutex;
+    static std::vector<Task> mainThreadTasks;
+};
@@ -0,0 +1,113 @@
+#include "core/managers/resource_loader.h"
+
+#include <chrono>
+#include <thread>
+
+#include "core/gpu/gl_state.h"
+
+
+std::mutex ResourceLoader::mutex;
+std::deque<ResourceLoader::Upload> ResourceLoader::uploads;
+double ResourceLoader::budgetMs = 2.0;
+GLuint ResourceLoader::pixelBuffer = 0;
+
+
+LoadHandle::LoadHandle()
+    : state(PENDING)
+{
+}
+
+
+void LoadHandle::Finish(bool success)
+{
+    state.store(success ? SUCCEEDED : FAILED, std::memory_order_release);
+}
+
+
+void ResourceLoader::QueueUpload(Upload upload)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    uploads.push_back(std::move(upload));
+}
+
+
+int ResourceLoader::ProcessUploads()
+{
+    auto start = std::chrono::steady_clock::now();
+    int count = 0;
+
+    while (true)
+    {
+        Upload upload;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (uploads.empty())
+                break;
+            upload = std::move(uploads.front());
+            uploads.pop_front();
+        }
+
+        // Run outside the lock, an upload may queue the uploads of its own resources
+        upload();
+        count++;
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= budgetMs)
+            break;
+    }
+
+    return count;
+}
+
+
+void ResourceLoader::Wait(const LoadHandle &handle)
+{
+    // The workers decode meanwhile, without worker the decoding already ran on this thread
+    while (!handle.IsDone())
+    {
+        if (ProcessUploads() == 0)
+            std::this_thread::yield();
+    }
+}
+
+
+void ResourceLoader::SetUploadBudget(double milliseconds)
+{
+    budgetMs = milliseconds;
+}
+
+
+double ResourceLoader::GetUploadBudget()
+{
+    return budgetMs;
+}
+
+
+int ResourceLoader::GetPendingUploads()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(uploads.size());
+}
+
+
+GLuint ResourceLoader::GetPixelBuffer()
+{
+    if (pixelBuffer == 0)
+        glGenBuffers(1, &pixelBuffer);
+    return pixelBuffer;
+}
+
+
+void ResourceLoader::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        uploads.clear();
+    }
+
+    if (pixelBuffer)
+    {
+        GLState::DeleteBuffers(1, &pixelBuffer);
+        pixelBuffer = 0;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "utils/gl_utils.h"
+
+
+// Progress of a resource loaded in the background, polled by its owner each frame.
+// The resource must not be used, nor freed, before the handle is done.
+class LoadHandle
+{
+ public:
+    LoadHandle();
+
+    bool IsDone() const { return state.load(std::memory_order_acquire) != PENDING; }
+    bool Succeeded() const { return state.load(std::memory_order_acquire) == SUCCEEDED; }
+
+    void Finish(bool success);
+
+ private:
+    LoadHandle(const LoadHandle &) = delete;
+    LoadHandle &operator=(const LoadHandle &) = delete;
+
+ private:
+    enum { PENDING, SUCCEEDED, FAILED };
+    std::atomic<int> state;
+};
+
+
+// Queue of the GL uploads of the resources decoded on the JobSystem workers. The file
+// reading and decoding run on the workers, the uploads run on the main thread, which
+// owns the context, a few per frame within a time budget so a burst of loads spreads
+// over several frames instead of stalling one. Textures go through a pixel buffer
+// object, glTexImage2D then returns without waiting for the transfer to the GPU.
+class ResourceLoader
+{
+ public:
+    typedef std::function<void()> Upload;
+
+    // Schedule a GL upload, from any thread
+    static void QueueUpload(Upload upload);
+    // Run the queued uploads until the budget is spent, at least one per call, returns their number
+    static int ProcessUploads();
+    // Run the uploads until the handle is done, for the loads the next frame cannot do without
+    static void Wait(const LoadHandle &handle);
+
+    // Main thread time given to the uploads each frame, 2 ms by default
+    static void SetUploadBudget(double milliseconds);
+    static double GetUploadBudget();
+    static int GetPendingUploads();
+
+    // Pixel buffer object staging the texture uploads, created on first use
+    static GLuint GetPixelBuffer();
+    // Drop the uploads left and release the pixel buffer object, before the context is gone
+    static void Shutdown();
+
+ private:
+    static std::mutex mutex;
+    static std::deque<Upload> uploads;
+    static double budgetMs;
+    static GLuint pixelBuffer;
+};
@@ -1,22 +1,27 @@
 #include "core/managers/texture_manager.h"
 
+#include <iostream>
+
 #include "core/gpu/texture2D.h"
+#include "core/jobs/job_system.h"
 #include "core/managers/resource_path.h"
 #include "utils/memory_utils.h"
 
 
 std::unordered_map<std::string, Texture2D*> TextureManager::mapTextures;
 std::vector<Texture2D*> TextureManager::vTextures;
+std::unordered_map<std::string, std::shared_ptr<LoadHandle>> TextureManager::pendingTextures;
 
 
 void TextureManager::Init(const std::string &selfDir)
 {
+    // Texture 0 is bound in place of the missing ones, it is needed from the first frame
     LoadTexture(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "default.png");
-    LoadTexture(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "white.png");
-    LoadTexture(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "black.jpg");
-    LoadTexture(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "noise.png");
-    LoadTexture(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "random.jpg");
-    LoadTexture(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "particle.png");
+    LoadTextureAsync(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "white.png");
+    LoadTextureAsync(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "black.jpg");
+    LoadTextureAsync(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "noise.png");
+    LoadTextureAsync(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "random.jpg");
+    LoadTextureAsync(PATH_JOIN(selfDir, RESOURCE_PATH::TEXTURES), "particle.png");
 }
 
 
@@ -48,6 +53,69 @@ Texture2D* TextureManager::LoadTexture(const std::string& path, const char* file
 }
 
 
+Texture2D* TextureManager::LoadTextureAsync(const std::string& path, const char* fileName, const char* key,
+                                            std::shared_ptr<LoadHandle>* handle, bool cacheInRAM)
+{
+    std::string uid = key ? std::string(key) : std::string(fileName);
+
+    // Already loading, the callers share the handle
+    auto pending = pendingTextures.find(uid);
+    if (pending != pendingTextures.end())
+    {
+        if (handle)
+            *handle = pending->second;
+        return GetTexture(uid.c_str());
+    }
+
+    std::shared_ptr<LoadHandle> load = std::make_shared<LoadHandle>();
+    if (handle)
+        *handle = load;
+
+    Texture2D* texture = GetTexture(uid.c_str());
+    if (texture)
+    {
+        load->Finish(texture->GetTextureID() != 0);
+        return texture;
+    }
+
+    // Registered now so the next requests get the same texture
+    texture = new Texture2D();
+    texture->CacheInMemory(cacheInRAM);
+    mapTextures[uid] = texture;
+    pendingTextures[uid] = load;
+
+    std::string file = path + (fileName ? (std::string(1, PATH_SEPARATOR) + fileName) : "");
+    JobSystem::Run([texture, uid, file, load]()
+    {
+        bool decoded = texture->Decode(file.c_str());
+
+        // The maps belong to the main thread, a failed load is reported there too
+        ResourceLoader::QueueUpload([texture, uid, file, load, decoded]()
+        {
+            if (decoded)
+            {
+                texture->UploadDecoded(ResourceLoader::GetPixelBuffer());
+                vTextures.push_back(texture);
+            }
+            else
+            {
+                // Same fallback as LoadTexture, the empty texture is left to the meshes already
+                // holding it, they draw without it since it has no texture id
+                std::cerr << "TextureManager: cannot load " << file << std::endl;
+                if (!vTextures.empty())
+                    mapTextures[uid] = vTextures[0];
+                else
+                    mapTextures.erase(uid);
+            }
+            pendingTextures.erase(uid);
+            load->Finish(decoded);
+        });
+    });
+
+    return texture;
+}
+
+
 void TextureManager::SetTexture(std::string name, Texture2D *texture)
 {
     mapTextures[name] = texture;
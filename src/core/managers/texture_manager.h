@@ -1,10 +1,12 @@
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <string>
 #include <vector>
 
 #include "core/gpu/texture2D.h"
+#include "core/managers/resource_loader.h"
 
 
 class TextureManager
@@ -12,6 +14,10 @@ class TextureManager
  public:
     static void Init(const std::string &selfDir);
     static Texture2D *LoadTexture(const std::string &Path, const char *fileName, const char *key = nullptr, bool forceLoad = false, bool cacheInRAM = false);
+    // Returns right away, the file is decoded on a worker and uploaded by ResourceLoader. The
+    // texture has no GL name, and binds nothing, until the handle is done
+    static Texture2D *LoadTextureAsync(const std::string &Path, const char *fileName, const char *key = nullptr,
+                                       std::shared_ptr<LoadHandle> *handle = nullptr, bool cacheInRAM = false);
     static void SetTexture(const std::string name, Texture2D * texture);
     static Texture2D* GetTexture(const char* name);
     static Texture2D* GetTexture(unsigned int textureID);
@@ -24,5 +30,6 @@ class TextureManager
  private:
     static std::unordered_map<std::string, Texture2D*> mapTextures;
     static std::vector<Texture2D*> vTextures;
+    static std::unordered_map<std::string, std::shared_ptr<LoadHandle>> pendingTextures;
     static std::string selfDir;
 };
@@ -0,0 +1,238 @@
+#include "core/profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+
+bool Profiler::enabled = false;
+bool Profiler::frameOpen = false;
+unsigned long long Profiler::frameIndex = 0;
+int Profiler::openZones[Profiler::MAX_ZONES];
+int Profiler::openZoneCount = 0;
+std::vector<Profiler::Frame> Profiler::frames;
+std::thread::id Profiler::thread;
+
+
+double Profiler::GetTimeMs()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+void Profiler::SetEnabled(bool enabled)
+{
+    // The frames are allocated once, recording never allocates
+    if (enabled && frames.empty())
+        frames.resize(MAX_FRAMES);
+
+    Profiler::enabled = enabled;
+    thread = std::this_thread::get_id();
+    frameOpen = false;
+    openZoneCount = 0;
+}
+
+
+void Profiler::BeginFrame()
+{
+    if (!enabled)
+        return;
+
+    Frame &frame = frames[frameIndex % MAX_FRAMES];
+    frame.index = frameIndex;
+    frame.startMs = GetTimeMs();
+    frame.cpuMs = 0;
+    frame.zoneCount = 0;
+
+    frameOpen = true;
+    openZoneCount = 0;
+}
+
+
+void Profiler::EndFrame()
+{
+    if (!enabled || !frameOpen)
+        return;
+
+    // Close the zones left open, a zone must not span two frames
+    while (openZoneCount > 0)
+        EndZone(openZones[openZoneCount - 1]);
+
+    Frame &frame = frames[frameIndex % MAX_FRAMES];
+    frame.cpuMs = GetTimeMs() - frame.startMs;
+
+    frameOpen = false;
+    frameIndex++;
+}
+
+
+int Profiler::BeginZone(const char *name)
+{
+    if (!enabled || !frameOpen || std::this_thread::get_id() != thread)
+        return -1;
+
+    Frame &frame = frames[frameIndex % MAX_FRAMES];
+    if (frame.zoneCount == MAX_ZONES)
+        return -1;
+
+    int zone = frame.zoneCount++;
+    frame.zones[zone].name = name;
+    frame.zones[zone].depth = openZoneCount;
+    frame.zones[zone].cpuMs = 0;
+    frame.zones[zone].gpuMs = -1;
+    openZones[openZoneCount++] = zone;
+
+    // Read the clock last, the bookkeeping above is not part of the zone
+    frame.zones[zone].startMs = GetTimeMs();
+    return zone;
+}
+
+
+void Profiler::EndZone(int zone)
+{
+    if (zone < 0 || !enabled || !frameOpen || openZoneCount == 0)
+        return;
+
+    double endMs = GetTimeMs();
+    Frame &frame = frames[frameIndex % MAX_FRAMES];
+
+    // Zones are scoped, the one closed is on top of the stack
+    while (openZoneCount > 0)
+    {
+        int closed = openZones[--openZoneCount];
+        frame.zones[closed].cpuMs = endMs - frame.zones[closed].startMs;
+        if (closed == zone)
+            break;
+    }
+}
+
+
+void Profiler::SetGpuTime(unsigned long long frameIndex, int zone, double gpuMs)
+{
+    if (frames.empty() || zone < 0 || zone >= MAX_ZONES)
+        return;
+
+    Frame &frame = frames[frameIndex % MAX_FRAMES];
+    if (frame.index != frameIndex || zone >= frame.zoneCount)
+        return;
+
+    frame.zones[zone].gpuMs = gpuMs;
+}
+
+
+unsigned long long Profiler::GetFrameIndex()
+{
+    return frameIndex;
+}
+
+
+int Profiler::GetFrameCount()
+{
+    // The slot of the oldest frame is reused by the frame being recorded
+    if (frames.empty())
+        return 0;
+    return frameIndex < MAX_FRAMES - 1 ? static_cast<int>(frameIndex) : MAX_FRAMES - 1;
+}
+
+
+const Profiler::Frame *Profiler::GetFrame(int age)
+{
+    if (age < 0 || age >= GetFrameCount())
+        return nullptr;
+    return &frames[(frameIndex - 1 - age) % MAX_FRAMES];
+}
+
+
+void Profiler::Summarize(int frameCount, std::vector<ZoneSummary> &summaries)
+{
+    summaries.clear();
+
+    // Frames walked, and frames holding a GPU result for each zone, read back a few frames late
+    int cpuFrames = 0;
+    std::vector<int> gpuFrames;
+    std::vector<int> lastGpuAge;
+    for (int age = 0; age < frameCount; age++)
+    {
+        const Frame *frame = GetFrame(age);
+        if (!frame)
+            break;
+        cpuFrames++;
+
+        for (int i = 0; i < frame->zoneCount; i++)
+        {
+            const Zone &zone = frame->zones[i];
+
+            // A handful of distinct zones, a linear search is enough
+            size_t s = 0;
+            while (s < summaries.size() && summaries[s].name != zone.name)
+                s++;
+            if (s == summaries.size())
+            {
+                ZoneSummary summary = { zone.name, zone.depth, 0.0, 0.0 };
+                summaries.push_back(summary);
+                gpuFrames.push_back(0);
+                lastGpuAge.push_back(-1);
+            }
+
+            summaries[s].cpuMs += zone.cpuMs;
+            if (zone.gpuMs >= 0)
+            {
+                summaries[s].gpuMs += zone.gpuMs;
+                if (lastGpuAge[s] != age)
+                {
+                    gpuFrames[s]++;
+                    lastGpuAge[s] = age;
+                }
+            }
+        }
+    }
+
+    for (size_t s = 0; s < summaries.size(); s++)
+    {
+        summaries[s].cpuMs /= cpuFrames;
+        summaries[s].gpuMs = gpuFrames[s] > 0 ? summaries[s].gpuMs / gpuFrames[s] : -1.0;
+    }
+}
+
+
+bool Profiler::WriteChromeTrace(const std::string &path)
+{
+    FILE *file = fopen(path.c_str(), "w");
+    if (!file)
+    {
+        std::cerr << "Profiler: cannot write the trace to " << path << std::endl;
+        return false;
+    }
+
+    // Complete events ("ph": "X") in microseconds, the CPU zones on thread 1
+    // and the GPU time of the same zones on thread 2, aligned on their CPU start
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n");
+    fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}");
+
+    for (int age = GetFrameCount() - 1; age >= 0; age--)
+    {
+        const Frame *frame = GetFrame(age);
+        fprintf(file, ",\n{\"name\":\"Frame %llu\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+            frame->index, frame->startMs * 1000.0, frame->cpuMs * 1000.0);
+
+        for (int i = 0; i < frame->zoneCount; i++)
+        {
+            const Zone &zone = frame->zones[i];
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                zone.name, zone.startMs * 1000.0, zone.cpuMs * 1000.0);
+            if (zone.gpuMs >= 0)
+            {
+                fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":%.3f,\"dur\":%.3f}",
+                    zone.name, zone.startMs * 1000.0, zone.gpuMs * 1000.0);
+            }
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    std::cout << "Profiler: " << GetFrameCount() << " frames written to " << path << std::endl;
+    return true;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// Frame profiler: each frame is split in named zones, timed on the CPU and optionally
+// on the GPU (see GpuTimer). The last MAX_FRAMES frames are kept in a ring buffer,
+// read by the on-screen overlay and written as a Chrome trace (chrome://tracing or
+// ui.perfetto.dev) for offline analysis. No OpenGL call is made here, the headless
+// driver profiles the simulation with the same zones.
+// Zone names are stored as pointers, they must be string literals. Only the thread that
+// enabled the profiler is recorded, zones opened by the jobs on other threads are ignored.
+class Profiler
+{
+ public:
+    static const int MAX_FRAMES = 240;          // Frames kept by the ring buffer
+    static const int MAX_ZONES = 64;            // Zones recorded per frame, the next ones are dropped
+
+    struct Zone
+    {
+        const char *name;
+        int depth;              // Number of zones open around this one
+        double startMs;         // Since the profiler started
+        double cpuMs;
+        double gpuMs;           // Negative until the GPU result is read back, or when not timed on the GPU
+    };
+
+    struct Frame
+    {
+        unsigned long long index;
+        double startMs;
+        double cpuMs;
+        int zoneCount;
+        Zone zones[MAX_ZONES];
+    };
+
+    // Time per frame of the zones of the same name, averaged over the last frames
+    struct ZoneSummary
+    {
+        const char *name;
+        int depth;
+        double cpuMs;
+        double gpuMs;           // Negative when no GPU time was read back for the zone
+    };
+
+ public:
+    // Zones are only recorded while enabled, a disabled zone costs one branch
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled() { return enabled; }
+
+    static void BeginFrame();
+    static void EndFrame();
+
+    // Open a zone of the current frame, returns its index in the frame, -1 if not recorded
+    static int BeginZone(const char *name);
+    static void EndZone(int zone);
+    // Attach the GPU time read back for a zone, ignored once the frame left the ring buffer
+    static void SetGpuTime(unsigned long long frameIndex, int zone, double gpuMs);
+
+    // Index of the frame being recorded, the first frame is 0
+    static unsigned long long GetFrameIndex();
+    // Completed frames kept by the ring buffer, age 0 is the last one, nullptr past the oldest
+    static int GetFrameCount();
+    static const Frame *GetFrame(int age);
+
+    // Time per frame of each zone over the last frameCount frames, in order of first appearance.
+    // A zone entered several times in a frame (fixed timestep ticks) counts the sum of its times
+    static void Summarize(int frameCount, std::vector<ZoneSummary> &summaries);
+    // Write the frames kept by the ring buffer in the Chrome trace event format
+    static bool WriteChromeTrace(const std::string &path);
+
+ private:
+    static double GetTimeMs();
+
+ private:
+    static bool enabled;
+    static bool frameOpen;
+    static unsigned long long frameIndex;
+    static int openZones[MAX_ZONES];            // Stack of the zones opened and not closed yet
+    static int openZoneCount;
+    static std::vector<Frame> frames;           // Ring buffer, slot frameIndex % MAX_FRAMES
+    static std::thread::id thread;              // Thread recorded
+};
+
+
+// Scoped zone, closed when it goes out of scope
+class ProfileZone
+{
+ public:
+    explicit ProfileZone(const char *name) : zone(Profiler::IsEnabled() ? Profiler::BeginZone(name) : -1) {}
+    ~ProfileZone() { if (zone >= 0) Profiler::EndZone(zone); }
+
+    int GetZone() const { return zone; }
+
+ private:
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+ private:
+    int zone;
+};
+
+
+#define PROFILE_CONCAT_INNER(a, b)  a##b
+#define PROFILE_CONCAT(a, b)        PROFILE_CONCAT_INNER(a, b)
+
+// Time the rest of the enclosing scope on the CPU
+#define PROFILE_ZONE(name)          ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
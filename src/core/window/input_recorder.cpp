@@ -0,0 +1,277 @@
+#include "core/window/input_recorder.h"
+
+#include <cstring>
+#include <iostream>
+
+
+bool InputRecorder::recording = false;
+bool InputRecorder::replaying = false;
+FILE *InputRecorder::file = nullptr;
+std::string InputRecorder::path;
+
+unsigned int InputRecorder::seed = 0;
+glm::ivec2 InputRecorder::resolution = glm::ivec2(0);
+double InputRecorder::tickRate = 0;
+unsigned int InputRecorder::tick = 0;
+unsigned int InputRecorder::tickCount = 0;
+unsigned int InputRecorder::eventCount = 0;
+
+std::vector<InputEvent> InputRecorder::events;
+size_t InputRecorder::nextEvent = 0;
+
+
+namespace
+{
+    const char MAGIC[4] = { 'P', 'V', 'Z', 'I' };
+    const unsigned short VERSION = 1;
+
+    // The file is little-endian whatever the platform
+    void PutU16(unsigned char *bytes, unsigned int value)
+    {
+        bytes[0] = static_cast<unsigned char>(value);
+        bytes[1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    void PutU32(unsigned char *bytes, unsigned int value)
+    {
+        PutU16(bytes, value & 0xFFFF);
+        PutU16(bytes + 2, value >> 16);
+    }
+
+    unsigned int GetU16(const unsigned char *bytes)
+    {
+        return bytes[0] | (bytes[1] << 8);
+    }
+
+    unsigned int GetU32(const unsigned char *bytes)
+    {
+        return GetU16(bytes) | (GetU16(bytes + 2) << 16);
+    }
+
+    int GetI16(const unsigned char *bytes)
+    {
+        return static_cast<short>(GetU16(bytes));
+    }
+}
+
+
+bool InputRecorder::StartRecording(const std::string &path, unsigned int seed, glm::ivec2 resolution)
+{
+    Stop();
+
+    file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        std::cerr << "InputRecorder: cannot write the recording to " << path << std::endl;
+        return false;
+    }
+
+    InputRecorder::path = path;
+    InputRecorder::seed = seed;
+    InputRecorder::resolution = resolution;
+    tick = 0;
+    tickCount = 0;
+    eventCount = 0;
+
+    // Written again by Stop with the number of ticks and events
+    WriteHeader();
+    recording = true;
+
+    std::cout << "InputRecorder: recording to " << path << ", seed " << seed << std::endl;
+    return true;
+}
+
+
+bool InputRecorder::StartReplay(const std::string &path)
+{
+    Stop();
+
+    FILE *input = fopen(path.c_str(), "rb");
+    if (!input)
+    {
+        std::cerr << "InputRecorder: cannot read the recording " << path << std::endl;
+        return false;
+    }
+
+    unsigned char header[HEADER_SIZE];
+    if (fread(header, 1, HEADER_SIZE, input) != HEADER_SIZE || memcmp(header, MAGIC, 4) != 0
+        || GetU16(header + 4) != VERSION)
+    {
+        std::cerr << "InputRecorder: " << path << " is not a version " << VERSION << " recording" << std::endl;
+        fclose(input);
+        return false;
+    }
+
+    seed = GetU32(header + 8);
+    unsigned long long tickRateBits = GetU32(header + 12) | (static_cast<unsigned long long>(GetU32(header + 16)) << 32);
+    memcpy(&tickRate, &tickRateBits, sizeof(tickRate));
+    tickCount = GetU32(header + 20);
+    eventCount = GetU32(header + 24);
+    resolution = glm::ivec2(GetI16(header + 28), GetI16(header + 30));
+
+    events.clear();
+    events.reserve(eventCount);
+    unsigned char bytes[EVENT_SIZE];
+    while (fread(bytes, 1, EVENT_SIZE, input) == EVENT_SIZE)
+    {
+        InputEvent event;
+        event.tick = GetU32(bytes);
+        event.type = static_cast<InputEventType>(bytes[4]);
+        event.mods = bytes[5];
+        event.x = GetI16(bytes + 6);
+        event.y = GetI16(bytes + 8);
+        event.a = GetI16(bytes + 10);
+        event.b = GetI16(bytes + 12);
+        events.push_back(event);
+    }
+    fclose(input);
+
+    // A session that did not stop cleanly has no tick count, it ends with its last event
+    if (tickCount == 0 && !events.empty())
+    {
+        tickCount = events.back().tick + 1;
+    }
+    if (events.size() != eventCount)
+    {
+        std::cerr << "InputRecorder: " << path << " holds " << events.size() << " events, "
+                  << eventCount << " expected" << std::endl;
+    }
+
+    InputRecorder::path = path;
+    tick = 0;
+    nextEvent = 0;
+    replaying = true;
+
+    std::cout << "InputRecorder: replaying " << path << ", " << tickCount << " ticks, "
+              << events.size() << " events, seed " << seed << std::endl;
+    return true;
+}
+
+
+void InputRecorder::Stop()
+{
+    if (recording)
+    {
+        tickCount = tick;
+        WriteHeader();
+        fclose(file);
+        file = nullptr;
+        recording = false;
+
+        std::cout << "InputRecorder: " << tickCount << " ticks, " << eventCount << " events written to " << path << std::endl;
+    }
+
+    if (replaying)
+    {
+        events.clear();
+        events.shrink_to_fit();
+        nextEvent = 0;
+        replaying = false;
+    }
+}
+
+
+void InputRecorder::WriteHeader()
+{
+    unsigned char header[HEADER_SIZE];
+    memcpy(header, MAGIC, 4);
+    PutU16(header + 4, VERSION);
+    PutU16(header + 6, 0);
+    PutU32(header + 8, seed);
+
+    unsigned long long tickRateBits;
+    memcpy(&tickRateBits, &tickRate, sizeof(tickRate));
+    PutU32(header + 12, static_cast<unsigned int>(tickRateBits));
+    PutU32(header + 16, static_cast<unsigned int>(tickRateBits >> 32));
+
+    PutU32(header + 20, tickCount);
+    PutU32(header + 24, eventCount);
+    PutU16(header + 28, resolution.x);
+    PutU16(header + 30, resolution.y);
+
+    // The events are appended after the header, the file position is restored
+    long position = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    fwrite(header, 1, HEADER_SIZE, file);
+    if (position > HEADER_SIZE)
+        fseek(file, position, SEEK_SET);
+}
+
+
+void InputRecorder::SetTickRate(double tickRate)
+{
+    if (replaying && InputRecorder::tickRate != tickRate)
+    {
+        std::cerr << "InputRecorder: recorded at " << InputRecorder::tickRate << " ticks/s, replayed at "
+                  << tickRate << " ticks/s, the game will not match the recording" << std::endl;
+        return;
+    }
+    InputRecorder::tickRate = tickRate;
+}
+
+
+void InputRecorder::AdvanceTick()
+{
+    if (recording || replaying)
+        tick++;
+}
+
+
+void InputRecorder::Record(const InputEvent &event)
+{
+    if (!recording)
+        return;
+
+    unsigned char bytes[EVENT_SIZE];
+    PutU32(bytes, tick);
+    bytes[4] = static_cast<unsigned char>(event.type);
+    bytes[5] = static_cast<unsigned char>(event.mods);
+    PutU16(bytes + 6, event.x);
+    PutU16(bytes + 8, event.y);
+    PutU16(bytes + 10, event.a);
+    PutU16(bytes + 12, event.b);
+
+    // Buffered by stdio, a frame of events costs no system call
+    fwrite(bytes, 1, EVENT_SIZE, file);
+    eventCount++;
+}
+
+
+bool InputRecorder::NextReplayEvent(InputEvent &event)
+{
+    if (!replaying || nextEvent == events.size() || events[nextEvent].tick > tick)
+        return false;
+
+    event = events[nextEvent++];
+    return true;
+}
+
+
+unsigned int InputRecorder::GetSeed()
+{
+    return seed;
+}
+
+
+glm::ivec2 InputRecorder::GetResolution()
+{
+    return resolution;
+}
+
+
+double InputRecorder::GetTickRate()
+{
+    return tickRate;
+}
+
+
+unsigned int InputRecorder::GetTick()
+{
+    return tick;
+}
+
+
+unsigned int InputRecorder::GetTickCount()
+{
+    return tickCount;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "utils/glm_utils.h"
+
+
+// Input events in the order WindowObject delivers them to the observers
+enum class InputEventType : unsigned char
+{
+    WINDOW_RESIZE = 0,
+    MOUSE_MOVE,
+    MOUSE_BTN_PRESS,
+    MOUSE_BTN_RELEASE,
+    MOUSE_SCROLL,
+    KEY_PRESS,
+    KEY_RELEASE
+};
+
+
+// One event delivered to the observers, the meaning of the fields depends on the type:
+//   WINDOW_RESIZE      x, y = new resolution
+//   MOUSE_MOVE         x, y = cursor position, a, b = offset from the last position
+//   MOUSE_BTN_*        x, y = cursor position, a = bit-mask of the buttons
+//   MOUSE_SCROLL       x, y = cursor position, a, b = scroll steps
+//   KEY_*              a = GLFW_KEY_"KEYCODE"
+struct InputEvent
+{
+    unsigned int tick;          // Simulation ticks run before the event was delivered
+    InputEventType type;
+    int mods;
+    int x, y;
+    int a, b;
+};
+
+
+// Records the input events delivered to the observers, keyed by simulation tick, and the
+// seed of the game to a binary file, then plays them back at the same ticks. A recorded
+// session replays the same game on any build, as fast as the frames go, so two builds can
+// be compared on the same gameplay. The tick is advanced by World after each FixedUpdate,
+// or once per frame without a fixed timestep, which is then only frame-accurate.
+//
+// File layout, little-endian:
+//   header   "PVZI", version u16, reserved u16, seed u32, tick rate f64, ticks u32,
+//            events u32, window width i16, window height i16            (32 bytes)
+//   events   tick u32, type u8, mods u8, x i16, y i16, a i16, b i16      (14 bytes each)
+class InputRecorder
+{
+ public:
+    static const int HEADER_SIZE = 32;
+    static const int EVENT_SIZE = 14;
+
+    // Write the events delivered from now on, the header is completed by Stop
+    static bool StartRecording(const std::string &path, unsigned int seed, glm::ivec2 resolution);
+    // Load a recording, the game must be created with its seed and window resolution
+    static bool StartReplay(const std::string &path);
+    // Complete and close the recording, or end the replay
+    static void Stop();
+
+    static bool IsRecording() { return recording; }
+    static bool IsReplaying() { return replaying; }
+    // Every recorded tick was played back
+    static bool IsReplayFinished() { return replaying && tick >= tickCount; }
+
+    static unsigned int GetSeed();
+    static glm::ivec2 GetResolution();
+    static double GetTickRate();
+    // Recorded along the events, a replay at another tick rate warns that it cannot match
+    static void SetTickRate(double tickRate);
+
+    static unsigned int GetTick();
+    static unsigned int GetTickCount();
+    static void AdvanceTick();
+
+    static void Record(const InputEvent &event);
+    // Next recorded event due at the current tick, false once they were all delivered
+    static bool NextReplayEvent(InputEvent &event);
+
+ private:
+    static void WriteHeader();
+
+ private:
+    static bool recording;
+    static bool replaying;
+    static FILE *file;
+    static std::string path;
+
+    static unsigned int seed;
+    static glm::ivec2 resolution;
+    static double tickRate;
+    static unsigned int tick;
+    static unsigned int tickCount;              // Recorded ticks, known at the end of the recording
+    static unsigned int eventCount;
+
+    static std::vector<InputEvent> events;      // Replayed events, in delivery order
+    static size_t nextEvent;
+};
@@ -5,6 +5,7 @@
 #include "core/engine.h"
 #include "core/window/window_callbacks.h"
 #include "core/window/input_controller.h"
+#include "core/window/input_recorder.h"
 
 #include "utils/gl_utils.h"
 #include "utils/memory_utils.h"
@@ -329,56 +330,63 @@ void WindowObject::UpdateObservers()
 {
     ComputeFrameTime();
 
+    // A replay delivers the recorded events in place of the live ones,
+    // only closing the window still ends it
+    if (InputRecorder::IsReplaying())
+    {
+        resizeEvent = false;
+        mouseMoveEvent = false;
+        scrollEvent = false;
+        registeredKeyEvents = 0;
+        mouseButtonAction = 0;
+
+        InputEvent event;
+        while (InputRecorder::NextReplayEvent(event))
+        {
+            ReplayEvent(event);
+        }
+    }
+
     // Signal window resize
     if (resizeEvent)
     {
         resizeEvent = false;
-        for (auto obs : observers) {
-            obs->OnWindowResize(props.resolution.x, props.resolution.y);
-        }
+        DispatchEvent(InputEventType::WINDOW_RESIZE, 0, props.resolution.x, props.resolution.y, 0, 0);
     }
 
     // Signal mouse move event
     if (mouseMoveEvent)
     {
         mouseMoveEvent = false;
-        for (auto obs : observers) {
-            obs->OnMouseMove(props.cursorPos.x, props.cursorPos.y, mouseDeltaX, mouseDeltaY);
-        }
+        DispatchEvent(InputEventType::MOUSE_MOVE, 0, props.cursorPos.x, props.cursorPos.y, mouseDeltaX, mouseDeltaY);
     }
 
     // Signal mouse button press event
     auto pressEvent = mouseButtonAction & mouseButtonStates;
     if (pressEvent)
     {
-        for (auto obs : observers) {
-            obs->OnMouseBtnPress(props.cursorPos.x, props.cursorPos.y, pressEvent, keyMods);
-        }
+        DispatchEvent(InputEventType::MOUSE_BTN_PRESS, keyMods, props.cursorPos.x, props.cursorPos.y, pressEvent, 0);
     }
 
     // Signal mouse button release event
     auto releaseEvent = mouseButtonAction & (~mouseButtonStates);
     if (releaseEvent)
     {
-        for (auto obs : observers) {
-            obs->OnMouseBtnRelease(props.cursorPos.x, props.cursorPos.y, releaseEvent, keyMods);
-        }
+        DispatchEvent(InputEventType::MOUSE_BTN_RELEASE, keyMods, props.cursorPos.x, props.cursorPos.y, releaseEvent, 0);
     }
 
     // Signal mouse scroll event
     if (scrollEvent) {
         scrollEvent = false;
-        for (auto obs : observers) {
-            obs->OnMouseScroll(props.cursorPos.x, props.cursorPos.y, mouseScrollDeltaX, mouseScrollDeltaY);
-        }
+        DispatchEvent(InputEventType::MOUSE_SCROLL, 0, props.cursorPos.x, props.cursorPos.y, mouseScrollDeltaX, mouseScrollDeltaY);
     }
 
     // Signal key events
     if (registeredKeyEvents)
     {
         for (int i = 0; i < registeredKeyEvents; i++) {
-            for (auto obs : observers)
-                keyStates[keyEvents[i]] ? obs->OnKeyPress(keyEvents[i], keyMods) : obs->OnKeyRelease(keyEvents[i], keyMods);
+            int key = keyEvents[i];
+            DispatchEvent(keyStates[key] ? InputEventType::KEY_PRESS : InputEventType::KEY_RELEASE, keyMods, 0, 0, key, 0);
         }
         registeredKeyEvents = 0;
     }
@@ -392,6 +400,75 @@ void WindowObject::UpdateObservers()
 }
 
 
+void WindowObject::DispatchEvent(InputEventType type, int mods, int x, int y, int a, int b)
+{
+    if (InputRecorder::IsRecording())
+    {
+        InputEvent event = { InputRecorder::GetTick(), type, mods, x, y, a, b };
+        InputRecorder::Record(event);
+    }
+
+    switch (type)
+    {
+    case InputEventType::WINDOW_RESIZE:
+        for (auto obs : observers)
+            obs->OnWindowResize(x, y);
+        break;
+    case InputEventType::MOUSE_MOVE:
+        for (auto obs : observers)
+            obs->OnMouseMove(x, y, a, b);
+        break;
+    case InputEventType::MOUSE_BTN_PRESS:
+        for (auto obs : observers)
+            obs->OnMouseBtnPress(x, y, a, mods);
+        break;
+    case InputEventType::MOUSE_BTN_RELEASE:
+        for (auto obs : observers)
+            obs->OnMouseBtnRelease(x, y, a, mods);
+        break;
+    case InputEventType::MOUSE_SCROLL:
+        for (auto obs : observers)
+            obs->OnMouseScroll(x, y, a, b);
+        break;
+    case InputEventType::KEY_PRESS:
+        for (auto obs : observers)
+            obs->OnKeyPress(a, mods);
+        break;
+    case InputEventType::KEY_RELEASE:
+        for (auto obs : observers)
+            obs->OnKeyRelease(a, mods);
+        break;
+    }
+}
+
+
+void WindowObject::ReplayEvent(const InputEvent &event)
+{
+    // The window takes the recorded state, the game reads the resolution and the cursor
+    switch (event.type)
+    {
+    case InputEventType::WINDOW_RESIZE:
+        if (props.resolution != glm::ivec2(event.x, event.y))
+        {
+            SetSize(static_cast<int>(event.x / props.scaleFactor), static_cast<int>(event.y / props.scaleFactor));
+            resizeEvent = false;
+        }
+        break;
+    case InputEventType::KEY_PRESS:
+    case InputEventType::KEY_RELEASE:
+        if (event.a >= 0 && event.a < 384)
+            keyStates[event.a] = event.type == InputEventType::KEY_PRESS;
+        break;
+    default:
+        props.cursorPos = glm::ivec2(event.x, event.y);
+        break;
+    }
+    keyMods = event.mods;
+
+    DispatchEvent(event.type, event.mods, event.x, event.y, event.a, event.b);
+}
+
+
 void WindowObject::MakeCurrentContext() const
 {
     glfwMakeContextCurrent(window->handle);
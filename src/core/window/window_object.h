@@ -4,6 +4,7 @@
 #include <list>
 
 #include "core/window/input_controller.h"
+#include "core/window/input_recorder.h"
 #include "core/window/window_callbacks.h"
 
 #include "utils/glm_utils.h"
@@ -105,6 +106,11 @@ class WindowObject
     void MouseMove(int posX, int posY);
     void MouseScroll(double offsetX, double offsetY);
 
+    // Deliver an event to the observers, written to the recording when one is active
+    void DispatchEvent(InputEventType type, int mods, int x, int y, int a, int b);
+    // Deliver a recorded event, after applying it to the window state
+    void ReplayEvent(const InputEvent &event);
+
     // Subscribe to receive input events
     void SubscribeToEvents(InputController * IC);
     void UnsubscribeFromEvents(InputController * IC);
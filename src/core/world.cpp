@@ -1,8 +1,18 @@
 #include "core/world.h"
 
+#include <cmath>
+#include <iostream>
+
 #include "core/engine.h"
+#include "core/profiler.h"
+#include "core/gpu/gl_state.h"
+#include "core/gpu/gpu_timer.h"
+#include "core/jobs/job_system.h"
+#include "core/managers/resource_loader.h"
+#include "core/window/input_recorder.h"
 #include "components/camera_input.h"
 #include "components/transform.h"
+#include "utils/text_utils.h"
 
 
 World::World()
@@ -13,7 +23,16 @@ World::World()
     paused = false;
     shouldClose = false;
 
+    fixedTimestep = false;
+    fixedDeltaTime = 0;
+    maxCatchUpSteps = 0;
+    accumulator = 0;
+    interpolationAlpha = 1;
+
     window = Engine::GetWindow();
+
+    // Every frame is profiled, the overlay and the trace read the last frames
+    Profiler::SetEnabled(true);
 }
 
 
@@ -22,10 +41,29 @@ void World::Run()
     if (!window)
         return;
 
-    while (!window->ShouldClose())
+    double startTime = Engine::GetElapsedTime();
+    unsigned long long frames = 0;
+
+    // A replay ends with the last recorded tick
+    while (!window->ShouldClose() && !InputRecorder::IsReplayFinished())
     {
         LoopUpdate();
+        frames++;
     }
+
+    // Same gameplay on every build, the replay time compares them
+    if (InputRecorder::IsReplaying())
+    {
+        double seconds = Engine::GetElapsedTime() - startTime;
+        std::cout << "Replay: " << InputRecorder::GetTick() << " / " << InputRecorder::GetTickCount() << " ticks, "
+                  << frames << " frames in " << seconds << " s, "
+                  << (frames ? seconds * 1000.0 / frames : 0.0) << " ms/frame" << std::endl;
+    }
+    InputRecorder::Stop();
+
+    // Last frames for offline analysis, open the file in chrome://tracing or ui.perfetto.dev
+    Profiler::WriteChromeTrace(PATH_JOIN(window->props.selfDir, "profile_trace.json"));
+    GpuTimer::Release();
 }
 
 
@@ -48,6 +86,85 @@ double World::GetLastFrameTime()
 }
 
 
+void World::SetFixedTimestep(double tickRate, int maxCatchUpSteps)
+{
+    if (tickRate <= 0 || maxCatchUpSteps <= 0)
+    {
+        std::cerr << "World: invalid fixed timestep, " << tickRate << " ticks/s, "
+                  << maxCatchUpSteps << " catch-up steps" << std::endl;
+        return;
+    }
+
+    fixedTimestep = true;
+    fixedDeltaTime = 1.0 / tickRate;
+    InputRecorder::SetTickRate(tickRate);
+    this->maxCatchUpSteps = maxCatchUpSteps;
+    accumulator = 0;
+    interpolationAlpha = 0;
+}
+
+
+void World::DisableFixedTimestep()
+{
+    fixedTimestep = false;
+    accumulator = 0;
+    interpolationAlpha = 1;
+}
+
+
+bool World::IsFixedTimestep() const
+{
+    return fixedTimestep;
+}
+
+
+double World::GetFixedDeltaTime() const
+{
+    return fixedDeltaTime;
+}
+
+
+float World::GetInterpolationAlpha() const
+{
+    return interpolationAlpha;
+}
+
+
+void World::RunFixedSteps()
+{
+    // A replay runs one tick per frame, as fast as the frames go, the recorded
+    // events of each tick are delivered before it whatever the frame time
+    if (InputRecorder::IsReplaying())
+    {
+        FixedUpdate(static_cast<float>(fixedDeltaTime));
+        InputRecorder::AdvanceTick();
+        accumulator = 0;
+        interpolationAlpha = 0;
+        return;
+    }
+
+    accumulator += deltaTime;
+
+    int steps = 0;
+    while (accumulator >= fixedDeltaTime && steps < maxCatchUpSteps)
+    {
+        FixedUpdate(static_cast<float>(fixedDeltaTime));
+        InputRecorder::AdvanceTick();
+        accumulator -= fixedDeltaTime;
+        steps++;
+    }
+
+    // Too far behind (breakpoint, window drag, slow frame): the simulation
+    // slows down for this frame instead of spiraling into ever longer frames
+    if (accumulator >= fixedDeltaTime)
+    {
+        accumulator = std::fmod(accumulator, fixedDeltaTime);
+    }
+
+    interpolationAlpha = static_cast<float>(accumulator / fixedDeltaTime);
+}
+
+
 void World::ComputeFrameDeltaTime()
 {
     elapsedTime = Engine::GetElapsedTime();
@@ -58,8 +175,16 @@ void World::ComputeFrameDeltaTime()
 
 void World::LoopUpdate()
 {
+    Profiler::BeginFrame();
+    GLState::BeginFrame();
+    // GPU times of the previous frames, read only once available
+    GpuTimer::Collect();
+
     // Polls and buffers the events
-    window->PollEvents();
+    {
+        PROFILE_ZONE("PollEvents");
+        window->PollEvents();
+    }
 
     // Computes frame deltaTime in seconds
     ComputeFrameDeltaTime();
@@ -67,13 +192,51 @@ void World::LoopUpdate()
     // Calls the methods of the instance of InputController in the following order
     // OnWindowResize, OnMouseMove, OnMouseBtnPress, OnMouseBtnRelease, OnMouseScroll, OnKeyPress, OnMouseScroll, OnInputUpdate
     // OnInputUpdate will be called each frame, the other functions are called only if an event is registered
-    window->UpdateObservers();
+    {
+        PROFILE_ZONE("Input");
+        window->UpdateObservers();
+    }
+
+    // GL work handed over by the jobs since the last frame
+    {
+        PROFILE_ZONE("MainThreadJobs");
+        JobSystem::ExecuteMainThreadJobs();
+    }
+    // Textures and meshes decoded by the workers, uploaded within the frame budget
+    {
+        PROFILE_ZONE("Uploads");
+        ResourceLoader::ProcessUploads();
+    }
 
     // Frame processing
-    FrameStart();
-    Update(static_cast<float>(deltaTime));
-    FrameEnd();
+    {
+        PROFILE_ZONE("FrameStart");
+        FrameStart();
+    }
+    if (fixedTimestep)
+    {
+        PROFILE_ZONE("FixedUpdate");
+        RunFixedSteps();
+    }
+    {
+        PROFILE_ZONE("Update");
+        Update(static_cast<float>(deltaTime));
+    }
+    // Without a fixed timestep the input is recorded per frame
+    if (!fixedTimestep)
+    {
+        InputRecorder::AdvanceTick();
+    }
+    {
+        PROFILE_ZONE("FrameEnd");
+        FrameEnd();
+    }
 
     // Swap front and back buffers - image will be displayed to the screen
-    window->SwapBuffers();
+    {
+        PROFILE_ZONE("SwapBuffers");
+        window->SwapBuffers();
+    }
+
+    Profiler::EndFrame();
 }
@@ -10,6 +10,9 @@ class World : public InputController
     virtual ~World() {}
     virtual void Init() {}
     virtual void FrameStart() {}
+    // Called at the fixed tick rate, zero or more times per frame before Update,
+    // only when the fixed timestep is enabled
+    virtual void FixedUpdate(float fixedDeltaTimeSeconds) {}
     virtual void Update(float deltaTimeSeconds) {}
     virtual void FrameEnd() {}
 
@@ -19,8 +22,19 @@ class World : public InputController
 
     double GetLastFrameTime();
 
+    // Step FixedUpdate tickRate times per second of frame time, at most maxCatchUpSteps
+    // times per frame: after a stall the time left over is dropped instead of simulated
+    void SetFixedTimestep(double tickRate, int maxCatchUpSteps);
+    void DisableFixedTimestep();
+    bool IsFixedTimestep() const;
+    double GetFixedDeltaTime() const;
+    // Fraction of a tick elapsed since the last FixedUpdate, in [0, 1), to interpolate
+    // the rendered positions between the last two ticks
+    float GetInterpolationAlpha() const;
+
  private:
     void ComputeFrameDeltaTime();
+    void RunFixedSteps();
     void LoopUpdate();
 
  private:
@@ -29,4 +43,10 @@ class World : public InputController
     double deltaTime;
     bool paused;
     bool shouldClose;
+
+    bool fixedTimestep;
+    double fixedDeltaTime;
+    int maxCatchUpSteps;
+    double accumulator;         // Frame time not simulated yet
+    float interpolationAlpha;
 };
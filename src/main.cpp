@@ -1,8 +1,10 @@
+#include <cstring>
 #include <ctime>
 #include <iostream>
 
 #include "core/engine.h"
 #include "components/simple_scene.h"
+#include "core/window/input_recorder.h"
 
 #include "Plants_VS_Zombies/Plants_VS_Zombies.h"
 
@@ -21,7 +23,15 @@ std::string GetParentDir(const std::string &filePath)
 
 int main(int argc, char **argv)
 {
-    srand((unsigned int)time(NULL));
+    // --record FILE writes the input of the session, --replay FILE plays a recorded session back
+    std::string recordPath, replayPath;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], "--record") == 0)
+            recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0)
+            replayPath = argv[++i];
+    }
 
     // Create a window property structure
     WindowProperties wp;
@@ -29,10 +39,26 @@ int main(int argc, char **argv)
     wp.vSync = true;
     wp.selfDir = GetParentDir(std::string(argv[0]));
 
+    // A replay recreates the recorded game and runs it without waiting for the display
+    unsigned int seed = (unsigned int)time(NULL);
+    if (!replayPath.empty())
+    {
+        if (!InputRecorder::StartReplay(replayPath))
+            return 1;
+        seed = InputRecorder::GetSeed();
+        wp.resolution = InputRecorder::GetResolution();
+        wp.vSync = false;
+    }
+
     // Init the Engine and create a new window with the defined properties
     (void)Engine::Init(wp);
 
-	World* world = new Plants_VS_Zombies();
+    if (!recordPath.empty() && replayPath.empty())
+    {
+        InputRecorder::StartRecording(recordPath, seed, wp.resolution);
+    }
+
+	World* world = new Plants_VS_Zombies(seed);
 
     world->Init();
     world->Run();
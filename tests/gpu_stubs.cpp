@@ -0,0 +1,144 @@
+// OpenGL driver without a context for the tests: the GL entry points of GLEW that the
+// engine sources under test link. Names are handed out and every other call does nothing,
+// so GPUBuffers counts its objects like in the game. The tests compile with GLEW_STATIC
+// and do not link GLEW, these definitions replace its function pointers.
+//
+// Mesh is the only engine class replaced here: its own source links Assimp for the
+// model files. The members the game uses for its 2D meshes are the same as mesh.cpp.
+
+#include "core/gpu/gpu_buffers.h"
+#include "core/gpu/mesh.h"
+#include "utils/gl_utils.h"
+
+#include <utility>
+
+
+namespace
+{
+    GLuint nextName = 1;
+
+    void GLAPIENTRY GenNames(GLsizei n, GLuint *names)
+    {
+        for (GLsizei i = 0; i < n; ++i)
+            names[i] = nextName++;
+    }
+
+    void GLAPIENTRY DeleteNames(GLsizei, const GLuint *) {}
+    void GLAPIENTRY BindName(GLenum, GLuint) {}
+    void GLAPIENTRY BindVertexArray(GLuint) {}
+    void GLAPIENTRY DeleteProgram(GLuint) {}
+    void GLAPIENTRY BufferData(GLenum, GLsizeiptr, const void *, GLenum) {}
+    void GLAPIENTRY EnableVertexAttribArray(GLuint) {}
+    void GLAPIENTRY VertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) {}
+}
+
+
+// Called while the meshes are created, and by the destructors
+PFNGLGENVERTEXARRAYSPROC __glewGenVertexArrays = GenNames;
+PFNGLGENBUFFERSPROC __glewGenBuffers = GenNames;
+PFNGLDELETEVERTEXARRAYSPROC __glewDeleteVertexArrays = DeleteNames;
+PFNGLDELETEBUFFERSPROC __glewDeleteBuffers = DeleteNames;
+PFNGLBINDVERTEXARRAYPROC __glewBindVertexArray = BindVertexArray;
+PFNGLBINDBUFFERPROC __glewBindBuffer = BindName;
+PFNGLBUFFERDATAPROC __glewBufferData = BufferData;
+PFNGLENABLEVERTEXATTRIBARRAYPROC __glewEnableVertexAttribArray = EnableVertexAttribArray;
+PFNGLVERTEXATTRIBPOINTERPROC __glewVertexAttribPointer = VertexAttribPointer;
+PFNGLDELETEPROGRAMPROC __glewDeleteProgram = DeleteProgram;
+
+// Only called to compile the shaders or to draw, which the tests never do
+PFNGLACTIVETEXTUREPROC __glewActiveTexture = nullptr;
+PFNGLATTACHSHADERPROC __glewAttachShader = nullptr;
+PFNGLBINDBUFFERBASEPROC __glewBindBufferBase = nullptr;
+PFNGLBUFFERSUBDATAPROC __glewBufferSubData = nullptr;
+PFNGLCOMPILESHADERPROC __glewCompileShader = nullptr;
+PFNGLCREATEPROGRAMPROC __glewCreateProgram = nullptr;
+PFNGLCREATESHADERPROC __glewCreateShader = nullptr;
+PFNGLDELETESHADERPROC __glewDeleteShader = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC __glewDrawElementsInstancedBaseVertex = nullptr;
+PFNGLGETPROGRAMBINARYPROC __glewGetProgramBinary = nullptr;
+PFNGLGETPROGRAMINFOLOGPROC __glewGetProgramInfoLog = nullptr;
+PFNGLGETPROGRAMIVPROC __glewGetProgramiv = nullptr;
+PFNGLGETSHADERINFOLOGPROC __glewGetShaderInfoLog = nullptr;
+PFNGLGETSHADERIVPROC __glewGetShaderiv = nullptr;
+PFNGLGETUNIFORMBLOCKINDEXPROC __glewGetUniformBlockIndex = nullptr;
+PFNGLGETUNIFORMLOCATIONPROC __glewGetUniformLocation = nullptr;
+PFNGLLINKPROGRAMPROC __glewLinkProgram = nullptr;
+PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC __glewMultiDrawElementsBaseVertex = nullptr;
+PFNGLPROGRAMBINARYPROC __glewProgramBinary = nullptr;
+PFNGLPROGRAMPARAMETERIPROC __glewProgramParameteri = nullptr;
+PFNGLSHADERSOURCEPROC __glewShaderSource = nullptr;
+PFNGLUNIFORM1IPROC __glewUniform1i = nullptr;
+PFNGLUNIFORMBLOCKBINDINGPROC __glewUniformBlockBinding = nullptr;
+PFNGLUSEPROGRAMPROC __glewUseProgram = nullptr;
+PFNGLVERTEXATTRIB3FPROC __glewVertexAttrib3f = nullptr;
+PFNGLVERTEXATTRIBDIVISORPROC __glewVertexAttribDivisor = nullptr;
+PFNGLVERTEXATTRIBIPOINTERPROC __glewVertexAttribIPointer = nullptr;
+
+// No program binaries without a context
+GLboolean __GLEW_VERSION_4_1 = GL_FALSE;
+GLboolean __GLEW_ARB_get_program_binary = GL_FALSE;
+
+
+Mesh::Mesh(std::string meshID)
+{
+    this->meshID = std::move(meshID);
+
+    useMaterial = true;
+    glDrawMode = GL_TRIANGLES;
+    buffers = new GPUBuffers();
+}
+
+
+Mesh::~Mesh()
+{
+    delete buffers;
+}
+
+
+const GPUBuffers * Mesh::GetBuffers() const
+{
+    return buffers;
+}
+
+
+const char * Mesh::GetMeshID() const
+{
+    return meshID.c_str();
+}
+
+
+void Mesh::InitFromData()
+{
+    meshEntries.clear();
+
+    MeshEntry M;
+
+    M.nrIndices = (unsigned int)indices.size();
+    meshEntries.push_back(M);
+
+    buffers->ReleaseMemory();
+}
+
+
+bool Mesh::InitFromData(const std::vector<VertexFormat> &vertices,
+                        const std::vector<unsigned int>& indices)
+{
+    this->vertices = vertices;
+    this->indices = indices;
+
+    InitFromData();
+    *buffers = gpu_utils::UploadData(vertices, indices);
+    return buffers->m_VAO != 0;
+}
+
+
+Mesh::GLenum Mesh::GetDrawMode() const
+{
+    return glDrawMode;
+}
+
+
+void Mesh::SetDrawMode(GLenum primitive)
+{
+    glDrawMode = primitive;
+}
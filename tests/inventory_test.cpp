@@ -0,0 +1,140 @@
+// Regression test of the inventory: the plants of the slots and their meshes are created
+// once at Init phase, every frame only submits them. The scene is initialized and rendered
+// with the calls of Plants_VS_Zombies::Init and Update, without a window (see gpu_stubs.cpp),
+// while plants are dragged from the inventory onto the lawn. Neither the inventory, nor the
+// meshes of the scene, nor the live GPU buffers may grow from one frame to the next.
+
+#include "Plants_VS_Zombies/GameConstants.h"
+#include "Plants_VS_Zombies/GameInit.h"
+#include "Plants_VS_Zombies/GameSimulation.h"
+#include "Plants_VS_Zombies/RenderScene.h"
+#include "core/gpu/gpu_buffers.h"
+#include "core/jobs/job_system.h"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace
+{
+    const int kFrames = 20000;
+    const int kDragPeriod = 60;         // Frames between two plants taken from the inventory
+    const int kDragFrames = 20;         // Frames a plant stays dragged before being dropped
+    const float kDeltaTime = 1.0f / 60.0f;
+    const unsigned int kSeed = 42;
+
+    int failures = 0;
+
+    void Check(bool condition, const char* what, int frame)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "FAILED at frame %d: %s\n", frame, what);
+            failures++;
+        }
+    }
+}
+
+
+int main()
+{
+    JobSystem::Init(1);
+
+    // The game reports the lives lost and the games over on the standard output
+    std::streambuf* gameOutput = std::cout.rdbuf(nullptr);
+
+    SimulationConfig config = { glm::ivec2(1280, 720), kSeed, 0, 0, 0, 0, 0 };
+    GameSimulation simulation(config);
+
+    // Scene state of Plants_VS_Zombies, AddMeshToList is the one of SimpleScene
+    std::unordered_map<std::string, Mesh*> meshes;
+    std::unordered_map<std::string, Shader*> shaders;
+    std::vector<Plant> inventoryPlants;
+    PrototypeMeshes prototypes;
+    RenderQueue renderQueue;
+    StaticBatch2D staticBatch;
+    DragState dragState;
+    dragState.Reset();
+
+    int addedMeshes = 0;
+    auto addMeshToList = [&meshes, &addedMeshes](Mesh* mesh)
+    {
+        meshes[mesh->GetMeshID()] = mesh;
+        addedMeshes++;
+    };
+    RenderScene renderScene(
+        [](Mesh*, Shader*, const glm::mat3&) {},
+        addMeshToList,
+        meshes, shaders, prototypes, renderQueue, staticBatch
+    );
+    Shader spriteShader("Instanced2D");
+    renderScene.SetSpriteShader(&spriteShader);
+
+    // Init phase
+    GameInit gameInit(addMeshToList);
+    gameInit.InitializePlantsForInventory(inventoryPlants, prototypes, simulation.GetNames());
+    gameInit.InitializePrototypeMeshes(prototypes);
+    simulation.PlantRandomGrid();
+
+    const size_t inventorySize = inventoryPlants.size();
+    const size_t meshCount = meshes.size();
+    const int addedAtInit = addedMeshes;
+    const unsigned int liveObjects = GPUBuffers::GetLiveObjectCount();
+    Check(inventorySize == static_cast<size_t>(GslotsINV - 1), "one plant per inventory slot", 0);
+    Check(liveObjects > 0, "the meshes of the inventory own GPU buffers", 0);
+
+    for (int frame = 0; frame < kFrames && failures == 0; ++frame)
+    {
+        if (!simulation.IsRunning())
+        {
+            simulation.Reset();
+            simulation.PlantRandomGrid();
+        }
+
+        // Pick a plant of the inventory, then drop it on a square, like the mouse handlers
+        if (frame % kDragPeriod == 0)
+        {
+            const Plant& plant = inventoryPlants[frame / kDragPeriod % inventorySize];
+            dragState.isDragging = true;
+            dragState.selectedPlant = new Plant(plant);
+            dragState.originalPosition = plant.GetPosition();
+        }
+        else if (frame % kDragPeriod == kDragFrames && dragState.isDragging)
+        {
+            const std::vector<GreenSquare>& squares = simulation.GetSquares();
+            simulation.PlacePlant(*dragState.selectedPlant,
+                squares[frame / kDragPeriod % squares.size()].GetCenterPosition());
+            delete dragState.selectedPlant;
+            dragState.Reset();
+        }
+
+        // FixedUpdate
+        simulation.Step(kDeltaTime);
+
+        // Update, the commands of the plants
+        renderQueue.Begin();
+        renderScene.RenderPlantsForInventory(shaders, inventoryPlants);
+        Check(renderQueue.GetStats().commands == inventorySize, "one command per inventory plant", frame);
+        renderScene.RenderPlants(meshes, shaders, simulation.GetPlants());
+        renderScene.RenderDraggedPlant(shaders, dragState);
+
+        Check(inventoryPlants.size() == inventorySize, "inventory size is constant", frame);
+        Check(meshes.size() == meshCount && addedMeshes == addedAtInit, "no mesh is created after Init", frame);
+        Check(GPUBuffers::GetLiveObjectCount() == liveObjects, "live GPU buffers are constant", frame);
+    }
+
+    delete dragState.selectedPlant;
+    std::cout.rdbuf(gameOutput);
+    JobSystem::Shutdown();
+
+    if (failures > 0)
+    {
+        return 1;
+    }
+    std::printf("InventoryTest: %d frames, %zu inventory plants, %zu meshes, %u live GPU buffers\n",
+        kFrames, inventorySize, meshCount, liveObjects);
+    return 0;
+}